@@ -0,0 +1,228 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "BatchRunner.h"
+#include "Controller.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+constexpr const char* kBatchUsage = "Usage: ./VRP [-v] --batch [--cores N] path...";
+constexpr const char* kSummaryFile = "vrp-init/batch-summary.md";
+
+/** @brief Expand directories into their JSON instance files, sorted by name. */
+std::vector<std::string> CollectInstanceFiles(const std::vector<std::string>& paths) {
+    std::vector<std::string> files;
+    for (const std::string& path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            files.push_back(path);
+            continue;
+        }
+        std::vector<std::string> found;
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                found.push_back(entry.path().string());
+            }
+        }
+        std::ranges::sort(found);
+        files.insert(files.end(), found.cbegin(), found.cend());
+    }
+    return files;
+}
+
+/** @brief Read the known optimum from the "cost N" line of the .opt file next to an instance. */
+std::optional<int> ReadTargetCost(const std::filesystem::path& instance) {
+    std::filesystem::path optPath = instance;
+    optPath.replace_extension(".opt");
+    std::ifstream input(optPath);
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        int cost = 0;
+        if (fields >> key >> cost && key == "cost") {
+            return cost;
+        }
+    }
+    return std::nullopt;
+}
+} // namespace
+
+/** @brief Create a runner over instance files and directories.
+ *
+ * @param[in] paths Instance files, or directories whose .json files are solved in name order
+ * @param[in] cores Thread budget of each instance; zero spreads the machine over all instances
+ * @param[in] costTravel Cost parameter for each travel.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @param[in] maxTime Maximum execution time of each instance in minutes.
+ */
+BatchRunner::BatchRunner(const std::vector<std::string>& paths, unsigned cores, float costTravel, float alphaParam,
+                         int maxTime)
+    : files(CollectInstanceFiles(paths)), costTravel(costTravel), alphaParam(alphaParam), maxTimeMin(maxTime) {
+    if (this->files.empty()) {
+        throw std::runtime_error("No instance to solve.");
+    }
+    const unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+    const unsigned instances = static_cast<unsigned>(std::min<std::size_t>(hardware, this->files.size()));
+    this->coresPerInstance = cores > 0 ? cores : std::max(1U, hardware / instances);
+}
+
+/** @brief Parse batch-mode arguments.
+ *
+ * @param[in] argc The number of arguments passed through command line.
+ * @param[in] argv The arguments passed through command line.
+ * @param[in] costTravel Cost parameter for each travel.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @param[in] maxTime Maximum execution time of each instance in minutes.
+ * @return The runner, or nothing when the arguments do not ask for batch mode
+ */
+std::optional<BatchRunner> BatchRunner::FromArguments(int argc, char** argv, float costTravel, float alphaParam,
+                                                      int maxTime) {
+    int index = 1;
+    bool verbose = false;
+    if (index < argc && strcmp(argv[index], "-v") == 0) {
+        verbose = true;
+        ++index;
+    }
+    if (index >= argc || strcmp(argv[index], "--batch") != 0) {
+        return std::nullopt;
+    }
+    ++index;
+    unsigned cores = 0;
+    if (index < argc && strcmp(argv[index], "--cores") == 0) {
+        if (index + 1 >= argc) {
+            throw std::runtime_error(kBatchUsage);
+        }
+        try {
+            cores = static_cast<unsigned>(std::stoul(argv[index + 1]));
+        } catch (const std::logic_error&) {
+            throw std::runtime_error(kBatchUsage);
+        }
+        index += 2;
+    }
+    if (index >= argc) {
+        throw std::runtime_error(kBatchUsage);
+    }
+    Utils::Instance().verbose = verbose;
+    return BatchRunner(std::vector<std::string>(argv + index, argv + argc), cores, costTravel, alphaParam, maxTime);
+}
+
+/** @brief Solve every instance.
+ *
+ * Instances are queued on one pool sized so that the thread budgets of the
+ * concurrent runs fill the machine. Results keep the input order.
+ */
+void BatchRunner::Run() {
+    const unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+    const unsigned concurrent = std::clamp(hardware / this->coresPerInstance, 1U, static_cast<unsigned>(files.size()));
+    Utils& u = Utils::Instance();
+    u.logger("Solving " + std::to_string(this->files.size()) + " instances, " + std::to_string(concurrent) +
+                 " at a time with " + std::to_string(this->coresPerInstance) + " threads each",
+             u.INFO);
+    this->results.assign(this->files.size(), Result{});
+    ThreadPool pool(concurrent);
+    for (std::size_t index = 0; index < this->files.size(); ++index) {
+        pool.AddTask([this, index]() { this->results[index] = this->Solve(this->files[index]); });
+    }
+    pool.JoinAll();
+    const std::string table = this->SummaryTable();
+    std::ofstream summary(kSummaryFile);
+    summary << table;
+    if (!summary) {
+        throw std::runtime_error("Error writing file! (Bad permissions)");
+    }
+    u.logger(table);
+}
+
+/** @brief Solve one instance with its own controller and log file.
+ *
+ * @param[in] file Instance file
+ * @return The row of the instance; failures are recorded, not thrown
+ */
+BatchRunner::Result BatchRunner::Solve(const std::string& file) const {
+    const std::filesystem::path path(file);
+    Result result{
+        .instance = path.stem().string(),
+        .target = ReadTargetCost(path),
+        .best = 0,
+        .routes = 0,
+        .milliseconds = 0,
+        .error = {},
+    };
+    Utils& u = Utils::Instance();
+    const auto start = std::chrono::steady_clock::now();
+    const auto elapsed = [&start]() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+    Controller controller;
+    try {
+        controller.GetUtils().verbose = u.verbose;
+        controller.GetUtils().LogToFile("vrp-init/" + result.instance + ".log");
+        controller.SetWorkerBudget(this->coresPerInstance);
+        controller.Init(file, this->costTravel, this->alphaParam, this->maxTimeMin);
+        controller.SaveResult();
+        controller.RunVRP();
+        controller.PrintBestRoutes();
+        result.best = controller.GetBestCost();
+        result.routes = controller.GetBestRouteCount();
+        result.milliseconds = elapsed();
+        u.logger(result.instance + ": " + std::to_string(result.best) + " in " +
+                     std::to_string(result.milliseconds) + " milliseconds",
+                 u.SUCCESS);
+    } catch (const std::exception& e) {
+        result.error = e.what();
+        result.milliseconds = elapsed();
+        u.logger(result.instance + ": " + result.error, u.ERROR);
+    }
+    return result;
+}
+
+/** @brief Format the results like the benchmark summary.
+ *
+ * Gaps are relative to the .opt target; failed runs show their error in
+ * place of the cost columns.
+ */
+std::string BatchRunner::SummaryTable() const {
+    std::ostringstream table;
+    table << "| Instance | Target | Best | Gap | Routes | Solver ms |\n";
+    table << "| --- | ---: | ---: | ---: | ---: | ---: |\n";
+    long long totalMilliseconds = 0;
+    for (const Result& result : this->results) {
+        const std::string target = result.target.has_value() ? std::to_string(*result.target) : "-";
+        table << "| `" << result.instance << "` | " << target << " | ";
+        if (!result.error.empty()) {
+            table << "error: " << result.error << " | - | - | " << result.milliseconds << " |\n";
+        } else {
+            std::string gap = "-";
+            if (result.target.has_value()) {
+                const int difference = result.best - *result.target;
+                gap = difference > 0 ? "+" + std::to_string(difference) : std::to_string(difference);
+            }
+            table << result.best << " | " << gap << " | " << result.routes << " | " << result.milliseconds << " |\n";
+        }
+        totalMilliseconds += result.milliseconds;
+    }
+    table << "\nTotal solver time: " << totalMilliseconds << " ms.\n";
+    return table.str();
+}
@@ -0,0 +1,53 @@
+#ifndef BatchRunner_H
+#define BatchRunner_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+/** @brief Solve a set of instances in one process, several at a time.
+ *
+ * Every instance gets its own Controller and a fixed thread budget; as many
+ * instances run at once as the budget leaves room for on this machine, so
+ * parsing one instance overlaps the search of the others. Each run logs to
+ * vrp-init/<instance>.log and saves its result as in single-instance mode.
+ * The outcome is a Markdown table in the layout of doc/benchmark-summary.md.
+ */
+class BatchRunner {
+  public:
+    /** @brief Outcome of one instance, one row of the results table. */
+    struct Result {
+        std::string instance;       /**< Instance file name without extension */
+        std::optional<int> target;  /**< Known optimum from the .opt file next to the instance */
+        int best = 0;               /**< Cost of the best solution found */
+        std::size_t routes = 0;     /**< Routes of the best solution found */
+        long long milliseconds = 0; /**< Wall time of the run */
+        std::string error;          /**< Failure message, empty on success */
+    };
+
+    /** @brief Create a runner over instance files and directories of instance files. */
+    BatchRunner(const std::vector<std::string>&, unsigned, float, float, int);
+
+    /** @brief Build a runner from "[-v] --batch [--cores N] path..." arguments, if batch mode was requested. */
+    static std::optional<BatchRunner> FromArguments(int, char**, float, float, int);
+
+    /** @brief Solve every instance and collect the results in input order. */
+    void Run();
+
+    /** @brief Return the results table in Markdown. */
+    [[nodiscard]] std::string SummaryTable() const;
+
+  private:
+    /** @brief Solve one instance with its own controller. */
+    Result Solve(const std::string&) const;
+
+    std::vector<std::string> files; /**< Instance files in solving order */
+    std::vector<Result> results;    /**< Results in the order of files */
+    unsigned coresPerInstance = 1;  /**< Thread budget of every run */
+    float costTravel = 0.0F;        /**< Cost parameter for each travel */
+    float alphaParam = 0.0F;        /**< Alpha parameter for route evaluation */
+    int maxTimeMin = 0;             /**< Time budget of every run in minutes */
+};
+
+#endif /* BatchRunner_H */
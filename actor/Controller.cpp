@@ -16,11 +16,27 @@
  ****************************************************************************/
 
 #include "Controller.h"
+#include "Checkpoint.h"
+#include "PerfCounters.h"
+#include <atomic>
 #include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
 
 namespace {
 constexpr int kMaxStagnantIterations = 5;
 constexpr int kDenseRouteSearchSlack = 2;
+constexpr std::chrono::seconds kCheckpointInterval{60};
+constexpr const char* kCheckpointMagic = "VRP-checkpoint";
+constexpr std::uint32_t kCheckpointVersion = 2;
+
+// Raised by SIGTERM; a lock-free atomic store is safe inside a signal handler.
+std::atomic<bool> stopRequested{false};
+
+/** @brief Ask the checkpointing run to stop once its current search iteration completes. */
+void RequestStop(int /*signal*/) { stopRequested.store(true); }
 } // namespace
 
 /** @brief Configure solver variables and load routes.
@@ -35,11 +51,90 @@ constexpr int kDenseRouteSearchSlack = 2;
  */
 void Controller::Init(int argc, char** argv, float costTravel, float alphaParam, int max_time) {
     this->startTime = std::chrono::high_resolution_clock::now();
-    this->MAX_TIME_MIN = max_time;
     Utils& u = this->GetUtils();
     u.logger("Initializing...", u.INFO);
-    this->vrp = Utils::Instance().InitParameters(argc, argv, costTravel, alphaParam);
-    int res = this->vrp->InitSolutionsSavings();
+    this->vrp = u.InitParameters(argc, argv, costTravel, alphaParam);
+    if (!u.warmStartFile.empty()) {
+        this->initialRoutes = Utils::LoadRoutes(u.warmStartFile);
+    }
+    if (!u.checkpointFile.empty() || !u.resumeFile.empty()) {
+        // a resumed run keeps checkpointing to the file it came from
+        this->SetCheckpoint(u.checkpointFile.empty() ? u.resumeFile : u.checkpointFile, kCheckpointInterval);
+    }
+    if (!u.resumeFile.empty()) {
+        this->SetResumeFile(u.resumeFile);
+    }
+    if (u.workBudget > 0) {
+        this->SetWorkBudget(u.workBudget);
+    }
+    this->InitSolution(max_time);
+}
+
+/** @brief Load one instance file and build its initial solution.
+ *
+ * @param[in] file Path of the JSON instance.
+ * @param[in] costTravel The cost of travelling.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @param[in] max_time Maximum execution time in minutes.
+ */
+void Controller::Init(const std::string& file, float costTravel, float alphaParam, int max_time) {
+    this->startTime = std::chrono::high_resolution_clock::now();
+    Utils& u = this->GetUtils();
+    u.logger("Initializing...", u.INFO);
+    this->vrp = u.LoadInstance(file, costTravel, alphaParam);
+    this->InitSolution(max_time);
+}
+
+/** @brief Load one instance file and repair a previous solution into its initial solution.
+ *
+ * Re-solving an instance that changed a little since the last run starts
+ * from the old routes instead of constructing from scratch: customers that
+ * vanished are dropped and new ones are inserted by regret.
+ * @param[in] file Path of the JSON instance.
+ * @param[in] routes Customer names of each route, e.g. the "routes" of a saved result
+ * @param[in] costTravel The cost of travelling.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @param[in] max_time Maximum execution time in minutes.
+ */
+void Controller::Init(const std::string& file, std::vector<std::vector<std::string>> routes, float costTravel,
+                      float alphaParam, int max_time) {
+    this->SetInitialRoutes(std::move(routes));
+    this->Init(file, costTravel, alphaParam, max_time);
+}
+
+/** @brief Build the initial solution of a model created by the caller.
+ *
+ * Used when the instance was parsed once and is solved many times, so no
+ * input file is read.
+ * @param[in] model The VRP model to solve
+ * @param[in] max_time Maximum execution time in minutes.
+ */
+void Controller::Init(std::unique_ptr<VRP> model, int max_time) {
+    this->startTime = std::chrono::high_resolution_clock::now();
+    this->vrp = std::move(model);
+    this->InitSolution(max_time);
+}
+
+/** @brief Build the initial solution of the loaded model under the worker budget. */
+void Controller::InitSolution(int max_time) {
+    Utils& u = this->GetUtils();
+    this->MAX_TIME_MIN = max_time;
+    this->vrp->SetLogger(u);
+    if (this->workers > 0) {
+        this->vrp->SetWorkerBudget(this->workers);
+    }
+    if (this->deadline.has_value()) {
+        this->vrp->SetDeadline(*this->deadline);
+    }
+    if (this->workBudget.has_value()) {
+        this->vrp->SetWorkBudget(*this->workBudget);
+    }
+    if (!this->resumeFile.empty()) {
+        this->LoadCheckpoint();
+        return;
+    }
+    int res = this->initialRoutes.empty() ? this->vrp->InitSolutionsSavings()
+                                          : this->vrp->InitSolutionsFromRoutes(this->initialRoutes);
     switch (res) {
     case -1:
         u.logger("You need less vehicles.", u.WARNING);
@@ -56,12 +151,150 @@ void Controller::Init(int argc, char** argv, float costTravel, float alphaParam,
     this->initCost = this->vrp->GetTotalCost();
 }
 
+/** @brief Limit the threads of the run.
+ *
+ * Must be called before Init, which builds the initial solution.
+ * @param[in] budget Maximum number of threads; zero keeps the hardware concurrency
+ */
+void Controller::SetWorkerBudget(unsigned budget) { this->workers = budget; }
+
+/** @brief Bound the run by a wall-clock instant.
+ *
+ * Must be called before Init. Tabu calls end at the deadline and VND stops
+ * between neighborhoods and between the route pairs of exchange moves, so a run
+ * overshoots it by at most one neighborhood evaluation.
+ * @param[in] end The instant after which no new search step starts
+ */
+void Controller::SetDeadline(std::chrono::steady_clock::time_point end) { this->deadline = end; }
+
+/** @brief Add a customer to the running instance.
+ *
+ * Safe to call from another thread while RunVRP runs; the customer joins the
+ * solution at the start of the next search iteration.
+ * @param[in] customer The new customer
+ * @param[in] arcs Travel costs to and from every current vertex, by vertex name
+ */
+void Controller::AddCustomer(Customer customer, std::map<std::string, VertexArcs> arcs) {
+    if (!this->vrp) {
+        throw std::runtime_error("No instance loaded");
+    }
+    this->vrp->AddCustomer(std::move(customer), std::move(arcs));
+}
+
+/** @brief Remove a customer from the running instance.
+ *
+ * Safe to call from another thread while RunVRP runs; the customer leaves the
+ * solution at the start of the next search iteration.
+ * @param[in] name Name of the customer
+ */
+void Controller::RemoveCustomer(const std::string& name) {
+    if (!this->vrp) {
+        throw std::runtime_error("No instance loaded");
+    }
+    this->vrp->RemoveCustomer(name);
+}
+
+/** @brief Make the run reproducible under a budget of evaluated tabu moves.
+ *
+ * Must be called before Init. Wall-clock limits, the minute budget and any
+ * deadline included, are then ignored; see VRP::SetWorkBudget.
+ * @param[in] budget Evaluated tabu moves after which the run stops
+ */
+void Controller::SetWorkBudget(long long budget) { this->workBudget = budget; }
+
+/** @brief Save the run periodically to a checkpoint file.
+ *
+ * Must be called before RunVRP. A checkpoint is written after the first
+ * search iteration ending at least one interval after the previous one. On
+ * SIGTERM the run stops after its current iteration and writes a last checkpoint.
+ * @param[in] path Checkpoint file, replaced atomically at each write
+ * @param[in] interval Minimum time between two periodic checkpoints
+ */
+void Controller::SetCheckpoint(std::string path, std::chrono::seconds interval) {
+    this->checkpointFile = std::move(path);
+    this->checkpointInterval = interval;
+}
+
+/** @brief Continue a run from its checkpoint.
+ *
+ * Must be called before Init, which then restores the checkpoint instead of
+ * building an initial solution; RunVRP continues at the stored iteration.
+ * @param[in] path Checkpoint file written by a run on the same instance
+ */
+void Controller::SetResumeFile(std::string path) { this->resumeFile = std::move(path); }
+
+/** @brief Write the checkpoint file.
+ *
+ * Layout: magic, format version, loop position, initial cost, then the
+ * search state of VRP::SaveState.
+ * @param[in] progress Loop position to continue from
+ */
+void Controller::WriteCheckpoint(const SearchProgress& progress) {
+    CheckpointWriter out;
+    out.String(kCheckpointMagic);
+    out.U32(kCheckpointVersion);
+    out.I32(progress.iteration);
+    out.I32(progress.stopCondition);
+    out.I32(progress.last);
+    out.I32(progress.prelast);
+    out.I64(progress.elapsedMilliseconds);
+    out.I32(this->initCost);
+    this->vrp->SaveState(out);
+    out.WriteFile(this->checkpointFile);
+    this->GetUtils().logger("Checkpoint saved to " + this->checkpointFile, Utils::VERBOSE);
+}
+
+/** @brief Restore the search state and loop position written by WriteCheckpoint.
+ *
+ * @throws std::runtime_error when the file is not a checkpoint of this instance
+ */
+void Controller::LoadCheckpoint() {
+    CheckpointReader in(this->resumeFile, this->vrp->GetGraph());
+    if (in.String() != kCheckpointMagic || in.U32() != kCheckpointVersion) {
+        throw std::runtime_error(this->resumeFile + " is not a checkpoint of this version");
+    }
+    SearchProgress progress;
+    progress.iteration = in.I32();
+    progress.stopCondition = in.I32();
+    progress.last = in.I32();
+    progress.prelast = in.I32();
+    progress.elapsedMilliseconds = in.I64();
+    this->initCost = in.I32();
+    this->vrp->LoadState(in);
+    if (!in.AtEnd()) {
+        throw std::runtime_error(this->resumeFile + " has trailing data");
+    }
+    this->resumeProgress = progress;
+    this->GetUtils().logger("Resumed from " + this->resumeFile + " at iteration " +
+                                 std::to_string(progress.iteration) + " with best cost " +
+                                 std::to_string(this->GetBestCost()),
+                             Utils::INFO);
+}
+
+/** @brief Warm-start the run from a previous solution.
+ *
+ * Must be called before Init. See VRP::InitSolutionsFromRoutes for the repair.
+ * @param[in] routes Customer names of each route
+ */
+void Controller::SetInitialRoutes(std::vector<std::vector<std::string>> routes) {
+    this->initialRoutes = std::move(routes);
+}
+
+/** @brief Stream incumbents to the caller.
+ *
+ * @param[in] callback Called with the best route set each time it improves
+ */
+void Controller::SetIncumbentCallback(std::function<void(const Routes&)> callback) {
+    this->onIncumbent = std::move(callback);
+}
+
 /** @brief Run the full VRP solution flow.
  *
  * This function sets and call the tabu search and optimal functions.
  * If the routines do not improves the solutions set stop.
  */
 void Controller::RunVRP() {
+    PerfCounters::Sink perfCounters;
     int customers = this->vrp->GetNumberOfCustomers();
     int timeOpts = customers, iteration = customers;
     // number of opt functions executions
@@ -70,13 +303,29 @@ void Controller::RunVRP() {
     } else {
         timeOpts /= 2;
     }
+    const SearchProgress resumed = this->resumeProgress.value_or(SearchProgress{});
+    // start time, moved back by the search time of a resumed run
+    std::chrono::high_resolution_clock::time_point t1 =
+        std::chrono::high_resolution_clock::now() - std::chrono::milliseconds(resumed.elapsedMilliseconds);
     std::chrono::minutes::rep duration = 0;
-    // start time
-    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
-    auto runSearchPass = [this, customers, timeOpts, iteration, t1, &duration]() {
-        int stopCondition = 0, last = 0, prelast = 0;
-        for (int i = 0; i < iteration && stopCondition < kMaxStagnantIterations && duration <= this->MAX_TIME_MIN;
+    if (!this->checkpointFile.empty()) {
+        std::signal(SIGTERM, RequestStop);
+    }
+    auto lastCheckpoint = std::chrono::steady_clock::now();
+    SearchProgress latest = resumed;
+    auto runSearchPass = [this, customers, timeOpts, iteration, t1, &duration, &lastCheckpoint,
+                          &latest](SearchProgress start) {
+        int stopCondition = start.stopCondition, last = start.last, prelast = start.prelast;
+        // a stop request is honoured between iterations only, so the last checkpoint holds a whole
+        // iteration and a resumed run continues exactly where this one left off
+        for (int i = start.iteration; i < iteration && stopCondition < kMaxStagnantIterations &&
+                                      duration <= this->MAX_TIME_MIN && !this->vrp->DeadlinePassed() &&
+                                      !stopRequested.load();
              i++) {
+            if (this->vrp->ApplyCustomerChanges()) {
+                this->ReportIncumbent();
+                stopCondition = 0;
+            }
             bool optflag = false;
             const int activeRoutes = static_cast<int>(this->vrp->GetRoutes()->size());
             const int denseRouteThreshold =
@@ -92,33 +341,76 @@ void Controller::RunVRP() {
                 prelast = last;
                 last = ts;
             }
-            Utils::Instance().logger("Starting opt", Utils::VERBOSE);
+            this->GetUtils().logger("Starting opt", Utils::VERBOSE);
             this->vrp->RunOpts(timeOpts, optflag, stopCondition);
-            // partial time
+            // partial time; a deterministic run is bounded by its work budget alone
             std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::minutes>(t2 - t1).count();
-            Utils::Instance().logger("[!]\tPARTIAL: " + std::to_string(this->vrp->GetTotalCost()) + " " +
+            if (!this->vrp->Deterministic()) {
+                duration = std::chrono::duration_cast<std::chrono::minutes>(t2 - t1).count();
+            }
+            this->GetUtils().logger("[!]\tPARTIAL: " + std::to_string(this->vrp->GetTotalCost()) + " " +
                                          std::to_string(i + 1) + "/" + std::to_string(iteration),
                                      Utils::INFO);
             if (this->vrp->UpdateBest()) {
-                this->SaveResult();
+                this->ReportIncumbent();
                 stopCondition = 0;
             } else {
                 this->vrp->RestoreBest();
                 stopCondition++;
             }
+            latest = SearchProgress{.iteration = i + 1,
+                                    .stopCondition = stopCondition,
+                                    .last = last,
+                                    .prelast = prelast,
+                                    .elapsedMilliseconds =
+                                        std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count()};
+            if (!this->checkpointFile.empty() &&
+                std::chrono::steady_clock::now() - lastCheckpoint >= this->checkpointInterval) {
+                this->WriteCheckpoint(latest);
+                lastCheckpoint = std::chrono::steady_clock::now();
+            }
         }
     };
-    runSearchPass();
-    while (duration <= this->MAX_TIME_MIN && this->vrp->RestartFromBestWithFreshTabu()) {
-        runSearchPass();
+    runSearchPass(resumed);
+    while (duration <= this->MAX_TIME_MIN && !this->vrp->DeadlinePassed() && !stopRequested.load() &&
+           this->vrp->RestartFromBestWithFreshTabu()) {
+        // the restart already changed the state, so a checkpoint from now on starts the new pass
+        latest = SearchProgress{.iteration = 0,
+                                .stopCondition = 0,
+                                .last = 0,
+                                .prelast = 0,
+                                .elapsedMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                           std::chrono::high_resolution_clock::now() - t1)
+                                                           .count()};
+        runSearchPass(latest);
+    }
+    if (!this->checkpointFile.empty() && stopRequested.load()) {
+        this->WriteCheckpoint(latest);
+        this->GetUtils().logger("Stopped by SIGTERM; resume with --resume " + this->checkpointFile, Utils::INFO);
     }
     this->finalCost = this->vrp->GetTotalCost();
     const int percCost = this->initCost == 0 ? 0 : ((this->finalCost - this->initCost) * 100) / this->initCost;
-    Utils::Instance().logger("Total improvement: " + std::to_string(this->initCost - this->finalCost) + " " +
+    if (this->vrp->Deterministic()) {
+        this->GetUtils().logger("Work done: " + std::to_string(this->vrp->GetWorkDone()) + " evaluated moves",
+                                 Utils::INFO);
+    }
+    this->GetUtils().logger("Total improvement: " + std::to_string(this->initCost - this->finalCost) + " " +
                                  std::to_string(percCost) + "%",
                              Utils::INFO);
+    const PerfCounters::Report perf = perfCounters.Collect();
+    this->GetUtils().logger(PerfCounters::Table(perf), Utils::INFO);
+    this->GetUtils().SavePerfReport(PerfCounters::Json(perf));
+}
+
+/** @brief Hand the best route set to the incumbent callback, or save it when none is set. */
+void Controller::ReportIncumbent() {
+    if (this->onIncumbent) {
+        this->onIncumbent(*this->vrp->GetBestRoutes());
+    } else {
+        this->SaveResult();
+    }
 }
+
 /** @brief Run tabu search until the time budget expires.
  *
  * @param[in] times Number of iteration.
@@ -126,19 +418,35 @@ void Controller::RunVRP() {
  */
 int Controller::RunTabuSearch(int times) {
     int initCost = this->vrp->GetTotalCost();
-    Utils::Instance().logger("Starting Tabu Search", Utils::VERBOSE);
+    this->GetUtils().logger("Starting Tabu Search", Utils::VERBOSE);
     this->vrp->RunTabuSearch(times);
     int diffCost = initCost - this->vrp->GetTotalCost();
     if (diffCost != 0) {
-        Utils::Instance().logger("Tabu Search improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->GetUtils().logger("Tabu Search improved: " + std::to_string(diffCost), Utils::VERBOSE);
         return diffCost;
     } else {
-        Utils::Instance().logger("Tabu Search no improvement", Utils::VERBOSE);
+        this->GetUtils().logger("Tabu Search no improvement", Utils::VERBOSE);
         return 0;
     }
 }
 
-Utils& Controller::GetUtils() const { return Utils::Instance(); }
+/** @brief Return the utilities owned by this run. */
+Utils& Controller::GetUtils() { return this->utils; }
+
+/** @brief Return the best route set found so far. */
+const Routes& Controller::GetBestRoutes() { return *this->vrp->GetBestRoutes(); }
+
+/** @brief Return the cost of the best route set found so far. */
+int Controller::GetBestCost() {
+    int cost = 0;
+    for (const Route& route : *this->vrp->GetBestRoutes()) {
+        cost += route.GetTotalCost();
+    }
+    return cost;
+}
+
+/** @brief Return the number of routes of the best route set found so far. */
+std::size_t Controller::GetBestRouteCount() { return this->vrp->GetBestRoutes()->size(); }
 
 /** @brief Print all current routes.
  *
@@ -147,7 +455,7 @@ Utils& Controller::GetUtils() const { return Utils::Instance(); }
 void Controller::PrintRoutes() {
     Utils& u = this->GetUtils();
     Routes* e = this->vrp->GetRoutes();
-    std::cout << '\n';
+    u.logger("");
     for (auto i = e->cbegin(); i != e->cend(); i++) {
         u.logger(*i);
         std::advance(i, 1);
@@ -157,7 +465,7 @@ void Controller::PrintRoutes() {
     }
     u.logger("Total cost: " + std::to_string(this->vrp->GetTotalCost()), u.INFO);
     u.logger("Total routes: " + std::to_string(e->size()), u.INFO);
-    std::cout << '\n';
+    u.logger("");
 }
 
 /** @brief Print the best solution.
@@ -168,7 +476,7 @@ void Controller::PrintBestRoutes() {
     Utils& u = this->GetUtils();
     Routes* e = this->vrp->GetBestRoutes();
     int totCost = 0;
-    std::cout << '\n';
+    u.logger("");
     for (auto i = e->cbegin(); i != e->cend(); i++) {
         u.logger(*i);
         totCost += i->GetTotalCost();
@@ -180,7 +488,7 @@ void Controller::PrintBestRoutes() {
     }
     u.logger("Total cost: " + std::to_string(totCost), u.INFO);
     u.logger("Total routes: " + std::to_string(e->size()), u.INFO);
-    std::cout << '\n';
+    u.logger("");
 }
 
 /** @brief Save results.
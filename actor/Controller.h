@@ -1,43 +1,110 @@
 #ifndef Controller_H
 #define Controller_H
 
+#include "Utils.h"
 #include "VRP.h"
 #include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 /** @brief Application-level coordinator for loading, solving, and reporting a VRP instance.
  *
- * Controller is a singleton wrapper around one VRP run. It owns timing,
- * initialization/final cost bookkeeping, and the final result persistence.
+ * Controller wraps one VRP run. It owns the model, its Utils for parsing,
+ * logging and result persistence, timing, and initialization/final cost
+ * bookkeeping, so several controllers can solve different instances at once.
  */
 class Controller {
   public:
+    Controller() = default;
     Controller(Controller const&) = delete;
     Controller& operator=(Controller const&) = delete;
 
   private:
-    VRP* vrp = nullptr;
+    /** @brief Position of the search loop, enough to continue it from a checkpoint. */
+    struct SearchProgress {
+        int iteration = 0;                 /**< Next iteration of the current search pass */
+        int stopCondition = 0;             /**< Iterations since the last improvement of the best */
+        int last = 0;                      /**< Gain of the last productive tabu search */
+        int prelast = 0;                   /**< Gain of the productive tabu search before it */
+        long long elapsedMilliseconds = 0; /**< Search time already spent */
+    };
 
-    /** @brief Hide construction behind the singleton accessor. */
-    Controller() = default;
+    std::unique_ptr<VRP> vrp;
+    Utils utils;
 
     /** @brief Run tabu search phases until the configured time budget expires. */
     int RunTabuSearch(int);
 
+    /** @brief Build the initial solution of the loaded model. */
+    void InitSolution(int);
+
+    /** @brief Publish a new best route set to the callback, or save it. */
+    void ReportIncumbent();
+
+    /** @brief Write the search state and loop position to the checkpoint file. */
+    void WriteCheckpoint(const SearchProgress&);
+
+    /** @brief Replace the initial solution with the state stored in the resume file. */
+    void LoadCheckpoint();
+
     int MAX_TIME_MIN = 0;
     int initCost = 0;
     int finalCost = 0;
+    unsigned workers = 0;
     std::chrono::high_resolution_clock::time_point startTime;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::vector<std::vector<std::string>> initialRoutes;
+    std::function<void(const Routes&)> onIncumbent;
+    std::string checkpointFile;
+    std::chrono::seconds checkpointInterval{0};
+    std::string resumeFile;
+    std::optional<SearchProgress> resumeProgress;
+    std::optional<long long> workBudget;
 
   public:
-    /** @brief Return the singleton controller instance. */
-    static Controller& Instance() {
-        static Controller instance;
-        return instance;
-    }
-
     /** @brief Parse command-line input and create the VRP model. */
     void Init(int, char** argv, float, float, int);
 
+    /** @brief Load one instance file and create the VRP model. */
+    void Init(const std::string&, float, float, int);
+
+    /** @brief Load one instance file and start from a previous route set. */
+    void Init(const std::string&, std::vector<std::vector<std::string>>, float, float, int);
+
+    /** @brief Take over a model built elsewhere and build its initial solution. */
+    void Init(std::unique_ptr<VRP>, int);
+
+    /** @brief Limit the threads of the run; zero keeps the hardware concurrency. */
+    void SetWorkerBudget(unsigned);
+
+    /** @brief Stop the run at a wall-clock instant, in addition to the minute budget. */
+    void SetDeadline(std::chrono::steady_clock::time_point);
+
+    /** @brief Start from routes of customer names instead of constructing from scratch. */
+    void SetInitialRoutes(std::vector<std::vector<std::string>>);
+
+    /** @brief Bound the run by evaluated moves instead of time, so it is reproducible. */
+    void SetWorkBudget(long long);
+
+    /** @brief Write a checkpoint at this interval, and when SIGTERM stops the run. */
+    void SetCheckpoint(std::string, std::chrono::seconds);
+
+    /** @brief Continue the run stored in a checkpoint instead of building an initial solution. */
+    void SetResumeFile(std::string);
+
+    /** @brief Receive every new best route set instead of saving it to vrp-init. */
+    void SetIncumbentCallback(std::function<void(const Routes&)>);
+
+    /** @brief Queue a new customer for the running search. */
+    void AddCustomer(Customer, std::map<std::string, VertexArcs>);
+
+    /** @brief Queue the removal of a customer from the running search. */
+    void RemoveCustomer(const std::string&);
+
     /** @brief Execute the full VRP workflow from initial solution to local search. */
     void RunVRP();
 
@@ -50,8 +117,17 @@ class Controller {
     /** @brief Print the best route set found so far. */
     void PrintBestRoutes();
 
-    /** @brief Return the shared utility singleton. */
-    [[nodiscard]] Utils& GetUtils() const;
+    /** @brief Return the best route set found so far. */
+    [[nodiscard]] const Routes& GetBestRoutes();
+
+    /** @brief Return the cost of the best route set found so far. */
+    [[nodiscard]] int GetBestCost();
+
+    /** @brief Return the number of routes of the best route set found so far. */
+    [[nodiscard]] std::size_t GetBestRouteCount();
+
+    /** @brief Return the utilities of this run. */
+    [[nodiscard]] Utils& GetUtils();
 };
 
 #endif /* Controller_H */
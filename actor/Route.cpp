@@ -16,12 +16,42 @@
  ****************************************************************************/
 
 #include "Route.h"
+#include "PerfCounters.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 
 namespace {
+// Epochs are handed out in per-thread blocks so parallel neighborhoods that
+// mutate route copies never contend on the shared counter.
+constexpr std::uint64_t kEpochBlock = std::uint64_t{1} << 16;
+std::atomic<std::uint64_t> nextEpochBlock{0};
+
+/** @brief Return a process-wide unique route modification epoch. */
+std::uint64_t NextRouteEpoch() {
+    thread_local std::uint64_t next = 0;
+    thread_local std::uint64_t limit = 0;
+    if (next == limit) {
+        next = nextEpochBlock.fetch_add(kEpochBlock, std::memory_order_relaxed);
+        limit = next + kEpochBlock;
+    }
+    return next++;
+}
+
 float TravelTime(int cost, float travelCost) { return static_cast<float>(cost) * travelCost; }
+
+/** @brief Return a pseudo-angle in [0, 4) with the same ordering as atan2. */
+float PseudoAngle(float dx, float dy) {
+    if (dx == 0.0F && dy == 0.0F) {
+        return 0.0F;
+    }
+    const float p = dx / (std::fabs(dx) + std::fabs(dy));
+    return dy < 0.0F ? 3.0F + p : 1.0F - p;
+}
+
+/** @brief Wrap a pseudo-angle difference into [-2, 2]. */
+float WrapPseudoAngle(float angle) { return std::remainder(angle, 4.0F); }
 } // namespace
 
 /** @brief Construct a route with vehicle constraints and scoring parameters.
@@ -43,8 +73,19 @@ Route::Route(int c, float wt, const Graph& g, const float costTravel, const floa
     else
         this->TRAVEL_COST = costTravel;
     this->ALPHA = alphaParam;
+    this->MarkModified();
 }
 
+/** @brief Give the route a fresh modification epoch.
+ *
+ * Called by every mutation of the steps. Copies keep the epoch because their
+ * content is identical until one of them is modified.
+ */
+void Route::MarkModified() { this->epoch = NextRouteEpoch(); }
+
+/** @brief Return the modification epoch of the current route content. */
+std::uint64_t Route::GetEpoch() const { return this->epoch; }
+
 /** @brief Close a route from a specific customer to the depot.
  *
  * When remaining only one customer to visit, visit it then return to depot.
@@ -69,6 +110,10 @@ bool Route::CloseTravel(const Customer& from, const Customer& depot) {
         this->workTime = workT;
         this->route.emplace_back(from, travelCost);
         this->route.emplace_back(depot, 0);
+        this->MarkModified();
+        if (from != depot) {
+            this->IncludeInSpatialSummary(from);
+        }
     }
     return ret;
 }
@@ -112,6 +157,10 @@ bool Route::Travel(const Customer& from, const Customer& to) {
         this->capacity = capac;
         this->workTime = workT;
         this->route.emplace_back(from, travelCost);
+        this->MarkModified();
+        if (from != depot) {
+            this->IncludeInSpatialSummary(from);
+        }
     }
     return ret;
 }
@@ -125,70 +174,171 @@ bool Route::Travel(const Customer& from, const Customer& to) {
  * same logic they use for non-empty routes.
  */
 void Route::EmptyRoute(const Customer& depot) {
+    this->MarkModified();
     this->route.clear();
     this->capacity = this->initialCapacity;
     this->workTime = this->initialWorkTime;
     this->totalCost = 0;
+    this->spatial = RouteSpatialSummary{};
     this->route.emplace_back(depot, 0);
     this->route.emplace_back(depot, 0);
 }
 
+/** @brief Extend the spatial summary with one inserted customer.
+ *
+ * Insertions only grow the footprint, so the bounding box, centroid sums, and
+ * sector offsets are widened in constant time. The sector reference stays
+ * where the last full refresh put it.
+ * @param[in] c The customer just added to the route
+ */
+void Route::IncludeInSpatialSummary(const Customer& c) {
+    const Customer& depot = this->route.front().first;
+    const auto x = static_cast<float>(c.x);
+    const auto y = static_cast<float>(c.y);
+    const float angle = PseudoAngle(x - static_cast<float>(depot.x), y - static_cast<float>(depot.y));
+    RouteSpatialSummary& summary = this->spatial;
+    if (summary.customers == 0) {
+        summary.minX = summary.maxX = x;
+        summary.minY = summary.maxY = y;
+        summary.sectorCenter = angle;
+        summary.sectorLow = summary.sectorHigh = 0.0F;
+    } else {
+        summary.minX = std::min(summary.minX, x);
+        summary.maxX = std::max(summary.maxX, x);
+        summary.minY = std::min(summary.minY, y);
+        summary.maxY = std::max(summary.maxY, y);
+        const float offset = WrapPseudoAngle(angle - summary.sectorCenter);
+        summary.sectorLow = std::min(summary.sectorLow, offset);
+        summary.sectorHigh = std::max(summary.sectorHigh, offset);
+    }
+    ++summary.customers;
+    summary.sumX += x;
+    summary.sumY += y;
+}
+
+/** @brief Recompute the spatial summary from scratch.
+ *
+ * Removals can shrink the footprint, which cannot be undone incrementally.
+ * The sector is re-centred on the centroid direction so it stays tight for
+ * the usual petal-shaped routes.
+ */
+void Route::RefreshSpatialSummary() {
+    this->spatial = RouteSpatialSummary{};
+    if (this->route.empty()) {
+        return;
+    }
+    const Customer depot = this->route.front().first;
+    for (const StepType& step : this->route) {
+        if (step.first != depot) {
+            this->IncludeInSpatialSummary(step.first);
+        }
+    }
+    RouteSpatialSummary& summary = this->spatial;
+    if (summary.customers == 0) {
+        return;
+    }
+    const auto depotX = static_cast<float>(depot.x);
+    const auto depotY = static_cast<float>(depot.y);
+    summary.sectorCenter = PseudoAngle(summary.CentroidX() - depotX, summary.CentroidY() - depotY);
+    bool first = true;
+    for (const StepType& step : this->route) {
+        if (step.first == depot) {
+            continue;
+        }
+        const float angle = PseudoAngle(static_cast<float>(step.first.x) - depotX,
+                                        static_cast<float>(step.first.y) - depotY);
+        const float offset = WrapPseudoAngle(angle - summary.sectorCenter);
+        summary.sectorLow = first ? offset : std::min(summary.sectorLow, offset);
+        summary.sectorHigh = first ? offset : std::max(summary.sectorHigh, offset);
+        first = false;
+    }
+}
+
 /** @brief Return the number of stored route steps. */
 int Route::size() const { return static_cast<int>(this->route.size()); }
 
-/** @brief Return a pointer to the route step list. */
+/** @brief Return a pointer to the route step list.
+ *
+ * The epoch is left alone: reading through the pointer must not invalidate
+ * neighborhood results, and routes shared with pool tasks must stay unwritten.
+ * Steps are changed through the route mutators, which renew the epoch.
+ */
 RouteList* Route::GetRoute() { return &this->route; }
 const RouteList* Route::GetRoute() const { return &this->route; }
 
-/** @brief Add one customer to this route.
+/** @brief Find the cheapest feasible insertion position of one customer.
  *
- * This function add a customer in the best position of a route respecting
- * the constraints: add the customer in each possible position, then execute
- * the best insertion.
+ * Every arc of the route is tried; the first position with the lowest
+ * resulting cost wins. The route itself is left untouched, so callers can
+ * price insertions without copying the route.
  * @param[in] c The customer to insert
+ * @return The insertion position and resulting cost, or std::nullopt when infeasible
  */
-bool Route::AddElem(const Customer& c) {
+std::optional<Route::InsertionPoint> Route::FindInsertion(const Customer& c) const {
     if (this->capacity < c.request || this->workTime < static_cast<float>(c.serviceTime) || this->route.size() < 2) {
-        return false;
+        return std::nullopt;
     }
 
-    auto bestBefore = this->route.end();
-    int bestTravelToCustomer = 0;
-    int bestCustomerToNext = 0;
-    int bestCost = 0;
-    float bestWorkTime = 0.0F;
-    bool found = false;
-
-    for (auto before = this->route.begin(); std::next(before) != this->route.end(); ++before) {
-        auto next = std::next(before);
-        const int travelToCustomer = this->graph->GetCost(before->first, c);
-        const int customerToNext = this->graph->GetCost(c, next->first);
-        const int deltaCost = travelToCustomer + customerToNext - before->second;
+    PerfCounters::AddCandidates(this->route.size() - 1);
+    std::optional<InsertionPoint> best;
+    for (std::size_t before = 0; before + 1 < this->route.size(); ++before) {
+        const StepType& step = this->route[before];
+        const int travelToCustomer = this->graph->GetCost(step.first, c);
+        const int customerToNext = this->graph->GetCost(c, this->route[before + 1].first);
+        const int deltaCost = travelToCustomer + customerToNext - step.second;
         const int candidateCost = this->totalCost + deltaCost;
         const float candidateWorkTime =
             this->workTime - static_cast<float>(c.serviceTime) - TravelTime(deltaCost, this->TRAVEL_COST);
         if (candidateWorkTime < 0.0F) {
             continue;
         }
-        if (!found || candidateCost < bestCost) {
-            bestBefore = before;
-            bestTravelToCustomer = travelToCustomer;
-            bestCustomerToNext = customerToNext;
-            bestCost = candidateCost;
-            bestWorkTime = candidateWorkTime;
-            found = true;
+        if (!best.has_value() || candidateCost < best->cost) {
+            best = InsertionPoint{
+                .before = before,
+                .travelToCustomer = travelToCustomer,
+                .customerToNext = customerToNext,
+                .cost = candidateCost,
+                .workTime = candidateWorkTime,
+            };
         }
     }
+    return best;
+}
 
-    if (!found) {
+/** @brief Return the route cost after inserting one customer at its cheapest position.
+ *
+ * @param[in] c The customer to price
+ * @return The resulting route cost, or std::nullopt when no position is feasible
+ */
+std::optional<int> Route::InsertionCost(const Customer& c) const {
+    const std::optional<InsertionPoint> insertion = this->FindInsertion(c);
+    if (!insertion.has_value()) {
+        return std::nullopt;
+    }
+    return insertion->cost;
+}
+
+/** @brief Add one customer to this route.
+ *
+ * This function add a customer in the best position of a route respecting
+ * the constraints: add the customer in each possible position, then execute
+ * the best insertion.
+ * @param[in] c The customer to insert
+ */
+bool Route::AddElem(const Customer& c) {
+    const std::optional<InsertionPoint> insertion = this->FindInsertion(c);
+    if (!insertion.has_value()) {
         return false;
     }
 
+    this->MarkModified();
     this->capacity -= c.request;
-    this->workTime = bestWorkTime;
-    this->totalCost = bestCost;
-    bestBefore->second = bestTravelToCustomer;
-    this->route.insert(std::next(bestBefore), {c, bestCustomerToNext});
+    this->workTime = insertion->workTime;
+    this->totalCost = insertion->cost;
+    const auto before = this->route.begin() + static_cast<std::ptrdiff_t>(insertion->before);
+    before->second = insertion->travelToCustomer;
+    this->route.insert(std::next(before), {c, insertion->customerToNext});
+    this->IncludeInSpatialSummary(c);
     return true;
 }
 
@@ -228,6 +378,7 @@ bool Route::AddElem(const std::list<Customer>& custs) {
     const Customer& firstCustomer = custs.front();
     const Customer& lastCustomer = custs.back();
 
+    PerfCounters::AddCandidates(this->route.size() - 1);
     for (auto before = this->route.begin(); std::next(before) != this->route.end(); ++before) {
         auto next = std::next(before);
         const int firstArc = this->graph->GetCost(before->first, firstCustomer);
@@ -253,6 +404,7 @@ bool Route::AddElem(const std::list<Customer>& custs) {
         return false;
     }
 
+    this->MarkModified();
     auto insertPosition = std::next(bestBefore);
     this->capacity -= request;
     this->workTime = bestWorkTime;
@@ -265,6 +417,7 @@ bool Route::AddElem(const std::list<Customer>& custs) {
             nextCustomer == custs.cend() ? bestLastArc : this->graph->GetCost(*customer, *nextCustomer);
         insertPosition = this->route.insert(insertPosition, {*customer, outgoingCost});
         ++insertPosition;
+        this->IncludeInSpatialSummary(*customer);
     }
     return true;
 }
@@ -276,6 +429,7 @@ bool Route::AddElem(const std::list<Customer>& custs) {
  * @return The state of the operation
  */
 void Route::RemoveCustomer(RouteList::iterator& it) {
+    this->MarkModified();
     // if the route is depot -> customer -> depot delete the route
     if (this->route.size() > 3) {
         Customer del = it->first;
@@ -303,6 +457,7 @@ void Route::RemoveCustomer(RouteList::iterator& it) {
         // delete the customer from the route
         std::advance(it, 1);
         this->route.erase(it);
+        this->RefreshSpatialSummary();
     } else {
         const Customer depot = this->route.front().first;
         this->EmptyRoute(depot);
@@ -335,6 +490,9 @@ int Route::GetTotalCost() const { return this->totalCost; }
 /** @brief Return the vehicle capacity this route was created with. */
 int Route::GetInitialCapacity() const { return this->initialCapacity; }
 
+/** @brief Return the graph shared by every route of the instance. */
+const Graph& Route::GetGraph() const { return *this->graph; }
+
 /** @brief Return the travel cost between two customers. */
 int Route::GetTravelCost(const Customer& from, const Customer& to) const { return this->graph->GetCost(from, to); }
 
@@ -364,6 +522,37 @@ float Route::GetDistanceFrom(const Route& r) const {
     return *std::ranges::min_element(min);
 }
 
+/** @brief Return the spatial summary of the route customers. */
+const RouteSpatialSummary& Route::GetSpatialSummary() const { return this->spatial; }
+
+/** @brief Check whether two routes are spatially close.
+ *
+ * Two footprints are near when their polar sectors around the depot overlap
+ * once widened by the angular slack, or when the gap between their bounding
+ * boxes is within the distance slack. Empty routes are near every route since
+ * they can absorb customers from anywhere.
+ * @param[in] r The route to compare with
+ * @param[in] sectorSlack Extra pseudo-angle tolerated between the two sectors
+ * @param[in] distanceSlack Maximum Euclidean gap between the bounding boxes
+ * @return True if inter-route moves between the two routes are worth evaluating
+ */
+bool Route::IsSpatiallyNear(const Route& r, float sectorSlack, float distanceSlack) const {
+    const RouteSpatialSummary& a = this->spatial;
+    const RouteSpatialSummary& b = r.spatial;
+    if (a.customers == 0 || b.customers == 0) {
+        return true;
+    }
+    const float aMiddle = a.sectorCenter + (0.5F * (a.sectorLow + a.sectorHigh));
+    const float bMiddle = b.sectorCenter + (0.5F * (b.sectorLow + b.sectorHigh));
+    const float halfWidths = 0.5F * ((a.sectorHigh - a.sectorLow) + (b.sectorHigh - b.sectorLow));
+    if (std::fabs(WrapPseudoAngle(aMiddle - bMiddle)) <= halfWidths + sectorSlack) {
+        return true;
+    }
+    const float xGap = std::max({0.0F, a.minX - b.maxX, b.minX - a.maxX});
+    const float yGap = std::max({0.0F, a.minY - b.maxY, b.minY - a.maxY});
+    return (xGap * xGap) + (yGap * yGap) <= distanceSlack * distanceSlack;
+}
+
 /** @brief Find a customer in the route.
  *
  * Search for a customer in the route, if it is present return True,
@@ -382,6 +571,8 @@ bool Route::FindCustomer(const Customer& c) const {
  * @return True if the new route is valid
  */
 bool Route::RebuildRoute(const std::list<Customer>& cust) {
+    PerfCounters::AddCandidates(1);
+    this->MarkModified();
     this->route.clear();
     this->totalCost = 0;
     this->capacity = this->initialCapacity;
@@ -407,6 +598,7 @@ bool Route::RebuildRoute(const std::list<Customer>& cust) {
         // after the travel if constraints fails
         if (capac < 0 || workT < returnTime) {
             // no time or capacity to serve the customer: return to depot
+            this->RefreshSpatialSummary();
             return false;
         } else {
             // the travel can be added to the route
@@ -418,6 +610,7 @@ bool Route::RebuildRoute(const std::list<Customer>& cust) {
         }
     }
     this->route.emplace_back(depot, 0);
+    this->RefreshSpatialSummary();
     return true;
 }
 
@@ -2,8 +2,10 @@
 #define Route_H
 
 #include "Graph.h"
+#include <cstdint>
 #include <iomanip>
 #include <list>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -12,6 +14,32 @@
 using StepType = std::pair<Customer, int>;
 using RouteList = std::vector<StepType>;
 
+/** @brief Cheap geometric footprint of the customers served by a route.
+ *
+ * Angles are pseudo-angles around the depot in [0, 4): they keep the angular
+ * order of atan2 without trigonometric calls. The polar sector is stored as a
+ * reference angle plus the lowest and highest customer offsets from it, so a
+ * sector crossing the positive x axis needs no special case.
+ */
+struct RouteSpatialSummary {
+    int customers = 0;         /**< Number of non-depot customers summarized */
+    float minX = 0.0F;         /**< Bounding box lower x */
+    float minY = 0.0F;         /**< Bounding box lower y */
+    float maxX = 0.0F;         /**< Bounding box upper x */
+    float maxY = 0.0F;         /**< Bounding box upper y */
+    float sumX = 0.0F;         /**< Coordinate sum used to derive the centroid */
+    float sumY = 0.0F;         /**< Coordinate sum used to derive the centroid */
+    float sectorCenter = 0.0F; /**< Reference pseudo-angle of the polar sector */
+    float sectorLow = 0.0F;    /**< Lowest customer offset from the reference, in [-2, 0] */
+    float sectorHigh = 0.0F;   /**< Highest customer offset from the reference, in [0, 2] */
+
+    /** @brief Return the centroid x coordinate of the summarized customers. */
+    [[nodiscard]] float CentroidX() const { return customers > 0 ? sumX / static_cast<float>(customers) : 0.0F; }
+
+    /** @brief Return the centroid y coordinate of the summarized customers. */
+    [[nodiscard]] float CentroidY() const { return customers > 0 ? sumY / static_cast<float>(customers) : 0.0F; }
+};
+
 /** @brief Capacity- and time-constrained vehicle route.
  *
  * A route stores an ordered sequence of customer steps, including the depot at both
@@ -40,6 +68,31 @@ class Route {
     float TRAVEL_COST;     /**< Cost parameter for each travel */
     float ALPHA;           /**< Alpha parameter for route evaluation */
     const Graph* graph;    /**< Shared immutable graph used for cost lookups */
+    std::uint64_t epoch;   /**< Unique id of the current content, renewed by every mutation */
+
+    RouteSpatialSummary spatial; /**< Footprint kept current by every route mutation */
+
+    /** @brief Renew the modification epoch after the route content changes. */
+    void MarkModified();
+
+    /** @brief Extend the spatial summary with one newly inserted customer. */
+    void IncludeInSpatialSummary(const Customer&);
+
+    /** @brief Recompute the spatial summary from the current step sequence. */
+    void RefreshSpatialSummary();
+
+    /** @brief Cheapest feasible position for inserting one customer. */
+    struct InsertionPoint {
+        std::size_t before;   /**< Index of the step preceding the inserted customer */
+        int travelToCustomer; /**< Arc cost from the preceding step to the customer */
+        int customerToNext;   /**< Arc cost from the customer to the following step */
+        int cost;             /**< Route cost after the insertion */
+        float workTime;       /**< Remaining work time after the insertion */
+    };
+
+    /** @brief Find the cheapest feasible insertion of a customer without modifying the route. */
+    [[nodiscard]] std::optional<InsertionPoint> FindInsertion(const Customer&) const;
+
   protected:
     RouteList route; /**< Ordered route steps */
 
@@ -107,7 +160,7 @@ class Route {
     /** @brief Return the number of stored route steps. */
     [[nodiscard]] int size() const;
 
-    /** @brief Return a mutable pointer to the underlying step sequence. */
+    /** @brief Return a mutable pointer to the underlying step sequence; editing through it keeps the epoch. */
     [[nodiscard]] RouteList* GetRoute();
 
     /** @brief Return a read-only pointer to the underlying step sequence. */
@@ -116,6 +169,12 @@ class Route {
     /** @brief Try to append one customer before route closure. */
     bool AddElem(const Customer&);
 
+    /** @brief Return the route cost after the cheapest feasible insertion of a customer.
+     *
+     * @return std::nullopt when no position keeps the route feasible.
+     */
+    [[nodiscard]] std::optional<int> InsertionCost(const Customer&) const;
+
     /** @brief Try to append a sequence of customers in order. */
     bool AddElem(const std::list<Customer>&);
 
@@ -131,15 +190,35 @@ class Route {
     /** @brief Return the current sum of route arc costs. */
     [[nodiscard]] int GetTotalCost() const;
 
+    /** @brief Return the modification epoch of the current content.
+     *
+     * Two routes with the same epoch are copies with identical content, so
+     * neighborhood results computed for an epoch stay valid until it changes.
+     */
+    [[nodiscard]] std::uint64_t GetEpoch() const;
+
     /** @brief Return the vehicle capacity this route was created with. */
     [[nodiscard]] int GetInitialCapacity() const;
 
+    /** @brief Return the shared graph used for cost lookups and exact-route caching. */
+    [[nodiscard]] const Graph& GetGraph() const;
+
     /** @brief Return the graph travel cost between two customers. */
     [[nodiscard]] int GetTravelCost(const Customer&, const Customer&) const;
 
     /** @brief Compute a route-to-route distance used for route balancing heuristics. */
     [[nodiscard]] float GetDistanceFrom(const Route&) const;
 
+    /** @brief Return the polar sector, bounding box, and centroid of the route customers. */
+    [[nodiscard]] const RouteSpatialSummary& GetSpatialSummary() const;
+
+    /** @brief Check whether two route footprints are close enough to exchange customers.
+     *
+     * @return true when the polar sectors overlap within the angular slack or the
+     * bounding boxes are separated by at most the distance slack.
+     */
+    [[nodiscard]] bool IsSpatiallyNear(const Route&, float, float) const;
+
     /** @brief Check whether this route contains a customer. */
     [[nodiscard]] bool FindCustomer(const Customer&) const;
 
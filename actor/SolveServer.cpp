@@ -0,0 +1,481 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "SolveServer.h"
+#include "Controller.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <list>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+using Json = nlohmann::json;
+
+constexpr const char* kServeUsage = "Usage: ./VRP [-v] --serve [--socket PATH] [--cores N]";
+constexpr unsigned kDefaultConcurrentSolves = 4;
+constexpr std::size_t kReadChunk = 4096;
+
+/** @brief Hash a canonical JSON dump with 64-bit FNV-1a, as a hexadecimal instance id. */
+std::string InstanceHash(const Json& instance) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const char c : instance.dump()) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    std::array<char, 17> hex{};
+    std::snprintf(hex.data(), hex.size(), "%016llx", static_cast<unsigned long long>(hash));
+    return hex.data();
+}
+
+/** @brief Return route lists of customer names, depot included, as written by Utils::SaveResult. */
+Json RouteNames(const Routes& routes) {
+    Json names = Json::array();
+    for (const Route& route : routes) {
+        if (route.size() <= 2) {
+            continue;
+        }
+        Json r = Json::array();
+        for (const auto& step : *route.GetRoute()) {
+            r.push_back(step.first.name);
+        }
+        names.push_back(std::move(r));
+    }
+    return names;
+}
+
+/** @brief Sum the route costs of a route set. */
+int RoutesCost(const Routes& routes) {
+    int cost = 0;
+    for (const Route& route : routes) {
+        cost += route.GetTotalCost();
+    }
+    return cost;
+}
+
+/** @brief Read one line from a descriptor, keeping the bytes after it for the next call.
+ *
+ * @param[in] fd Descriptor to read
+ * @param[in,out] pending Bytes read past the previous line
+ * @param[out] line The line without its newline
+ * @return false once the input has ended and no bytes are left
+ */
+bool ReadLine(int fd, std::string& pending, std::string& line) {
+    std::array<char, kReadChunk> chunk{};
+    std::size_t newline = pending.find('\n');
+    while (newline == std::string::npos) {
+        const ssize_t count = ::read(fd, chunk.data(), chunk.size());
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            if (pending.empty()) {
+                return false;
+            }
+            line = std::move(pending);
+            pending.clear();
+            return true;
+        }
+        pending.append(chunk.data(), static_cast<std::size_t>(count));
+        newline = pending.find('\n');
+    }
+    line = pending.substr(0, newline);
+    pending.erase(0, newline + 1);
+    return true;
+}
+
+/** @brief Read the thread budget a request asks for, capped by the budget of the server.
+ *
+ * @param[in] request Solve request
+ * @param[in] limit Threads the server grants each solve
+ * @return The requested threads clamped to [1, limit], or limit when none are requested
+ */
+unsigned RequestedCores(const Json& request, unsigned limit) {
+    if (!request.contains("cores")) {
+        return limit;
+    }
+    const Json& cores = request.at("cores");
+    if (!cores.is_number_unsigned()) {
+        throw std::runtime_error("cores must be a non-negative integer");
+    }
+    return static_cast<unsigned>(std::clamp<std::uint64_t>(cores.get<std::uint64_t>(), 1, limit));
+}
+} // namespace
+
+/** @brief Output side of one client, shared by the solves it requested.
+ *
+ * Events of concurrent solves are written whole under one lock, so lines
+ * never interleave. A socket is closed once its reader and its last solve
+ * are done; standard output is left open.
+ */
+struct SolveServer::Channel {
+    int fd = -1;        /**< Output descriptor */
+    bool owned = false; /**< True when the descriptor is closed with the channel */
+    std::mutex mutex;   /**< Serializes whole event lines */
+
+    Channel(int descriptor, bool owns) : fd(descriptor), owned(owns) {}
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+    ~Channel() {
+        if (this->owned) {
+            ::close(this->fd);
+        }
+    }
+
+    /** @brief Write one event as a line; a client that went away is ignored. */
+    void Send(const Json& event) {
+        const std::string text = event.dump() + "\n";
+        std::scoped_lock lock(this->mutex);
+        std::size_t written = 0;
+        while (written < text.size()) {
+            const ssize_t count = ::write(this->fd, text.data() + written, text.size() - written);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                return;
+            }
+            written += static_cast<std::size_t>(count);
+        }
+    }
+};
+
+/** @brief Create a solve server.
+ *
+ * @param[in] path Unix socket path, or nothing to serve standard input and output
+ * @param[in] cores Default thread budget of a solve; zero shares the machine between the concurrent solves
+ * @param[in] costTravel Cost parameter for each travel.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @param[in] maxTime Maximum execution time of a solve without deadline, in minutes.
+ */
+SolveServer::SolveServer(std::optional<std::string> path, unsigned cores, float costTravel, float alphaParam,
+                         int maxTime)
+    : socketPath(std::move(path)), costTravel(costTravel), alphaParam(alphaParam), maxTimeMin(maxTime) {
+    const unsigned hardware = std::max(1U, std::thread::hardware_concurrency());
+    this->coresPerSolve = cores > 0 ? cores : std::max(1U, hardware / kDefaultConcurrentSolves);
+    // Keep several solves in flight even on small machines, so a long solve
+    // never blocks a short request behind it.
+    this->concurrentSolves = std::max(kDefaultConcurrentSolves, hardware / this->coresPerSolve);
+}
+
+/** @brief Parse server-mode arguments.
+ *
+ * Server mode writes events to standard output, so every log message of the
+ * process, including the search trace, is sent to standard error instead.
+ * @param[in] argc The number of arguments passed through command line.
+ * @param[in] argv The arguments passed through command line.
+ * @param[in] costTravel Cost parameter for each travel.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @param[in] maxTime Maximum execution time of a solve without deadline, in minutes.
+ * @return The server, or nothing when the arguments do not ask for server mode
+ */
+std::optional<SolveServer> SolveServer::FromArguments(int argc, char** argv, float costTravel, float alphaParam,
+                                                      int maxTime) {
+    int index = 1;
+    bool verbose = false;
+    if (index < argc && strcmp(argv[index], "-v") == 0) {
+        verbose = true;
+        ++index;
+    }
+    if (index >= argc || strcmp(argv[index], "--serve") != 0) {
+        return std::nullopt;
+    }
+    ++index;
+    std::optional<std::string> path;
+    unsigned cores = 0;
+    while (index < argc) {
+        if (index + 1 >= argc) {
+            throw std::runtime_error(kServeUsage);
+        }
+        if (strcmp(argv[index], "--socket") == 0) {
+            path = argv[index + 1];
+        } else if (strcmp(argv[index], "--cores") == 0) {
+            try {
+                cores = static_cast<unsigned>(std::stoul(argv[index + 1]));
+            } catch (const std::logic_error&) {
+                throw std::runtime_error(kServeUsage);
+            }
+        } else {
+            throw std::runtime_error(kServeUsage);
+        }
+        index += 2;
+    }
+    Utils& u = Utils::Instance();
+    u.verbose = verbose;
+    u.LogToStream(std::cerr);
+    return SolveServer(std::move(path), cores, costTravel, alphaParam, maxTime);
+}
+
+/** @brief Serve until the input ends or a shutdown request arrives.
+ *
+ * Solves still running when the server stops are finished and reported
+ * before Run returns.
+ */
+void SolveServer::Run() {
+    // A client closing its socket must not kill the server on the next write.
+    std::signal(SIGPIPE, SIG_IGN);
+    Utils& u = Utils::Instance();
+    this->solvers = std::make_shared<ThreadPool>(this->concurrentSolves);
+    u.logger("Serving on " + this->socketPath.value_or(std::string("standard input")) + ", " +
+                 std::to_string(this->concurrentSolves) + " solves at a time with " +
+                 std::to_string(this->coresPerSolve) + " threads each",
+             u.INFO);
+    if (this->socketPath.has_value()) {
+        this->ServeSocket();
+    } else {
+        this->ServeConnection(STDIN_FILENO, std::make_shared<Channel>(STDOUT_FILENO, false));
+    }
+    this->solvers->JoinAll();
+    this->solvers.reset();
+}
+
+/** @brief Accept connections on the Unix socket, one reader thread each.
+ *
+ * A stale socket file left by a previous server is replaced. A shutdown
+ * request closes the listening socket; open connections then stop reading
+ * and their readers are joined.
+ */
+void SolveServer::ServeSocket() {
+    const std::string& path = *this->socketPath;
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::ranges::copy(path, address.sun_path);
+    if (std::filesystem::is_socket(path)) {
+        std::filesystem::remove(path);
+    }
+    this->listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (this->listenFd < 0) {
+        throw std::runtime_error("Cannot create socket: " + std::string(std::strerror(errno)));
+    }
+    if (::bind(this->listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(this->listenFd, SOMAXCONN) != 0) {
+        const std::string error = std::strerror(errno);
+        ::close(this->listenFd);
+        throw std::runtime_error("Cannot listen on " + path + ": " + error);
+    }
+
+    /** @brief Reader thread of one connection. */
+    struct Reader {
+        std::thread thread;                      /**< Thread running ServeConnection */
+        std::shared_ptr<std::atomic<bool>> done; /**< Set when the thread is about to exit */
+        std::weak_ptr<Channel> channel;          /**< Output of the connection, alive while in use */
+    };
+    std::list<Reader> readers;
+    const auto reapFinished = [&readers]() {
+        readers.remove_if([](Reader& reader) {
+            if (!reader.done->load()) {
+                return false;
+            }
+            reader.thread.join();
+            return true;
+        });
+    };
+    while (true) {
+        const int client = ::accept(this->listenFd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break;
+        }
+        reapFinished();
+        auto channel = std::make_shared<Channel>(client, true);
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        std::weak_ptr<Channel> watch = channel;
+        std::thread thread([this, client, channel = std::move(channel), done]() {
+            this->ServeConnection(client, channel);
+            done->store(true);
+        });
+        readers.push_back(Reader{.thread = std::move(thread), .done = std::move(done), .channel = std::move(watch)});
+    }
+    for (Reader& reader : readers) {
+        // Unblock readers still waiting for input; solves keep their output side.
+        if (const std::shared_ptr<Channel> channel = reader.channel.lock()) {
+            ::shutdown(channel->fd, SHUT_RD);
+        }
+        reader.thread.join();
+    }
+    ::close(this->listenFd);
+    this->listenFd = -1;
+    std::filesystem::remove(path);
+}
+
+/** @brief Read request lines from one client.
+ *
+ * @param[in] input Descriptor carrying the requests
+ * @param[in] channel Output of the client
+ */
+void SolveServer::ServeConnection(int input, const std::shared_ptr<Channel>& channel) {
+    std::string pending;
+    std::string line;
+    while (ReadLine(input, pending, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        if (!this->HandleRequest(line, channel)) {
+            if (this->listenFd >= 0) {
+                ::shutdown(this->listenFd, SHUT_RDWR);
+            }
+            return;
+        }
+    }
+}
+
+/** @brief Validate one request and queue its solve.
+ *
+ * Malformed requests are answered with an error event and do not stop the
+ * server.
+ * @param[in] text The request line
+ * @param[in] channel Output of the requesting client
+ * @return false when the request asks the server to stop
+ */
+bool SolveServer::HandleRequest(const std::string& text, const std::shared_ptr<Channel>& channel) {
+    Json id;
+    try {
+        const Json request = Json::parse(text);
+        if (!request.is_object()) {
+            throw std::runtime_error("Request must be a JSON object");
+        }
+        id = request.value("id", Json());
+        const std::string op = request.value("op", std::string("solve"));
+        if (op == "shutdown") {
+            channel->Send({{"id", id}, {"event", "shutdown"}});
+            return false;
+        }
+        if (op != "solve") {
+            throw std::runtime_error("Unknown op: " + op);
+        }
+        std::string instanceId;
+        SolveRequest solve{
+            .id = id,
+            .instance = this->ResolveInstance(request, instanceId),
+            .deadlineMilliseconds = std::nullopt,
+            .routes = {},
+            .cores = RequestedCores(request, this->coresPerSolve),
+        };
+        if (request.contains("deadline_ms")) {
+            solve.deadlineMilliseconds = request.at("deadline_ms").get<long long>();
+        }
+        if (request.contains("routes")) {
+            solve.routes = request.at("routes").get<std::vector<std::vector<std::string>>>();
+        }
+        channel->Send({{"id", id}, {"event", "accepted"}, {"instance_id", instanceId}});
+        this->solvers->AddTask([this, solve = std::move(solve), channel]() { this->Solve(solve, channel); });
+    } catch (const std::exception& e) {
+        channel->Send({{"id", id}, {"event", "error"}, {"message", e.what()}});
+    }
+    return true;
+}
+
+/** @brief Find or parse the instance of a request.
+ *
+ * An inline instance is hashed, parsed and cached unless the same document
+ * was seen before; its neighborhoods are built once here, and every solve
+ * copies the ready graph. The oldest instance is dropped when the cache is full.
+ * @param[in] request The request carrying "instance" or "instance_id"
+ * @param[out] instanceId Hash of the instance, usable by later requests
+ * @return The parsed instance
+ */
+std::shared_ptr<const InstanceData> SolveServer::ResolveInstance(const Json& request, std::string& instanceId) {
+    if (request.contains("instance")) {
+        const Json& document = request.at("instance");
+        instanceId = InstanceHash(document);
+        {
+            std::scoped_lock lock(*this->cacheMutex);
+            const auto found = this->instances.find(instanceId);
+            if (found != this->instances.end()) {
+                return found->second;
+            }
+        }
+        // Parse outside the lock, so a large instance does not stall other requests.
+        auto parsed = std::make_shared<InstanceData>(Utils::ParseInstance(document));
+        parsed->graph.PrepareNeighborhoods();
+        std::scoped_lock lock(*this->cacheMutex);
+        const auto [entry, inserted] = this->instances.emplace(instanceId, std::move(parsed));
+        if (inserted) {
+            this->instanceOrder.push_back(instanceId);
+            if (this->instanceOrder.size() > MaxCachedInstances) {
+                this->instances.erase(this->instanceOrder.front());
+                this->instanceOrder.pop_front();
+            }
+        }
+        return entry->second;
+    }
+    if (!request.contains("instance_id")) {
+        throw std::runtime_error("Request needs \"instance\" or \"instance_id\"");
+    }
+    instanceId = request.at("instance_id").get<std::string>();
+    std::scoped_lock lock(*this->cacheMutex);
+    const auto found = this->instances.find(instanceId);
+    if (found == this->instances.end()) {
+        throw std::runtime_error("Unknown instance_id: " + instanceId);
+    }
+    return found->second;
+}
+
+/** @brief Solve one request with its own controller.
+ *
+ * The initial solution and every later improvement are sent as incumbent
+ * events; the done event carries the best solution of the run.
+ * @param[in] request The accepted request
+ * @param[in] channel Output of the requesting client
+ */
+void SolveServer::Solve(const SolveRequest& request, const std::shared_ptr<Channel>& channel) const {
+    const auto start = std::chrono::steady_clock::now();
+    const auto elapsed = [&start]() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+    const auto sendSolution = [&request, &channel, &elapsed](const char* event, const Routes& routes) {
+        channel->Send({{"id", request.id},
+                       {"event", event},
+                       {"cost", RoutesCost(routes)},
+                       {"routes", RouteNames(routes)},
+                       {"elapsed_ms", elapsed()}});
+    };
+    try {
+        Controller controller;
+        controller.GetUtils().verbose = Utils::Instance().verbose;
+        controller.GetUtils().LogToStream(std::cerr);
+        controller.SetWorkerBudget(std::max(1U, request.cores));
+        if (request.deadlineMilliseconds.has_value()) {
+            controller.SetDeadline(start + std::chrono::milliseconds(*request.deadlineMilliseconds));
+        }
+        controller.SetInitialRoutes(request.routes);
+        controller.SetIncumbentCallback([&sendSolution](const Routes& best) { sendSolution("incumbent", best); });
+        controller.Init(Utils::BuildModel(*request.instance, this->costTravel, this->alphaParam), this->maxTimeMin);
+        sendSolution("incumbent", controller.GetBestRoutes());
+        controller.RunVRP();
+        sendSolution("done", controller.GetBestRoutes());
+    } catch (const std::exception& e) {
+        channel->Send({{"id", request.id}, {"event", "error"}, {"message", e.what()}, {"elapsed_ms", elapsed()}});
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef SolveServer_H
+#define SolveServer_H
+
+#include "Utils.h"
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/** @brief Long-running solve service speaking JSON lines over stdin/stdout or a Unix socket.
+ *
+ * Each input line is one request; each output line is one event tagged with
+ * the request id. Parsed instances are cached by a hash of their JSON, so a
+ * request can name an instance seen before by "instance_id" and skip parsing
+ * and neighborhood construction. Solves run concurrently on one pool that
+ * lives as long as the server, each with its own thread budget, and stream
+ * every new incumbent while they run.
+ *
+ * Requests:
+ *  - {"id", "instance": {...} | "instance_id": "...", "deadline_ms", "routes", "cores"}
+ *  - {"id", "op": "shutdown"} stops the server once running solves finish.
+ *  "cores" may lower the thread budget of a solve below the --cores of the
+ *  server but never raise it.
+ *
+ * Events: "accepted" with the instance id, "incumbent" and "done" with cost,
+ * routes and elapsed_ms, and "error" with a message.
+ */
+class SolveServer {
+  public:
+    /** @brief Create a server on stdin/stdout, or on a Unix socket when a path is given. */
+    SolveServer(std::optional<std::string>, unsigned, float, float, int);
+
+    /** @brief Build a server from "[-v] --serve [--socket PATH] [--cores N]" arguments, if requested. */
+    static std::optional<SolveServer> FromArguments(int, char**, float, float, int);
+
+    /** @brief Serve requests until the input ends or a shutdown request arrives. */
+    void Run();
+
+  private:
+    struct Channel;
+
+    /** @brief One accepted solve request. */
+    struct SolveRequest {
+        nlohmann::json id;                             /**< Client tag echoed in every event */
+        std::shared_ptr<const InstanceData> instance;  /**< Cached parsed instance */
+        std::optional<long long> deadlineMilliseconds; /**< Wall-clock budget, if bounded */
+        std::vector<std::vector<std::string>> routes;  /**< Warm-start routes of customer names */
+        unsigned cores = 1;                            /**< Thread budget of the solve */
+    };
+
+    /** @brief Read requests from one input until it ends or the server stops. */
+    void ServeConnection(int, const std::shared_ptr<Channel>&);
+
+    /** @brief Handle one request line; return false when it asks the server to stop. */
+    bool HandleRequest(const std::string&, const std::shared_ptr<Channel>&);
+
+    /** @brief Return the cached instance named or carried by a request, parsing it when new. */
+    std::shared_ptr<const InstanceData> ResolveInstance(const nlohmann::json&, std::string&);
+
+    /** @brief Solve one request and stream its events. */
+    void Solve(const SolveRequest&, const std::shared_ptr<Channel>&) const;
+
+    /** @brief Accept socket connections until a shutdown request arrives. */
+    void ServeSocket();
+
+    static constexpr std::size_t MaxCachedInstances = 64; /**< Parsed instances kept before the oldest is dropped */
+
+    std::optional<std::string> socketPath;                                /**< Unix socket path, none for stdin */
+    unsigned coresPerSolve = 1;                                           /**< Default thread budget of a solve */
+    unsigned concurrentSolves = 1;                                        /**< Solves running at once */
+    float costTravel = 0.0F;                                              /**< Cost parameter for each travel */
+    float alphaParam = 0.0F;                                              /**< Alpha parameter for route evaluation */
+    int maxTimeMin = 0;                                                   /**< Time budget of a solve in minutes */
+    std::map<std::string, std::shared_ptr<const InstanceData>> instances; /**< Parsed instances by hash */
+    std::deque<std::string> instanceOrder;                                /**< Cached hashes, oldest first */
+    std::shared_ptr<ThreadPool> solvers;                                  /**< Pool running the solves */
+    int listenFd = -1;                                                    /**< Listening socket, -1 when closed */
+    std::shared_ptr<std::mutex> cacheMutex =
+        std::make_shared<std::mutex>(); /**< Guards the instance cache; shared so the server stays movable */
+};
+
+#endif /* SolveServer_H */
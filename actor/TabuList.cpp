@@ -16,7 +16,9 @@
  ****************************************************************************/
 
 #include "TabuList.h"
+#include "Checkpoint.h"
 #include <algorithm>
+#include <iterator>
 
 namespace {
 /** @brief Check whether two moves relocate the same customer between the same routes. */
@@ -24,6 +26,23 @@ bool SameMove(const Move& left, const Move& right) {
     return left.first.first == right.first.first && left.first.second == right.first.second &&
            left.second == right.second;
 }
+
+/** @brief Write one tabu element: customer, destination and source routes, score. */
+void SaveElement(CheckpointWriter& out, const TabuElement& element) {
+    out.CustomerRef(element.first.first.first);
+    out.I32(element.first.first.second);
+    out.I32(element.first.second);
+    out.F32(element.second);
+}
+
+/** @brief Read one tabu element written by SaveElement. */
+TabuElement LoadElement(CheckpointReader& in) {
+    Customer customer = in.CustomerRef();
+    const int destination = in.I32();
+    const int source = in.I32();
+    const float score = in.F32();
+    return {{{customer, destination}, source}, score};
+}
 } // namespace
 
 /** @brief Add a tabu move to the list.
@@ -123,3 +142,36 @@ float TabuList::Check(const Move& m) const {
     });
     return (findIter != this->nonBestMoves.cend()) ? findIter->second : 0;
 }
+
+/** @brief Save the list in its current order, so a resumed search ages it identically.
+ *
+ * @param[in,out] out Checkpoint being written
+ */
+void TabuList::Save(CheckpointWriter& out) const {
+    out.U32(this->size);
+    out.U32(static_cast<std::uint32_t>(std::distance(this->tabulist.cbegin(), this->tabulist.cend())));
+    for (const TabuElement& element : this->tabulist) {
+        SaveElement(out, element);
+    }
+    out.U32(static_cast<std::uint32_t>(this->nonBestMoves.size()));
+    for (const TabuElement& element : this->nonBestMoves) {
+        SaveElement(out, element);
+    }
+}
+
+/** @brief Restore a list saved by Save.
+ *
+ * @param[in,out] in Checkpoint being read
+ */
+void TabuList::Load(CheckpointReader& in) {
+    this->size = in.U32();
+    this->tabulist.clear();
+    auto tail = this->tabulist.before_begin();
+    for (std::uint32_t count = in.U32(); count > 0; --count) {
+        tail = this->tabulist.insert_after(tail, LoadElement(in));
+    }
+    this->nonBestMoves.clear();
+    for (std::uint32_t count = in.U32(); count > 0; --count) {
+        this->nonBestMoves.push_back(LoadElement(in));
+    }
+}
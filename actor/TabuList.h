@@ -6,6 +6,9 @@
 #include <forward_list>
 #include <vector>
 
+class CheckpointReader;
+class CheckpointWriter;
+
 /** @brief Move descriptor: customer, destination route index, and source route index. */
 using Move = std::pair<std::pair<Customer, int>, int>;
 
@@ -54,6 +57,12 @@ class TabuList {
 
     /** @brief Return the tabu penalty associated with a move. */
     [[nodiscard]] float Check(const Move&) const;
+
+    /** @brief Write tenure, tabu moves and move history to a checkpoint. */
+    void Save(CheckpointWriter&) const;
+
+    /** @brief Replace the memory with the one stored in a checkpoint. */
+    void Load(CheckpointReader&);
 };
 
 #endif /* TabuList_H */
@@ -16,6 +16,7 @@
  ****************************************************************************/
 
 #include "TabuSearch.h"
+#include "../lib/PerfCounters.h"
 #include "../lib/ThreadPool.h"
 
 #include <algorithm>
@@ -78,6 +79,9 @@ constexpr int kTabuSegmentNeighborDivisor = 3;
 // the route/customer term lets larger route sets spend more time exploring.
 constexpr int kMinTabuCallMilliseconds = 1000;
 constexpr int kTabuMillisecondsPerCustomerRoute = 4;
+// Deterministic runs convert that budget into evaluated moves at a rate
+// measured on a single core, so they stop close to where a timed run does.
+constexpr std::size_t kTabuMovesPerMillisecond = 600;
 
 // Cap the extra tenure produced by rejected-candidate pressure so diversification
 // cannot freeze too much of the neighborhood after one noisy iteration.
@@ -210,10 +214,15 @@ Routes ApplyTabuCandidate(const Routes& base, const TabuCandidateResult& candida
  *
  * If no improving candidate is found, the search diversifies by selecting one
  * of the tracked non-best candidates and adjusting the tabu tenure.
+ *
+ * A timed call ends at its own time budget or at the deadline of the run,
+ * whichever comes first; a deterministic call is bounded by moves alone.
  */
-void TabuSearch::Tabu(Routes& routes, int times) {
+std::size_t TabuSearch::Tabu(Routes& routes, int times,
+                             std::optional<std::chrono::steady_clock::time_point> deadline) {
+    PerfCounters::Scope scope(PerfCounters::Tabu, routes);
     if (routes.empty()) {
-        return;
+        return 0;
     }
     constexpr std::size_t maxNonBest = 20;
     const float tabuTime = static_cast<float>(this->numCustomers) * 0.70F;
@@ -221,6 +230,9 @@ void TabuSearch::Tabu(Routes& routes, int times) {
     const auto maxCallDuration = std::chrono::milliseconds(
         std::max(kMinTabuCallMilliseconds,
                  this->numCustomers * static_cast<int>(routes.size()) * kTabuMillisecondsPerCustomerRoute));
+    const auto maxCallMoves = static_cast<std::size_t>(maxCallDuration.count()) * kTabuMovesPerMillisecond;
+    const auto callEnd =
+        deadline.has_value() ? std::min(startedAt + maxCallDuration, *deadline) : startedAt + maxCallDuration;
     // Scan a route-shape-sized nearest-neighbor subset; candidate evaluation is parallel.
     const int averageRouteCustomers =
         std::max(1, (this->numCustomers + static_cast<int>(routes.size()) - 1) / static_cast<int>(routes.size()));
@@ -236,7 +248,12 @@ void TabuSearch::Tabu(Routes& routes, int times) {
     std::set<std::pair<float, Routes>, decltype(nonBestComp)> nonBest(nonBestComp);
     float bestFitness = 0;
     int iterations = 0;
-    while (iterations < times && std::chrono::steady_clock::now() - startedAt < maxCallDuration) {
+    std::size_t evaluatedMoves = 0;
+    // a deterministic search measures its budget in evaluated moves, which no machine or thread count changes
+    auto withinBudget = [&]() {
+        return this->deterministic ? evaluatedMoves < maxCallMoves : std::chrono::steady_clock::now() < callEnd;
+    };
+    while (iterations < times && withinBudget()) {
         iterations++;
         // create a local working copy of solutions
         const float currentFitness = this->Evaluate(s);
@@ -279,7 +296,7 @@ void TabuSearch::Tabu(Routes& routes, int times) {
         std::vector<TabuCandidateResult> candidateResults;
         candidateResults.reserve(sequenceStart);
         this->graph->PrepareNeighborhoods();
-        const unsigned workerCount = std::max(1U, std::thread::hardware_concurrency());
+        const unsigned workerCount = this->workers;
         ThreadPool pool(workerCount);
         const std::size_t chunkSize =
             std::max<std::size_t>(1, (candidateJobs.size() + static_cast<std::size_t>(workerCount) - 1) /
@@ -289,8 +306,10 @@ void TabuSearch::Tabu(Routes& routes, int times) {
         for (std::size_t chunkStart = 0; chunkStart < candidateJobs.size(); chunkStart += chunkSize) {
             const std::size_t chunkEnd = std::min(candidateJobs.size(), chunkStart + chunkSize);
             pool.AddTask([this, &s, &customerRouteIndex, currentFitness, bestFitness, diversificationScale,
-                          &candidateMutex, &candidateResults, &candidateJobs, chunkStart, chunkEnd]() {
+                          &candidateMutex, &candidateResults, &candidateJobs, &evaluatedMoves, chunkStart,
+                          chunkEnd]() {
                 std::vector<TabuCandidateResult> localResults;
+                std::size_t localEvaluated = 0;
                 for (std::size_t jobIndex = chunkStart; jobIndex < chunkEnd; ++jobIndex) {
                     const TabuCandidateJob& job = candidateJobs[jobIndex];
                     const CostNeighborhood& neigh = this->graph->GetNeighborhoodVector(job.anchorCustomer);
@@ -308,6 +327,7 @@ void TabuSearch::Tabu(Routes& routes, int times) {
                         const std::size_t sequence =
                             job.sequenceStart + (static_cast<std::size_t>(evaluatedNeighbors) * kTabuCandidateVariants);
                         ++evaluatedNeighbors;
+                        ++localEvaluated;
                         std::list<Customer> singleCustomer = {in->second};
                         std::optional<TabuCandidateResult> singleCandidate = EvaluateTabuSegmentCandidate(
                             s, this->tabulist, this->lambda, currentFitness, bestFitness, diversificationScale,
@@ -321,6 +341,7 @@ void TabuSearch::Tabu(Routes& routes, int times) {
                         const std::vector<std::list<Customer>> segments = BuildTabuSegmentsContaining(
                             s[static_cast<std::size_t>(sourceRouteIndex)], in->second, kMaxTabuOrOptLength);
                         std::size_t variant = 1;
+                        localEvaluated += segments.size();
                         for (const std::list<Customer>& segment : segments) {
                             std::optional<TabuCandidateResult> segmentCandidate = EvaluateTabuSegmentCandidate(
                                 s, this->tabulist, this->lambda, currentFitness, bestFitness, diversificationScale,
@@ -334,8 +355,9 @@ void TabuSearch::Tabu(Routes& routes, int times) {
                         }
                     }
                 }
+                std::scoped_lock lock(candidateMutex);
+                evaluatedMoves += localEvaluated;
                 if (!localResults.empty()) {
-                    std::scoped_lock lock(candidateMutex);
                     for (TabuCandidateResult& result : localResults) {
                         candidateResults.push_back(std::move(result));
                     }
@@ -407,6 +429,7 @@ void TabuSearch::Tabu(Routes& routes, int times) {
         this->tabulist.DecrementSize();
     }
     std::erase_if(routes, [](const Route& route) { return route.size() <= 2; });
+    return evaluatedMoves;
 }
 
 /** @brief Evaluate the assessment of the solution.
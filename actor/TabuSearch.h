@@ -3,6 +3,8 @@
 
 #include "Route.h"
 #include "TabuList.h"
+#include <chrono>
+#include <optional>
 #include <set>
 
 /** @brief Tabu-search metaheuristic over a set of vehicle routes.
@@ -13,19 +15,36 @@
 class TabuSearch {
   private:
     const Graph* graph;
-    TabuList tabulist;      /**< List of all tabu moves */
-    int numCustomers;       /**< Number of customers */
-    float lambda = 0.0001f; /**< Parameter for penalization of moves */
+    TabuList tabulist;          /**< List of all tabu moves */
+    int numCustomers;           /**< Number of customers */
+    unsigned workers;           /**< Threads evaluating candidate moves */
+    float lambda = 0.0001f;     /**< Parameter for penalization of moves */
+    bool deterministic = false; /**< Bound each call by evaluated moves instead of wall time */
 
     /** @brief Evaluate a route set using the tabu-search objective. */
     float Evaluate(const Routes&);
 
   public:
-    /** @brief Create a tabu-search engine for a graph and customer count. */
-    TabuSearch(const Graph& g, const int n) : graph(&g), numCustomers(n) {};
+    /** @brief Create a tabu-search engine for a graph, customer count, and worker budget. */
+    TabuSearch(const Graph& g, const int n, const unsigned w) : graph(&g), numCustomers(n), workers(w == 0 ? 1 : w) {};
 
-    /** @brief Improve routes by running tabu search for a fixed number of iterations. */
-    void Tabu(Routes&, int);
+    /** @brief Follow a change of the customer count without dropping tabu memory. */
+    void SetCustomerCount(int n) { this->numCustomers = n; }
+
+    /** @brief Bound each call by a budget of evaluated moves instead of wall time, for reproducible runs. */
+    void SetDeterministic(bool enabled) { this->deterministic = enabled; }
+
+    /** @brief Improve routes by tabu search for a number of iterations, ending by a deadline if given.
+     *
+     * @return The number of moves evaluated.
+     */
+    std::size_t Tabu(Routes&, int, std::optional<std::chrono::steady_clock::time_point> = std::nullopt);
+
+    /** @brief Write the tabu memory to a checkpoint. */
+    void Save(CheckpointWriter& out) const { this->tabulist.Save(out); }
+
+    /** @brief Restore the tabu memory from a checkpoint. */
+    void Load(CheckpointReader& in) { this->tabulist.Load(in); }
 };
 
 #endif /* TabuSearch_H */
@@ -0,0 +1,186 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "Checkpoint.h"
+#include <bit>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <stdexcept>
+
+/** @brief Reject a checkpoint that cannot be decoded.
+ *
+ * @param[in] reason What is wrong with the data
+ * @throws std::runtime_error always
+ */
+void CorruptCheckpoint(const std::string& reason) { throw std::runtime_error("Invalid checkpoint: " + reason); }
+
+void CheckpointWriter::U32(std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        this->bytes.push_back(static_cast<char>((value >> shift) & 0xFFU));
+    }
+}
+
+void CheckpointWriter::U64(std::uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        this->bytes.push_back(static_cast<char>((value >> shift) & 0xFFU));
+    }
+}
+
+void CheckpointWriter::I32(int value) { this->U32(static_cast<std::uint32_t>(value)); }
+
+void CheckpointWriter::I64(long long value) { this->U64(static_cast<std::uint64_t>(value)); }
+
+void CheckpointWriter::F32(float value) { this->U32(std::bit_cast<std::uint32_t>(value)); }
+
+void CheckpointWriter::F64(double value) { this->U64(std::bit_cast<std::uint64_t>(value)); }
+
+void CheckpointWriter::String(const std::string& value) {
+    this->U32(static_cast<std::uint32_t>(value.size()));
+    this->bytes += value;
+}
+
+void CheckpointWriter::CustomerRef(const Customer& customer) {
+    this->U32(static_cast<std::uint32_t>(customer.graphIndex));
+}
+
+void CheckpointWriter::RouteSteps(const Route& route) {
+    const RouteList& steps = *route.GetRoute();
+    this->U32(static_cast<std::uint32_t>(steps.size()));
+    for (const auto& step : steps) {
+        this->CustomerRef(step.first);
+    }
+}
+
+void CheckpointWriter::RouteSet(const Routes& routes) {
+    this->U32(static_cast<std::uint32_t>(routes.size()));
+    for (const Route& route : routes) {
+        this->RouteSteps(route);
+    }
+}
+
+/** @brief Write the checkpoint next to its destination, then rename it over the old one.
+ *
+ * A crash while writing therefore leaves the previous checkpoint intact.
+ * @param[in] path Checkpoint file
+ * @throws std::runtime_error when the file cannot be written
+ */
+void CheckpointWriter::WriteFile(const std::string& path) const {
+    const std::string partial = path + ".tmp";
+    {
+        std::ofstream output(partial, std::ios::binary | std::ios::trunc);
+        output.write(this->bytes.data(), static_cast<std::streamsize>(this->bytes.size()));
+        if (!output) {
+            throw std::runtime_error("Error writing checkpoint " + partial);
+        }
+    }
+    if (std::rename(partial.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Error replacing checkpoint " + path);
+    }
+}
+
+/** @brief Load a checkpoint file.
+ *
+ * @param[in] path Checkpoint file
+ * @param[in] g Graph of the instance the checkpoint was taken on
+ * @throws std::runtime_error when the file cannot be read
+ */
+CheckpointReader::CheckpointReader(const std::string& path, const Graph& g) : graph(&g) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Error reading checkpoint " + path);
+    }
+    this->bytes.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+const char* CheckpointReader::Take(std::size_t count) {
+    if (this->bytes.size() - this->position < count) {
+        CorruptCheckpoint("unexpected end of data");
+    }
+    const char* data = this->bytes.data() + this->position;
+    this->position += count;
+    return data;
+}
+
+std::uint32_t CheckpointReader::U32() {
+    const char* data = this->Take(4);
+    std::uint32_t value = 0;
+    for (int byte = 3; byte >= 0; --byte) {
+        value = (value << 8) | static_cast<unsigned char>(data[byte]);
+    }
+    return value;
+}
+
+std::uint64_t CheckpointReader::U64() {
+    const char* data = this->Take(8);
+    std::uint64_t value = 0;
+    for (int byte = 7; byte >= 0; --byte) {
+        value = (value << 8) | static_cast<unsigned char>(data[byte]);
+    }
+    return value;
+}
+
+int CheckpointReader::I32() { return static_cast<int>(this->U32()); }
+
+long long CheckpointReader::I64() { return static_cast<long long>(this->U64()); }
+
+float CheckpointReader::F32() { return std::bit_cast<float>(this->U32()); }
+
+double CheckpointReader::F64() { return std::bit_cast<double>(this->U64()); }
+
+std::string CheckpointReader::String() {
+    const std::uint32_t length = this->U32();
+    return {this->Take(length), length};
+}
+
+Customer CheckpointReader::CustomerRef() {
+    const std::uint32_t index = this->U32();
+    if (index >= this->graph->VertexCount()) {
+        CorruptCheckpoint("unknown vertex " + std::to_string(index));
+    }
+    return this->graph->VertexAt(index);
+}
+
+/** @brief Read a route and recompute its cost and load from the graph.
+ *
+ * @param[in] empty Route without customers, carrying capacity, work time and cost parameters
+ * @return The route in its checkpointed visit order
+ */
+Route CheckpointReader::RouteSteps(const Route& empty) {
+    const std::uint32_t count = this->U32();
+    std::list<Customer> steps;
+    for (std::uint32_t step = 0; step < count; ++step) {
+        steps.push_back(this->CustomerRef());
+    }
+    Route route = empty;
+    if (count < 2 || !route.RebuildRoute(steps)) {
+        CorruptCheckpoint("infeasible route");
+    }
+    return route;
+}
+
+Routes CheckpointReader::RouteSet(const Route& empty) {
+    const std::uint32_t count = this->U32();
+    Routes routes;
+    for (std::uint32_t route = 0; route < count; ++route) {
+        routes.push_back(this->RouteSteps(empty));
+    }
+    return routes;
+}
+
+bool CheckpointReader::AtEnd() const { return this->position == this->bytes.size(); }
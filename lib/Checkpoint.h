@@ -0,0 +1,111 @@
+#ifndef Checkpoint_H
+#define Checkpoint_H
+
+#include "Route.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** @brief Reject a checkpoint whose data is inconsistent. */
+[[noreturn]] void CorruptCheckpoint(const std::string&);
+
+/** @brief Append-only encoder for solver checkpoints.
+ *
+ * Values are written little-endian with fixed widths, so a checkpoint reads
+ * back on any host. Customers are stored by graph index and routes by their
+ * visit order, which keeps a checkpoint compact; both are resolved against
+ * the graph of the same instance when read.
+ */
+class CheckpointWriter {
+  public:
+    /** @brief Append an unsigned 32-bit value. */
+    void U32(std::uint32_t);
+
+    /** @brief Append an unsigned 64-bit value. */
+    void U64(std::uint64_t);
+
+    /** @brief Append a signed 32-bit value. */
+    void I32(int);
+
+    /** @brief Append a signed 64-bit value. */
+    void I64(long long);
+
+    /** @brief Append a single-precision value bit for bit. */
+    void F32(float);
+
+    /** @brief Append a double-precision value bit for bit. */
+    void F64(double);
+
+    /** @brief Append a length-prefixed string. */
+    void String(const std::string&);
+
+    /** @brief Append a customer as its graph index. */
+    void CustomerRef(const Customer&);
+
+    /** @brief Append the visit order of a route, depots included. */
+    void RouteSteps(const Route&);
+
+    /** @brief Append a route set. */
+    void RouteSet(const Routes&);
+
+    /** @brief Write the encoded bytes to a file, replacing it only once complete. */
+    void WriteFile(const std::string&) const;
+
+  private:
+    std::string bytes; /**< Encoded checkpoint */
+};
+
+/** @brief Decoder for checkpoints produced by CheckpointWriter.
+ *
+ * Every read throws std::runtime_error when the data ends early or refers to
+ * a vertex the graph does not have, so a truncated or foreign file is
+ * rejected instead of resuming from a corrupt state.
+ */
+class CheckpointReader {
+  public:
+    /** @brief Read a whole checkpoint file, resolving customers against a graph. */
+    CheckpointReader(const std::string&, const Graph&);
+
+    /** @brief Read an unsigned 32-bit value. */
+    std::uint32_t U32();
+
+    /** @brief Read an unsigned 64-bit value. */
+    std::uint64_t U64();
+
+    /** @brief Read a signed 32-bit value. */
+    int I32();
+
+    /** @brief Read a signed 64-bit value. */
+    long long I64();
+
+    /** @brief Read a single-precision value. */
+    float F32();
+
+    /** @brief Read a double-precision value. */
+    double F64();
+
+    /** @brief Read a length-prefixed string. */
+    std::string String();
+
+    /** @brief Read a customer stored as its graph index. */
+    Customer CustomerRef();
+
+    /** @brief Read a route, rebuilding it on a copy of an empty route with the run parameters. */
+    Route RouteSteps(const Route&);
+
+    /** @brief Read a route set. */
+    Routes RouteSet(const Route&);
+
+    /** @brief Check that every byte was consumed. */
+    [[nodiscard]] bool AtEnd() const;
+
+  private:
+    /** @brief Return the next bytes of the checkpoint and advance past them. */
+    const char* Take(std::size_t);
+
+    std::string bytes;        /**< Encoded checkpoint */
+    std::size_t position = 0; /**< Offset of the next unread byte */
+    const Graph* graph;       /**< Graph resolving customer indexes */
+};
+
+#endif /* Checkpoint_H */
@@ -0,0 +1,96 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "ExactRouteCache.h"
+#include <algorithm>
+
+/** @brief Create a sharded LRU cache.
+ *
+ * @param[in] capacity Maximum number of cached routes across all shards
+ */
+ExactRouteCache::ExactRouteCache(std::size_t capacity)
+    : shardCapacity(std::max<std::size_t>(1, capacity / ShardCount)) {}
+
+/** @brief Mix bitmask words with the splitmix64 finalizer. */
+std::size_t ExactRouteCache::KeyHash::operator()(const CustomerSetKey& key) const {
+    std::uint64_t hash = 0x9E3779B97F4A7C15ULL;
+    for (const std::uint64_t word : key) {
+        hash ^= word + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+        hash ^= hash >> 31;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+/** @brief Return the shard responsible for a key. */
+ExactRouteCache::Shard& ExactRouteCache::ShardOf(const CustomerSetKey& key) {
+    return this->shards[KeyHash{}(key) % ShardCount];
+}
+
+/** @brief Look up the exact route of a customer set.
+ *
+ * A hit moves the entry to the front of its shard so frequently revisited
+ * memberships survive eviction.
+ * @param[in] key Customer-set bitmask
+ * @return The cached route, or std::nullopt on a miss
+ */
+std::optional<ExactRoute> ExactRouteCache::Find(const CustomerSetKey& key) {
+    Shard& shard = this->ShardOf(key);
+    std::scoped_lock lock(shard.mutex);
+    const auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+        return std::nullopt;
+    }
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    return found->second->second;
+}
+
+/** @brief Store the exact route of a customer set.
+ *
+ * Callers may publish routes that are only known to be good rather than
+ * optimal, so an existing entry is replaced only by a strictly cheaper route.
+ * @param[in] key Customer-set bitmask
+ * @param[in] route Route cost and visit order
+ */
+void ExactRouteCache::Insert(const CustomerSetKey& key, ExactRoute route) {
+    Shard& shard = this->ShardOf(key);
+    std::scoped_lock lock(shard.mutex);
+    const auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        if (route.cost < found->second->second.cost) {
+            found->second->second = std::move(route);
+        }
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return;
+    }
+    shard.entries.emplace_front(key, std::move(route));
+    shard.index.emplace(key, shard.entries.begin());
+    if (shard.entries.size() > this->shardCapacity) {
+        shard.index.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+    }
+}
+
+/** @brief Remove every cached route. */
+void ExactRouteCache::Clear() {
+    for (Shard& shard : this->shards) {
+        std::scoped_lock lock(shard.mutex);
+        shard.entries.clear();
+        shard.index.clear();
+    }
+}
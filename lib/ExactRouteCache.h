@@ -0,0 +1,69 @@
+#ifndef ExactRouteCache_H
+#define ExactRouteCache_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/** @brief Customer-set bitmask over graph indexes; bit i is set when customer i is a member. */
+using CustomerSetKey = std::vector<std::uint64_t>;
+
+/** @brief Optimal closed route over one customer set, stored as graph indexes. */
+struct ExactRoute {
+    int cost = 0;                     /**< Depot-to-depot cost of the optimal order */
+    std::vector<std::uint32_t> order; /**< Customer graph indexes in visit order, depot excluded */
+};
+
+/** @brief Concurrent bounded LRU cache of exact route orders keyed by customer set.
+ *
+ * Exact TSP solutions depend only on route membership, yet the same
+ * memberships come back across VND rounds, tabu passes, savings restarts, and
+ * archive recombination. The cache is split into independently locked shards
+ * chosen by key hash, so parallel neighborhood workers rarely contend; each
+ * shard evicts its least recently used entry once full.
+ */
+class ExactRouteCache {
+  public:
+    /** @brief Create a cache holding at most the given number of entries. */
+    explicit ExactRouteCache(std::size_t);
+
+    /** @brief Return the cached route for a customer set and mark it recently used. */
+    std::optional<ExactRoute> Find(const CustomerSetKey&);
+
+    /** @brief Insert or refresh a route; a cheaper route replaces a costlier one. */
+    void Insert(const CustomerSetKey&, ExactRoute);
+
+    /** @brief Drop every entry, e.g. after the graph costs change. */
+    void Clear();
+
+  private:
+    static constexpr std::size_t ShardCount = 16;
+
+    /** @brief Hash a customer-set bitmask word by word. */
+    struct KeyHash {
+        std::size_t operator()(const CustomerSetKey&) const;
+    };
+
+    using Entry = std::pair<CustomerSetKey, ExactRoute>;
+
+    /** @brief One independently locked LRU list and its lookup index. */
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> entries; /**< Most recently used entry first */
+        std::unordered_map<CustomerSetKey, std::list<Entry>::iterator, KeyHash> index;
+    };
+
+    /** @brief Return the shard responsible for a key. */
+    Shard& ShardOf(const CustomerSetKey&);
+
+    std::size_t shardCapacity;            /**< Maximum entries per shard */
+    std::array<Shard, ShardCount> shards; /**< Hash-partitioned cache shards */
+};
+
+#endif /* ExactRouteCache_H */
@@ -20,6 +20,9 @@
 #include <stdexcept>
 
 namespace {
+constexpr std::uint64_t kFnvOffsetBasis = 0xCBF29CE484222325ULL;
+constexpr std::uint64_t kFnvPrime = 0x100000001B3ULL;
+
 /** @brief Deterministic ordering for equal-cost neighbor entries. */
 bool CustomerCostLess(const std::pair<int, Customer>& left, const std::pair<int, Customer>& right) {
     if (left.first != right.first) {
@@ -41,10 +44,11 @@ void Graph::InsertVertex(Customer& cust) {
     const std::size_t oldSize = this->customers.size();
     cust.graphIndex = oldSize;
     this->customers.push_back(cust);
+    this->retired.push_back(false);
     this->vertexIndex.emplace(cust, oldSize);
-    this->ResizeCostMatrix(oldSize, oldSize + 1);
-    this->costMatrix[oldSize * (oldSize + 1) + oldSize] = 0;
-    this->InvalidateNeighborhoods();
+    this->ResizeCostMatrix(oldSize + 1);
+    this->CostCell(oldSize, oldSize) = 0;
+    this->InvalidateCaches();
 }
 
 /** @brief Insert an edge.
@@ -58,9 +62,146 @@ void Graph::InsertEdge(Customer& node, Customer& new_edge, int weight) {
     if (node.name != new_edge.name && this->vertexIndex.contains(node) && this->vertexIndex.contains(new_edge)) {
         const std::size_t fromIndex = this->IndexOf(node);
         const std::size_t toIndex = this->IndexOf(new_edge);
-        this->costMatrix[fromIndex * this->customers.size() + toIndex] = weight;
-        this->InvalidateNeighborhoods();
+        this->CostCell(fromIndex, toIndex) = weight;
+        this->InvalidateCaches();
+    }
+}
+
+/** @brief Add a vertex to a graph that is already being searched.
+ *
+ * Unlike InsertVertex, no cache is dropped: the new vertex gets a fresh
+ * index, so cached exact routes over older indexes stay valid, and when the
+ * neighborhoods are built it is merged into each sorted list in place. The
+ * exact-route cache is detached first if graph copies share it, since they
+ * may give the same index to another vertex. A customer that was removed
+ * may be added again, with new arcs: it gets a fresh index as well and its
+ * name resolves there from then on.
+ * @param[in,out] cust The new customer; receives its graph index
+ * @param[in] arcs Arc costs to and from every active vertex, by vertex name
+ * @throws std::runtime_error when an active vertex has the name or an arc is missing or negative
+ */
+void Graph::AppendVertex(Customer& cust, const std::map<std::string, VertexArcs>& arcs) {
+    if (cust.name.empty() || this->HasActiveVertex(cust.name)) {
+        throw std::runtime_error("Vertex " + cust.name + " already exists");
+    }
+    const std::size_t index = this->customers.size();
+    std::vector<VertexArcs> costs(index);
+    for (std::size_t other = 0; other < index; ++other) {
+        if (this->retired[other]) {
+            continue;
+        }
+        const auto found = arcs.find(this->customers[other].name);
+        if (found == arcs.end() || found->second.toVertex < 0 || found->second.fromVertex < 0) {
+            throw std::runtime_error("Missing travel cost between " + cust.name + " and " +
+                                     this->customers[other].name);
+        }
+        costs[other] = found->second;
+    }
+    if (this->exactRoutes.use_count() > 1) {
+        this->exactRoutes = std::make_shared<ExactRouteCache>(ExactRouteCacheEntries);
+    }
+    cust.graphIndex = index;
+    this->customers.push_back(cust);
+    this->retired.push_back(false);
+    // a customer removed earlier comes back on the new index; its retired one is never reused
+    this->vertexIndex.erase(cust);
+    this->vertexIndex.emplace(cust, index);
+    this->ResizeCostMatrix(index + 1);
+    this->CostCell(index, index) = 0;
+    for (std::size_t other = 0; other < index; ++other) {
+        if (!this->retired[other]) {
+            this->CostCell(index, other) = costs[other].toVertex;
+            this->CostCell(other, index) = costs[other].fromVertex;
+        }
+    }
+    if (this->neighborhoodsDirty) {
+        return;
+    }
+    std::scoped_lock lock(*this->neighborhoodsMutex);
+    const Customer& depot = this->customers.front();
+    CostNeighborhood neighborhood;
+    for (std::size_t other = 0; other < index; ++other) {
+        if (this->retired[other]) {
+            continue;
+        }
+        const std::pair<int, Customer> entry(this->CostCell(other, index), cust);
+        CostNeighborhood& list = this->neighborhoods[other];
+        list.insert(std::ranges::upper_bound(list, entry, CustomerCostLess), entry);
+        if (this->customers[other] != depot) {
+            neighborhood.emplace_back(this->CostCell(index, other), this->customers[other]);
+        }
+    }
+    std::ranges::sort(neighborhood, CustomerCostLess);
+    this->neighborhoods.push_back(std::move(neighborhood));
+}
+
+/** @brief Retire a customer vertex.
+ *
+ * The vertex keeps its index and matrix cells, so routes and cached data that
+ * still name it stay readable until they are patched; it only disappears
+ * from the neighborhoods and the depot ordering.
+ * @param[in] cust The customer to retire
+ * @throws std::runtime_error for the depot or an unknown or retired vertex
+ */
+void Graph::RemoveVertex(const Customer& cust) {
+    if (!this->HasActiveVertex(cust.name) || cust == this->customers.front()) {
+        throw std::runtime_error("Vertex " + cust.name + " cannot be removed");
     }
+    const std::size_t index = this->IndexOf(cust);
+    this->retired[index] = true;
+    if (this->neighborhoodsDirty) {
+        return;
+    }
+    std::scoped_lock lock(*this->neighborhoodsMutex);
+    for (CostNeighborhood& list : this->neighborhoods) {
+        std::erase_if(list, [&cust](const std::pair<int, Customer>& entry) { return entry.second == cust; });
+    }
+    this->neighborhoods[index].clear();
+}
+
+/** @brief Return true when a vertex of that name exists and is not retired. */
+bool Graph::HasActiveVertex(const std::string& name) const {
+    const auto found = this->vertexIndex.find(Customer(name, 0, 0));
+    return found != this->vertexIndex.cend() && !this->retired[found->second];
+}
+
+/** @brief Return the number of vertex indexes in use, retired ones included. */
+std::size_t Graph::VertexCount() const { return this->customers.size(); }
+
+/** @brief Return the customer stored at a graph index.
+ *
+ * @param[in] index Graph index, below VertexCount()
+ */
+const Customer& Graph::VertexAt(std::size_t index) const { return this->customers.at(index); }
+
+/** @brief Hash every vertex with its demand, service time and state, and every arc cost.
+ *
+ * Used to refuse resuming a checkpoint on a different instance; FNV-1a is
+ * enough since the hash guards against mistakes, not adversaries.
+ * @return 64-bit FNV-1a hash of the graph
+ */
+std::uint64_t Graph::Fingerprint() const {
+    std::uint64_t hash = kFnvOffsetBasis;
+    auto mix = [&hash](std::uint64_t value) {
+        for (int byte = 0; byte < 8; ++byte) {
+            hash = (hash ^ ((value >> (byte * 8)) & 0xFFU)) * kFnvPrime;
+        }
+    };
+    const std::size_t count = this->customers.size();
+    mix(count);
+    for (std::size_t from = 0; from < count; ++from) {
+        const Customer& customer = this->customers[from];
+        for (const char c : customer.name) {
+            mix(static_cast<unsigned char>(c));
+        }
+        mix(static_cast<std::uint64_t>(customer.request));
+        mix(static_cast<std::uint64_t>(customer.serviceTime));
+        mix(this->retired[from] ? 1 : 0);
+        for (std::size_t to = 0; to < count; ++to) {
+            mix(static_cast<std::uint64_t>(this->CostCell(from, to)));
+        }
+    }
+    return hash;
 }
 
 /** @brief Sort the customers by distance from the depot.
@@ -80,10 +221,10 @@ std::multimap<int, Customer> Graph::sortV0() {
     v.emplace(std::pair<int, Customer>(0, c));
     const std::size_t depotIndex = this->IndexOf(c);
     for (std::size_t index = 0; index < this->customers.size(); ++index) {
-        if (index == depotIndex) {
+        if (index == depotIndex || this->retired[index]) {
             continue;
         }
-        const int cost = this->costMatrix[depotIndex * this->customers.size() + index];
+        const int cost = this->CostCell(depotIndex, index);
         if (cost != MissingCost) {
             v.emplace(std::pair<int, Customer>(cost, this->customers[index]));
         }
@@ -113,37 +254,102 @@ std::pair<Customer, int> Graph::GetCosts(const Customer& from, const Customer& t
 
 /** @brief Return the O(1) matrix travel cost between two customers. */
 int Graph::GetCost(const Customer& from, const Customer& to) const {
-    const std::size_t size = this->customers.size();
-    const int cost = this->costMatrix[this->IndexOf(from) * size + this->IndexOf(to)];
+    const int cost = this->CostCell(this->IndexOf(from), this->IndexOf(to));
     if (cost == MissingCost) {
         throw std::runtime_error("Missing travel cost from " + from.name + " to " + to.name);
     }
     return cost;
 }
 
-/** @brief Resize the row-major matrix without losing existing costs. */
-void Graph::ResizeCostMatrix(std::size_t oldSize, std::size_t newSize) {
-    std::vector<int> resized(newSize * newSize, MissingCost);
-    for (std::size_t row = 0; row < oldSize; ++row) {
-        for (std::size_t col = 0; col < oldSize; ++col) {
-            resized[row * newSize + col] = this->costMatrix[row * oldSize + col];
-        }
+/** @brief Make room for a vertex count without losing existing costs.
+ *
+ * Rows are allocated with spare columns and the stride grows by half each
+ * time it is exceeded, so adding vertices one by one, while parsing or on a
+ * live instance, copies the matrix a logarithmic number of times.
+ * @param[in] size Number of vertices the matrix must hold
+ */
+void Graph::ResizeCostMatrix(std::size_t size) {
+    if (size <= this->matrixStride) {
+        return;
+    }
+    const std::size_t stride = std::max(size, this->matrixStride + (this->matrixStride / 2));
+    std::vector<int> resized(stride * stride, MissingCost);
+    for (std::size_t row = 0; row < this->matrixStride; ++row) {
+        std::copy_n(this->costMatrix.cbegin() + static_cast<std::ptrdiff_t>(row * this->matrixStride),
+                    this->matrixStride, resized.begin() + static_cast<std::ptrdiff_t>(row * stride));
     }
     this->costMatrix = std::move(resized);
+    this->matrixStride = stride;
+}
+
+/** @brief Return the matrix cell of the arc between two vertex indexes. */
+int& Graph::CostCell(std::size_t from, std::size_t to) { return this->costMatrix[(from * this->matrixStride) + to]; }
+int Graph::CostCell(std::size_t from, std::size_t to) const {
+    return this->costMatrix[(from * this->matrixStride) + to];
 }
 
-/** @brief Return a customer's compact matrix index. */
+/** @brief Return a customer's compact matrix index.
+ *
+ * A copy carrying the retired index of a customer that was added again is
+ * resolved by name, so it reaches the current arcs.
+ */
 std::size_t Graph::IndexOf(const Customer& customer) const {
-    if (customer.graphIndex < this->customers.size() && this->customers[customer.graphIndex].name == customer.name) {
+    if (customer.graphIndex < this->customers.size() && !this->retired[customer.graphIndex] &&
+        this->customers[customer.graphIndex].name == customer.name) {
         return customer.graphIndex;
     }
     return this->vertexIndex.at(customer);
 }
 
-/** @brief Mark cached neighborhoods stale after graph mutation. */
-void Graph::InvalidateNeighborhoods() {
+/** @brief Mark cached neighborhoods and exact routes stale after graph mutation. */
+void Graph::InvalidateCaches() {
     this->neighborhoodsDirty = true;
     this->neighborhoods.clear();
+    this->exactRoutes->Clear();
+}
+
+/** @brief Return the customer-set bitmask of a route membership over graph indexes. */
+CustomerSetKey Graph::CustomerSetOf(const std::vector<Customer>& members) const {
+    CustomerSetKey key((this->customers.size() + 63) / 64, 0);
+    for (const Customer& customer : members) {
+        const std::size_t index = this->IndexOf(customer);
+        key[index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+    return key;
+}
+
+/** @brief Look up the best known closed route over a customer set.
+ *
+ * Entries are keyed by membership only, so the lookup succeeds whatever order
+ * the members are given in.
+ * @param[in] members Customers served by the route, depot excluded
+ * @return The cached cost and visit order, or std::nullopt on a miss
+ */
+std::optional<std::pair<int, std::vector<Customer>>> Graph::FindExactRoute(const std::vector<Customer>& members) const {
+    std::optional<ExactRoute> cached = this->exactRoutes->Find(this->CustomerSetOf(members));
+    if (!cached.has_value()) {
+        return std::nullopt;
+    }
+    std::vector<Customer> order;
+    order.reserve(cached->order.size());
+    for (const std::uint32_t index : cached->order) {
+        order.push_back(this->customers[index]);
+    }
+    return std::make_pair(cached->cost, std::move(order));
+}
+
+/** @brief Publish a closed route over its customer set.
+ *
+ * @param[in] order Customers in visit order, depot excluded
+ * @param[in] cost Depot-to-depot cost of the order
+ */
+void Graph::StoreExactRoute(const std::vector<Customer>& order, int cost) const {
+    ExactRoute route{.cost = cost, .order = {}};
+    route.order.reserve(order.size());
+    for (const Customer& customer : order) {
+        route.order.push_back(static_cast<std::uint32_t>(this->IndexOf(customer)));
+    }
+    this->exactRoutes->Insert(this->CustomerSetOf(order), std::move(route));
 }
 
 /** @brief Rebuild all sorted neighborhoods from the compact matrix. */
@@ -164,11 +370,14 @@ void Graph::RebuildNeighborhoods() const {
     const Customer& depot = this->customers.front();
     const std::size_t size = this->customers.size();
     for (std::size_t from = 0; from < size; ++from) {
+        if (this->retired[from]) {
+            continue;
+        }
         CostNeighborhood& neighborhood = this->neighborhoods[from];
         neighborhood.reserve(size > 0 ? size - 1 : 0);
         for (std::size_t to = 0; to < size; ++to) {
-            const int cost = this->costMatrix[from * size + to];
-            if (from != to && cost != MissingCost && this->customers[to] != depot) {
+            const int cost = this->CostCell(from, to);
+            if (from != to && cost != MissingCost && !this->retired[to] && this->customers[to] != depot) {
                 neighborhood.emplace_back(cost, this->customers[to]);
             }
         }
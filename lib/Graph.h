@@ -2,15 +2,25 @@
 #define Graph_H
 
 #include "../actor/Customer.h"
+#include "ExactRouteCache.h"
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
 using CostNeighborhood = std::vector<std::pair<int, Customer>>;
 
+/** @brief Travel costs between a vertex being added and one vertex of the graph. */
+struct VertexArcs {
+    int toVertex = 0;   /**< Cost from the new vertex to the existing one */
+    int fromVertex = 0; /**< Cost from the existing vertex to the new one */
+};
+
 /** @brief Complete directed cost graph over customers.
  *
  * The graph stores customers and a compact directed cost matrix used by route
@@ -26,6 +36,24 @@ class Graph {
     /** @brief Insert or update a weighted edge between two customers. */
     void InsertEdge(Customer&, Customer&, int);
 
+    /** @brief Add a vertex with its arcs to every active vertex, keeping the caches current. */
+    void AppendVertex(Customer&, const std::map<std::string, VertexArcs>&);
+
+    /** @brief Retire a customer vertex, dropping it from neighborhoods while keeping indexes stable. */
+    void RemoveVertex(const Customer&);
+
+    /** @brief Check whether a vertex of that name is part of the graph and not retired. */
+    [[nodiscard]] bool HasActiveVertex(const std::string&) const;
+
+    /** @brief Return the number of vertex indexes in use, retired ones included. */
+    [[nodiscard]] std::size_t VertexCount() const;
+
+    /** @brief Return the customer stored at a graph index. */
+    [[nodiscard]] const Customer& VertexAt(std::size_t) const;
+
+    /** @brief Return a hash of the vertices and arc costs, identifying the instance. */
+    [[nodiscard]] std::uint64_t Fingerprint() const;
+
     /** @brief Return depot-sorted customers by edge cost; duplicate costs are preserved. */
     std::multimap<int, Customer> sortV0();
 
@@ -41,17 +69,31 @@ class Graph {
     /** @brief Return the matrix travel cost for an edge lookup. */
     int GetCost(const Customer&, const Customer&) const;
 
+    /** @brief Return the cached optimal cost and visit order for a customer set, if known. */
+    std::optional<std::pair<int, std::vector<Customer>>> FindExactRoute(const std::vector<Customer>&) const;
+
+    /** @brief Publish the cost and visit order of a closed route over its customer set. */
+    void StoreExactRoute(const std::vector<Customer>&, int) const;
+
   private:
     static constexpr int MissingCost = std::numeric_limits<int>::max() / 4;
+    static constexpr std::size_t ExactRouteCacheEntries = std::size_t{1} << 16;
+
+    /** @brief Make room for a vertex count, growing the row stride geometrically. */
+    void ResizeCostMatrix(std::size_t);
 
-    /** @brief Resize the square cost matrix while preserving existing costs. */
-    void ResizeCostMatrix(std::size_t, std::size_t);
+    /** @brief Return the matrix cell of an arc between two vertex indexes. */
+    int& CostCell(std::size_t, std::size_t);
+    [[nodiscard]] int CostCell(std::size_t, std::size_t) const;
 
     /** @brief Return a customer's compact matrix index. */
     std::size_t IndexOf(const Customer&) const;
 
-    /** @brief Mark cached neighborhoods stale after graph mutation. */
-    void InvalidateNeighborhoods();
+    /** @brief Mark cached neighborhoods and exact routes stale after graph mutation. */
+    void InvalidateCaches();
+
+    /** @brief Return the customer-set bitmask of a route membership. */
+    CustomerSetKey CustomerSetOf(const std::vector<Customer>&) const;
 
     /** @brief Rebuild sorted neighborhoods from the compact cost matrix. */
     void RebuildNeighborhoods() const;
@@ -59,10 +101,14 @@ class Graph {
     std::map<Customer, std::size_t> vertexIndex;         /**< Stable compact index for each customer */
     std::vector<Customer> customers;                     /**< Customers in insertion order, depot first */
     std::vector<int> costMatrix;                         /**< Dense row-major travel-cost matrix */
+    std::size_t matrixStride = 0;                        /**< Allocated row length, at least the vertex count */
+    std::vector<bool> retired;                           /**< Vertices removed from the instance, by index */
     mutable std::vector<CostNeighborhood> neighborhoods; /**< Cached sorted neighborhoods */
     mutable bool neighborhoodsDirty = true;              /**< True when neighborhoods must be rebuilt */
     mutable std::shared_ptr<std::mutex> neighborhoodsMutex =
         std::make_shared<std::mutex>(); /**< Protects lazy cache rebuilds */
+    std::shared_ptr<ExactRouteCache> exactRoutes =
+        std::make_shared<ExactRouteCache>(ExactRouteCacheEntries); /**< Exact orders shared by graph copies */
 };
 
 #endif /* Graph_H */
@@ -0,0 +1,306 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "HeldKarp.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+namespace {
+// Rows are padded to whole 256-bit vectors of int so the reduction loop needs
+// no scalar remainder and every row starts on a vector boundary.
+constexpr std::size_t kSimdInts = 8;
+
+/** @brief Return the cheapest path cost into one customer from a predecessor row.
+ *
+ * Entries outside the predecessor subset are Infinity in the row and padded
+ * entries are zero in the arc column, so the loop has no data-dependent branch.
+ */
+int MinRelaxation(const int* __restrict row, const int* __restrict arcs, std::size_t stride) {
+    int best = HeldKarp::Infinity;
+    for (std::size_t previous = 0; previous < stride; ++previous) {
+        best = std::min(best, row[previous] + arcs[previous]);
+    }
+    return best;
+}
+
+/** @brief Idle kernels kept for reuse by HeldKarpLease. */
+struct KernelFreeList {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<HeldKarp>> kernels;
+};
+
+/** @brief Return the process-wide kernel free list. */
+KernelFreeList& IdleKernels() {
+    static KernelFreeList idle;
+    return idle;
+}
+} // namespace
+
+/** @brief Solve the Held-Karp table over a local customer set.
+ *
+ * Subsets are processed in increasing mask order, which always finishes a
+ * subset before any of its supersets. For each subset only the set bits are
+ * expanded as possible last customers; the predecessor scan is a pull-style
+ * min reduction over the row of the subset without that customer. Subsets whose
+ * demand exceeds the capacity limit are skipped, and since demands are
+ * non-negative none of their supersets can become feasible again.
+ * @param[in] reference Route providing graph cost lookups
+ * @param[in] start The depot
+ * @param[in] localCustomers Customers addressed by bit position
+ * @param[in] capacityLimit Maximum demand of a solved subset
+ * @param[in] workers Number of threads allowed to fill large tables
+ * @return True when the table was built
+ */
+bool HeldKarp::Solve(const Route& reference, const Customer& start, const std::vector<Customer>& localCustomers,
+                     int capacityLimit, unsigned workers) {
+    if (localCustomers.empty() || localCustomers.size() > MaxCustomers) {
+        this->count = 0;
+        return false;
+    }
+    this->depot = start;
+    this->customers = localCustomers;
+    this->count = localCustomers.size();
+    this->stride = (this->count + kSimdInts - 1) / kSimdInts * kSimdInts;
+    const std::size_t stateCount = std::size_t{1} << this->count;
+
+    // Copy the local cost submatrix once so the hot loop never touches the graph.
+    this->arcInto.assign(this->count * this->stride, 0);
+    this->toDepot.assign(this->stride, 0);
+    for (std::size_t to = 0; to < this->count; ++to) {
+        for (std::size_t from = 0; from < this->count; ++from) {
+            if (from != to) {
+                this->arcInto[(to * this->stride) + from] =
+                    reference.GetTravelCost(this->customers[from], this->customers[to]);
+            }
+        }
+        this->toDepot[to] = reference.GetTravelCost(this->customers[to], this->depot);
+    }
+
+    this->demand.assign(stateCount, 0);
+    for (std::size_t mask = 1; mask < stateCount; ++mask) {
+        const std::size_t lowest = static_cast<std::size_t>(std::countr_zero(mask));
+        this->demand[mask] = this->demand[mask & (mask - 1)] + this->customers[lowest].request;
+    }
+
+    this->path.assign(stateCount * this->stride, Infinity);
+    this->routeCost.assign(stateCount, Infinity);
+    for (std::size_t customer = 0; customer < this->count; ++customer) {
+        const std::size_t mask = std::size_t{1} << customer;
+        if (this->demand[mask] <= capacityLimit) {
+            this->path[(mask * this->stride) + customer] =
+                reference.GetTravelCost(this->depot, this->customers[customer]);
+        }
+    }
+    if (workers > 1 && this->count >= ParallelMinCustomers) {
+        this->SolveLayers(capacityLimit, workers);
+        return true;
+    }
+    for (std::size_t mask = 1; mask < stateCount; ++mask) {
+        this->SolveMask(mask, capacityLimit);
+    }
+    return true;
+}
+
+/** @brief Fill the table entries of one subset.
+ *
+ * Only reads rows of subsets with one customer fewer, so any order that
+ * finishes those first, ascending masks or popcount layers, is valid.
+ * @param[in] mask Subset to solve
+ * @param[in] capacityLimit Maximum demand of a solved subset
+ */
+void HeldKarp::SolveMask(std::size_t mask, int capacityLimit) {
+    if (this->demand[mask] > capacityLimit) {
+        return;
+    }
+    int* row = &this->path[mask * this->stride];
+    if (std::has_single_bit(mask)) {
+        const std::size_t customer = static_cast<std::size_t>(std::countr_zero(mask));
+        this->routeCost[mask] = row[customer] + this->toDepot[customer];
+        return;
+    }
+    for (std::size_t bits = mask; bits != 0; bits &= bits - 1) {
+        const std::size_t last = static_cast<std::size_t>(std::countr_zero(bits));
+        const std::size_t previousMask = mask ^ (std::size_t{1} << last);
+        const int best = MinRelaxation(&this->path[previousMask * this->stride], &this->arcInto[last * this->stride],
+                                       this->stride);
+        row[last] = std::min(best, Infinity);
+    }
+    // Padded and non-member slots are Infinity, so the closing scan is branch-free too.
+    const int closed = MinRelaxation(row, this->toDepot.data(), this->stride);
+    this->routeCost[mask] = std::min(closed, Infinity);
+}
+
+/** @brief Fill the table one popcount layer at a time.
+ *
+ * Subsets are counting-sorted by popcount into a reusable buffer. Within a
+ * layer no subset reads another, so the layer is cut into one contiguous
+ * chunk per worker and all chunks finish before the next layer starts.
+ * @param[in] capacityLimit Maximum demand of a solved subset
+ * @param[in] workers Number of threads filling each layer
+ */
+void HeldKarp::SolveLayers(int capacityLimit, unsigned workers) {
+    const std::size_t stateCount = std::size_t{1} << this->count;
+    std::vector<std::size_t> layerStart(this->count + 2, 0);
+    for (std::size_t mask = 1; mask < stateCount; ++mask) {
+        ++layerStart[static_cast<std::size_t>(std::popcount(mask)) + 1];
+    }
+    for (std::size_t layer = 1; layer < layerStart.size(); ++layer) {
+        layerStart[layer] += layerStart[layer - 1];
+    }
+    this->layerMasks.resize(stateCount);
+    std::vector<std::size_t> next(layerStart.cbegin(), layerStart.cend() - 1);
+    for (std::size_t mask = 1; mask < stateCount; ++mask) {
+        this->layerMasks[next[static_cast<std::size_t>(std::popcount(mask))]++] = static_cast<std::uint32_t>(mask);
+    }
+    // One pool serves every layer; threads wait between layers instead of being respawned.
+    ThreadPool pool(workers);
+    for (std::size_t layer = 1; layer <= this->count; ++layer) {
+        const std::size_t begin = layerStart[layer];
+        const std::size_t end = layerStart[layer + 1];
+        const std::size_t chunkSize = std::max<std::size_t>(1, (end - begin + workers - 1) / workers);
+        if (end - begin <= chunkSize) {
+            for (std::size_t position = begin; position < end; ++position) {
+                this->SolveMask(this->layerMasks[position], capacityLimit);
+            }
+            continue;
+        }
+        for (std::size_t chunkStart = begin; chunkStart < end; chunkStart += chunkSize) {
+            const std::size_t chunkEnd = std::min(end, chunkStart + chunkSize);
+            pool.AddTask([this, chunkStart, chunkEnd, capacityLimit]() {
+                for (std::size_t position = chunkStart; position < chunkEnd; ++position) {
+                    this->SolveMask(this->layerMasks[position], capacityLimit);
+                }
+            });
+        }
+        pool.WaitIdle();
+    }
+}
+
+/** @brief Release the tables when they are larger than a customer count needs.
+ *
+ * @param[in] retainedCustomers Largest customer set whose tables are kept
+ */
+void HeldKarp::ReleaseLargeTables(std::size_t retainedCustomers) {
+    const std::size_t retainedStates = std::size_t{1} << retainedCustomers;
+    if (this->routeCost.capacity() <= retainedStates) {
+        return;
+    }
+    AlignedVector<int>().swap(this->path);
+    std::vector<int>().swap(this->demand);
+    std::vector<int>().swap(this->routeCost);
+    std::vector<std::uint32_t>().swap(this->layerMasks);
+    this->count = 0;
+}
+
+/** @brief Return the optimal closed route cost of one subset. */
+int HeldKarp::RouteCost(std::size_t mask) const { return this->routeCost[mask]; }
+
+/** @brief Return the summed demand of one subset. */
+int HeldKarp::Demand(std::size_t mask) const { return this->demand[mask]; }
+
+/** @brief Return the number of customers of the last solved set. */
+std::size_t HeldKarp::CustomerCount() const { return this->count; }
+
+/** @brief Return the last customer of an optimal closed route over the subset. */
+int HeldKarp::ClosingCustomer(std::size_t mask) const {
+    const int target = this->routeCost[mask];
+    if (target >= Infinity) {
+        return -1;
+    }
+    for (std::size_t bits = mask; bits != 0; bits &= bits - 1) {
+        const std::size_t last = static_cast<std::size_t>(std::countr_zero(bits));
+        if (this->path[(mask * this->stride) + last] + this->toDepot[last] == target) {
+            return static_cast<int>(last);
+        }
+    }
+    return -1;
+}
+
+/** @brief Rebuild an optimal route over a subset.
+ *
+ * Walks the recurrence backwards: at each step the predecessor is any member
+ * whose stored path cost plus the connecting arc reproduces the current entry.
+ * The walk is quadratic in the subset size, negligible next to the table.
+ * @param[in] mask Subset of local customers to route
+ * @return Depot-to-depot customer list, or an empty list when infeasible
+ */
+std::list<Customer> HeldKarp::BuildRoute(std::size_t mask) const {
+    int current = this->ClosingCustomer(mask);
+    if (current < 0) {
+        return {};
+    }
+    std::vector<Customer> ordered;
+    ordered.reserve(static_cast<std::size_t>(std::popcount(mask)));
+    while (current >= 0) {
+        const std::size_t last = static_cast<std::size_t>(current);
+        ordered.push_back(this->customers[last]);
+        const int target = this->path[(mask * this->stride) + last];
+        mask ^= std::size_t{1} << last;
+        current = -1;
+        for (std::size_t bits = mask; bits != 0; bits &= bits - 1) {
+            const std::size_t previous = static_cast<std::size_t>(std::countr_zero(bits));
+            if (this->path[(mask * this->stride) + previous] + this->arcInto[(last * this->stride) + previous] ==
+                target) {
+                current = static_cast<int>(previous);
+                break;
+            }
+        }
+    }
+    if (mask != 0) {
+        return {};
+    }
+    std::ranges::reverse(ordered);
+    std::list<Customer> route;
+    route.push_back(this->depot);
+    std::ranges::copy(ordered, std::back_inserter(route));
+    route.push_back(this->depot);
+    return route;
+}
+
+/** @brief Borrow an idle kernel from the free list. */
+HeldKarpLease::HeldKarpLease() {
+    KernelFreeList& idle = IdleKernels();
+    {
+        std::scoped_lock lock(idle.mutex);
+        if (!idle.kernels.empty()) {
+            this->kernel = std::move(idle.kernels.back());
+            idle.kernels.pop_back();
+        }
+    }
+    if (!this->kernel) {
+        this->kernel = std::make_unique<HeldKarp>();
+    }
+}
+
+/** @brief Return the kernel, dropping it when enough idle kernels are kept.
+ *
+ * Tables above RetainedCustomers are released first, so an idle kernel holds a
+ * few megabytes at most however large its last table was.
+ */
+HeldKarpLease::~HeldKarpLease() {
+    this->kernel->ReleaseLargeTables(HeldKarp::RetainedCustomers);
+    KernelFreeList& idle = IdleKernels();
+    const std::size_t retained = std::max(1U, std::thread::hardware_concurrency());
+    std::scoped_lock lock(idle.mutex);
+    if (idle.kernels.size() < retained) {
+        idle.kernels.push_back(std::move(this->kernel));
+    }
+}
@@ -0,0 +1,147 @@
+#ifndef HeldKarp_H
+#define HeldKarp_H
+
+#include "Route.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory>
+#include <new>
+#include <vector>
+
+/** @brief Minimal over-aligned allocator for SIMD-friendly dynamic-program tables. */
+template <typename T, std::size_t Alignment> struct AlignedAllocator {
+    using value_type = T;
+
+    /** @brief Rebind the allocator to another element type with the same alignment. */
+    template <typename U> struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    /** @brief Convert from an allocator of another element type. */
+    template <typename U> explicit AlignedAllocator(const AlignedAllocator<U, Alignment>& /*unused*/) {}
+
+    /** @brief Allocate storage for count elements on an Alignment-byte boundary. */
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    /** @brief Release storage obtained from allocate. */
+    void deallocate(T* pointer, std::size_t /*count*/) { ::operator delete(pointer, std::align_val_t{Alignment}); }
+
+    /** @brief All instances share the global heap, so any two compare equal. */
+    template <typename U> bool operator==(const AlignedAllocator<U, Alignment>& /*unused*/) const { return true; }
+};
+
+/** @brief Exact Held-Karp kernel over every subset of a small customer set.
+ *
+ * Solve copies the local depot/customer cost submatrix once, then fills a flat
+ * mask-major table of the cheapest depot-rooted path for each customer subset
+ * and final customer. Rows are padded to a SIMD-friendly stride and non-member
+ * slots stay at Infinity, so every relaxation is a branch-free min reduction
+ * over one row that the compiler can vectorize. Parent pointers are not stored:
+ * routes are recovered by replaying the recurrence, halving the table size.
+ *
+ * Large tables can be filled in parallel: subsets are grouped by popcount and
+ * every subset of one layer only reads the previous layer, so each layer is
+ * split across workers with a join between layers.
+ *
+ * An instance owns its buffers and reuses them across Solve calls. It is not
+ * thread-safe; each worker must use its own instance, usually borrowed through
+ * HeldKarpLease so the grown buffers survive between neighborhood calls.
+ */
+class HeldKarp {
+  public:
+    static constexpr int Infinity = std::numeric_limits<int>::max() / 4;
+    /** @brief Largest customer set solved; the path table of 18 customers is already about 25 MB. */
+    static constexpr std::size_t MaxCustomers = 18;
+    static constexpr std::size_t ParallelMinCustomers = 14;
+    /** @brief Largest route ordered exactly by route TSP; longer routes get the neighbour-list local search. */
+    static constexpr int ExactRouteCustomers = static_cast<int>(MaxCustomers);
+    /** @brief Largest customer set whose tables an idle kernel keeps, about 5 MB. */
+    static constexpr std::size_t RetainedCustomers = 16;
+
+    /** @brief Solve paths for all subsets whose total demand fits the capacity limit.
+     *
+     * Tables with at least ParallelMinCustomers customers are filled layer by
+     * layer on the requested number of workers; smaller ones stay serial.
+     * @return false when the customer set is empty or larger than MaxCustomers.
+     */
+    bool Solve(const Route&, const Customer&, const std::vector<Customer>&,
+               int capacityLimit = std::numeric_limits<int>::max(), unsigned workers = 1);
+
+    /** @brief Return the closed depot-to-depot cost of the subset, or Infinity when infeasible. */
+    [[nodiscard]] int RouteCost(std::size_t) const;
+
+    /** @brief Return the summed customer demand of a subset. */
+    [[nodiscard]] int Demand(std::size_t) const;
+
+    /** @brief Return the depot-to-depot customer list of an optimal route over the subset. */
+    [[nodiscard]] std::list<Customer> BuildRoute(std::size_t) const;
+
+    /** @brief Return the number of customers of the last solved set. */
+    [[nodiscard]] std::size_t CustomerCount() const;
+
+    /** @brief Free the tables when they exceed those of a customer count. */
+    void ReleaseLargeTables(std::size_t);
+
+  private:
+    template <typename T> using AlignedVector = std::vector<T, AlignedAllocator<T, 64>>;
+
+    /** @brief Return the cheapest last customer that closes the subset, or -1. */
+    [[nodiscard]] int ClosingCustomer(std::size_t) const;
+
+    /** @brief Fill the path row and closed cost of one subset from its predecessor rows. */
+    void SolveMask(std::size_t, int);
+
+    /** @brief Fill all subsets popcount layer by popcount layer on several workers. */
+    void SolveLayers(int, unsigned);
+
+    Customer depot;                        /**< Depot that starts and ends every route */
+    std::vector<Customer> customers;       /**< Local customers addressed by bit index */
+    std::size_t count = 0;                 /**< Number of local customers */
+    std::size_t stride = 0;                /**< Padded row width of the path and arc tables */
+    AlignedVector<int> arcInto;            /**< arcInto[to * stride + from], padded with zeros */
+    AlignedVector<int> toDepot;            /**< Closing arc cost of every customer, padded with zeros */
+    AlignedVector<int> path;               /**< path[mask * stride + last], Infinity when unreachable */
+    std::vector<int> demand;               /**< Demand of each subset */
+    std::vector<int> routeCost;            /**< Closed route cost of each subset */
+    std::vector<std::uint32_t> layerMasks; /**< Subsets sorted by popcount for layered solving */
+};
+
+/** @brief RAII handle borrowing a Held-Karp kernel from a process-wide free list.
+ *
+ * Borrowing keeps table buffers allocated between calls instead of
+ * reallocating them for every route pair. At most one idle kernel per
+ * hardware thread is retained, and tables above RetainedCustomers are freed
+ * on return: a 2^18-subset table is tens of megabytes and would otherwise
+ * stay resident for the life of the process, while filling it costs far more
+ * than allocating it.
+ */
+class HeldKarpLease {
+  public:
+    /** @brief Borrow an idle kernel, creating one when none is available. */
+    HeldKarpLease();
+
+    /** @brief Return the kernel and its buffers to the free list. */
+    ~HeldKarpLease();
+
+    HeldKarpLease(const HeldKarpLease&) = delete;
+    HeldKarpLease& operator=(const HeldKarpLease&) = delete;
+    HeldKarpLease(HeldKarpLease&&) = delete;
+    HeldKarpLease& operator=(HeldKarpLease&&) = delete;
+
+    /** @brief Access the borrowed kernel. */
+    HeldKarp& operator*() const { return *this->kernel; }
+
+    /** @brief Access the borrowed kernel. */
+    HeldKarp* operator->() const { return this->kernel.get(); }
+
+  private:
+    std::unique_ptr<HeldKarp> kernel; /**< Borrowed kernel, returned on destruction */
+};
+
+#endif /* HeldKarp_H */
@@ -0,0 +1,170 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "NeighborhoodScheduler.h"
+#include "Checkpoint.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <utility>
+
+namespace {
+// Timer resolution floor, so a sub-microsecond attempt cannot yield an
+// unbounded weight and freeze the order forever.
+constexpr double kMinAttemptMilliseconds = 0.01;
+
+/** @brief Sum route costs, the objective whose decrease rewards a neighborhood. */
+int RouteSetCost(const Routes& routes) {
+    int cost = 0;
+    for (const Route& route : routes) {
+        cost += route.GetTotalCost();
+    }
+    return cost;
+}
+} // namespace
+
+/** @brief Run the neighborhoods of one VND tier in adaptive order.
+ *
+ * The caller's cheapest-first order is kept, except that cold neighborhoods,
+ * whose recent yield is a small fraction of the best yield among the
+ * warmed-up neighborhoods of the tier, are deferred to the end. Neighborhoods
+ * with too few attempts to judge always stay in place. A fresh scheduler therefore behaves exactly like the
+ * fixed sequence, and a deferred neighborhood warms up again as soon as it
+ * gains when reached. The stop predicate is checked before every
+ * neighborhood, so a tier left at a deadline reports no improvement instead
+ * of running its remaining neighborhoods.
+ * @param[in,out] routes The routes to improve
+ * @param[in] neighborhoods Neighborhoods of the tier in default order
+ * @param[in] stop Predicate telling when the search must stop
+ * @param[in] adaptive Whether cold neighborhoods may be deferred
+ * @return true when one neighborhood changed the routes
+ */
+bool NeighborhoodScheduler::RunFirstImprovement(Routes& routes, const std::vector<Neighborhood>& neighborhoods,
+                                                const std::function<bool()>& stop, bool adaptive) {
+    // only warmed-up neighborhoods have a weight; the others keep their default position
+    std::vector<std::optional<double>> weights;
+    weights.reserve(neighborhoods.size());
+    double bestWeight = 0.0;
+    for (const Neighborhood& neighborhood : neighborhoods) {
+        const auto found = this->stats.find(neighborhood.name);
+        if (found == this->stats.end() || found->second.attempts < MinAttemptsBeforeDeferral) {
+            weights.emplace_back(std::nullopt);
+            continue;
+        }
+        weights.emplace_back(found->second.weight);
+        bestWeight = std::max(bestWeight, found->second.weight);
+    }
+    std::vector<std::size_t> order(neighborhoods.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    if (adaptive) {
+        std::ranges::stable_partition(order, [&weights, bestWeight](std::size_t index) {
+            return !weights[index].has_value() || *weights[index] >= ColdFraction * bestWeight;
+        });
+    }
+    for (const std::size_t index : order) {
+        if (stop()) {
+            return false;
+        }
+        const Neighborhood& neighborhood = neighborhoods[index];
+        const int costBefore = RouteSetCost(routes);
+        const auto start = std::chrono::steady_clock::now();
+        const bool improved = neighborhood.run(routes);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        this->Record(neighborhood.name, improved, costBefore - RouteSetCost(routes), elapsed.count());
+        if (improved) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Fold one timed attempt into the weight of a neighborhood.
+ *
+ * Route reductions may raise the cost while still being accepted, so every
+ * success earns at least one unit of gain. Failures add only their time,
+ * or one unit in deterministic mode.
+ * @param[in] name Neighborhood name
+ * @param[in] improved Whether the neighborhood changed the routes
+ * @param[in] gain Decrease of the summed route cost
+ * @param[in] milliseconds Wall time of the attempt
+ */
+void NeighborhoodScheduler::Record(const std::string& name, bool improved, int gain, double milliseconds) {
+    Stats& entry = this->stats[name];
+    entry.gain = (Decay * entry.gain) + (improved ? static_cast<double>(std::max(1, gain)) : 0.0);
+    // a deterministic run must not let timing reorder neighborhoods, so every attempt costs the same
+    const double cost = this->deterministic ? 1.0 : std::max(milliseconds, kMinAttemptMilliseconds);
+    entry.milliseconds = (Decay * entry.milliseconds) + cost;
+    entry.weight = entry.gain / entry.milliseconds;
+    ++entry.attempts;
+    if (improved) {
+        ++entry.successes;
+    }
+}
+
+/** @brief Format the learned weights for the verbose trace. */
+std::string NeighborhoodScheduler::DescribeWeights() const {
+    std::vector<std::pair<std::string, Stats>> ranked(this->stats.cbegin(), this->stats.cend());
+    std::ranges::stable_sort(ranked, [](const auto& left, const auto& right) {
+        return left.second.weight > right.second.weight;
+    });
+    std::ostringstream out;
+    out << std::setprecision(4);
+    for (const auto& [name, entry] : ranked) {
+        if (out.tellp() > 0) {
+            out << ' ';
+        }
+        out << name << '=' << entry.weight << " (" << entry.successes << '/' << entry.attempts << ')';
+    }
+    return out.str();
+}
+
+/** @brief Save the statistics of every neighborhood tried so far.
+ *
+ * @param[in,out] out Checkpoint being written
+ */
+void NeighborhoodScheduler::Save(CheckpointWriter& out) const {
+    out.U32(static_cast<std::uint32_t>(this->stats.size()));
+    for (const auto& [name, entry] : this->stats) {
+        out.String(name);
+        out.F64(entry.gain);
+        out.F64(entry.milliseconds);
+        out.F64(entry.weight);
+        out.I32(entry.attempts);
+        out.I32(entry.successes);
+    }
+}
+
+/** @brief Restore statistics saved by Save.
+ *
+ * @param[in,out] in Checkpoint being read
+ */
+void NeighborhoodScheduler::Load(CheckpointReader& in) {
+    this->stats.clear();
+    for (std::uint32_t count = in.U32(); count > 0; --count) {
+        std::string name = in.String();
+        Stats& entry = this->stats[name];
+        entry.gain = in.F64();
+        entry.milliseconds = in.F64();
+        entry.weight = in.F64();
+        entry.attempts = in.I32();
+        entry.successes = in.I32();
+    }
+}
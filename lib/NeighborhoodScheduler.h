@@ -0,0 +1,76 @@
+#ifndef NeighborhoodScheduler_H
+#define NeighborhoodScheduler_H
+
+#include "Route.h"
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/** @brief Adaptive ordering of VND neighborhoods by measured yield per millisecond.
+ *
+ * Every neighborhood keeps exponentially decayed sums of the cost it gained
+ * and the wall time it consumed, successful or not; its weight is their ratio,
+ * the recent yield per millisecond. In an adaptive tier, neighborhoods whose
+ * weight has dropped far below the best of the tier are deferred to its end,
+ * so repairs that keep burning time without gains stop delaying productive
+ * ones. Nothing is dropped: a step reports no improvement only after every
+ * neighborhood failed, so VND still stops at a local optimum of the whole set.
+ *
+ * Weights are keyed by neighborhood name and persist across VND passes.
+ */
+class NeighborhoodScheduler {
+  public:
+    /** @brief One schedulable neighborhood move. */
+    struct Neighborhood {
+        std::string name;                 /**< Stable name used for weights and trace output */
+        std::function<bool(Routes&)> run; /**< Move returning true when it changed the routes */
+    };
+
+    /** @brief Try neighborhoods in order until one improves the routes or the search must stop.
+     *
+     * When adaptive, cold neighborhoods are deferred to the end of the tier;
+     * otherwise the given order is kept and only statistics are recorded.
+     * @return true when some neighborhood succeeded.
+     */
+    bool RunFirstImprovement(Routes&, const std::vector<Neighborhood>&, const std::function<bool()>&,
+                             bool adaptive = true);
+
+    /** @brief Charge every attempt one unit of work instead of its wall time, for reproducible runs. */
+    void SetDeterministic(bool enabled) { this->deterministic = enabled; }
+
+    /** @brief Return the learned weights as "name=weight" pairs, highest first. */
+    [[nodiscard]] std::string DescribeWeights() const;
+
+    /** @brief Write the learned statistics to a checkpoint. */
+    void Save(CheckpointWriter&) const;
+
+    /** @brief Replace the learned statistics with those stored in a checkpoint. */
+    void Load(CheckpointReader&);
+
+  private:
+    static constexpr double InitialWeight = 1.0;        /**< Weight reported for a never-tried neighborhood */
+    static constexpr double Decay = 0.9;                /**< Weight kept by older attempts at each new attempt */
+    static constexpr double ColdFraction = 0.01;        /**< Share of the best tier weight below which a move is cold */
+    static constexpr int MinAttemptsBeforeDeferral = 4; /**< Attempts needed before a move can be deferred */
+
+    /** @brief Running statistics of one neighborhood. */
+    struct Stats {
+        double gain = 0.0;             /**< Decayed sum of cost gains */
+        double milliseconds = 0.0;     /**< Decayed sum of wall time, or of attempts when deterministic */
+        double weight = InitialWeight; /**< Recent gain per millisecond */
+        int attempts = 0;              /**< Number of calls */
+        int successes = 0;             /**< Number of calls that changed the routes */
+    };
+
+    /** @brief Fold one timed attempt into the weight of a neighborhood. */
+    void Record(const std::string&, bool, int, double);
+
+    std::map<std::string, Stats> stats; /**< Statistics by neighborhood name */
+    bool deterministic = false;         /**< Weigh gains per attempt rather than per millisecond */
+};
+
+#endif /* NeighborhoodScheduler_H */
@@ -16,12 +16,19 @@
  ****************************************************************************/
 
 #include "OptimalMove.h"
+#include "HeldKarp.h"
+#include "PerfCounters.h"
 #include <array>
 #include <bit>
 #include <cmath>
+#include <deque>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <ranges>
 #include <set>
@@ -59,14 +66,14 @@ int ApplyBestResult(Routes& routes, const std::set<BestResult, decltype(comp)>&
     return best.Improvement();
 }
 
-/** @brief Best pair of replacement routes produced by a 2-opt* tail exchange. */
+/** @brief Best pair of replacement routes produced by a 2-opt* tail exchange or a SWAP* move. */
 struct TwoOptStarRoutes {
     Route source;
     Route dest;
     int improvement;
 };
 
-/** @brief 2-opt* result annotated with source and destination route indexes. */
+/** @brief 2-opt* or SWAP* result annotated with source and destination route indexes. */
 struct IndexedTwoOptStarRoutes {
     Route source;
     Route dest;
@@ -183,26 +190,55 @@ struct BoundaryRuinSeed {
     std::size_t sequence;
 };
 
+/** @brief Cost change of one ruin-and-recreate candidate, identified by its enumeration sequence. */
+struct RuinRecreateScore {
+    int improvement;
+    std::size_t sequence;
+};
+
 /** @brief Recreated route set after removing and reinserting customers. */
 struct RuinRecreateResult {
     Routes routes;
-    int improvement;
-    std::size_t sequence;
+    RuinRecreateScore score;
 };
 
 /** @brief Best known route insertion for one removed customer. */
 struct RegretInsertion {
     std::size_t customerIndex;
     std::size_t routeIndex;
-    Route route;
     int bestIncrease;
+    int missingOptions;
     int regret;
 };
 
-/** @brief Partial route assignment retained by beam ruin-and-recreate. */
+/** @brief Cached cheapest insertion cost increase of every pending customer into every route.
+ *
+ * Entries are stored customer-major. An entry depends only on its customer and
+ * its route, so committing an insertion invalidates a single route column.
+ */
+struct InsertionCostTable {
+    std::size_t routeCount;
+    std::vector<int> increases;
+};
+
+/** @brief Partial route assignment retained by beam ruin-and-recreate.
+ *
+ * A state stores only the route its last insertion changed and shares every
+ * other route with its parent chain, which ends at the unchanged input routes.
+ */
 struct BeamInsertionState {
-    Routes routes;
-    std::vector<Customer> remaining;
+    std::shared_ptr<const BeamInsertionState> parent;
+    std::size_t routeIndex;
+    std::optional<Route> route;
+    std::vector<bool> inserted;
+    int cost;
+};
+
+/** @brief Beam expansion scored by delta cost, materialized only when it survives truncation. */
+struct BeamInsertionCandidate {
+    std::size_t stateIndex;
+    std::size_t customerIndex;
+    std::size_t routeIndex;
     int cost;
     std::size_t sequence;
 };
@@ -639,27 +675,13 @@ bool RemoveSegment(Route& route, const std::list<Customer>& segment) {
     return removed;
 }
 
-/** @brief Build a depot-to-depot route list from a Held-Karp parent table. */
-std::list<Customer> BuildExactRoute(const Customer& depot, const std::vector<Customer>& customers,
-                                    const std::vector<int>& parent, const std::vector<int>& routeLast,
-                                    std::size_t mask) {
-    std::vector<Customer> ordered;
-    ordered.reserve(std::popcount(mask));
-    const std::size_t customerCount = customers.size();
-    int current = routeLast[mask];
-    while (mask != 0 && current >= 0) {
-        const std::size_t currentIndex = static_cast<std::size_t>(current);
-        ordered.push_back(customers[currentIndex]);
-        const int previous = parent[(mask * customerCount) + currentIndex];
-        mask ^= std::size_t{1} << currentIndex;
-        current = previous;
-    }
-    std::ranges::reverse(ordered);
-    std::list<Customer> route;
-    route.push_back(depot);
-    std::ranges::copy(ordered, std::back_inserter(route));
-    route.push_back(depot);
-    return route;
+/** @brief Publish an order produced by the exact kernel to the shared route cache. */
+void PublishExactRoute(const Route& reference, const std::list<Customer>& routeList, int cost) {
+    if (routeList.size() <= 2) {
+        return;
+    }
+    const std::vector<Customer> order(std::next(routeList.cbegin()), std::prev(routeList.cend()));
+    reference.GetGraph().StoreExactRoute(order, cost);
 }
 
 /** @brief Find the best exact two-route repartition within a customer-count bound.
@@ -670,7 +692,7 @@ std::list<Customer> BuildExactRoute(const Customer& depot, const std::vector<Cus
  * avoid evaluating symmetric duplicate partitions.
  */
 std::optional<PairSplit> FindBestPairSplit(const Route& source, const Route& dest, int sourceIndex, int destIndex,
-                                           int maxCombinedCustomers) {
+                                           int maxCombinedCustomers, unsigned workers) {
     std::vector<Customer> customers = RouteCustomerVectorWithoutDepot(source);
     const std::vector<Customer> destCustomers = RouteCustomerVectorWithoutDepot(dest);
     customers.insert(customers.end(), destCustomers.cbegin(), destCustomers.cend());
@@ -680,64 +702,11 @@ std::optional<PairSplit> FindBestPairSplit(const Route& source, const Route& des
     }
 
     const Customer depot = source.GetRoute()->front().first;
-    const std::size_t customerCount = customers.size();
-    const std::size_t stateCount = std::size_t{1} << customerCount;
-    const std::size_t allCustomers = stateCount - 1;
-    const int capacity = source.GetInitialCapacity();
-    constexpr int infinity = std::numeric_limits<int>::max() / 4;
-
-    std::vector<int> demand(stateCount, 0);
-    for (std::size_t mask = 1; mask < stateCount; ++mask) {
-        const std::size_t bit = mask & (~mask + 1);
-        const std::size_t customer = std::countr_zero(bit);
-        demand[mask] = demand[mask ^ bit] + customers[customer].request;
-    }
-
-    std::vector<int> dp(stateCount * customerCount, infinity);
-    std::vector<int> parent(stateCount * customerCount, -1);
-    const auto state = [customerCount](std::size_t mask, std::size_t last) { return (mask * customerCount) + last; };
-    for (std::size_t customer = 0; customer < customerCount; ++customer) {
-        dp[state(std::size_t{1} << customer, customer)] = source.GetTravelCost(depot, customers[customer]);
-    }
-
-    for (std::size_t mask = 1; mask < stateCount; ++mask) {
-        for (std::size_t last = 0; last < customerCount; ++last) {
-            const int currentCost = dp[state(mask, last)];
-            if (currentCost == infinity || (mask & (std::size_t{1} << last)) == 0) {
-                continue;
-            }
-            const std::size_t remaining = allCustomers ^ mask;
-            for (std::size_t next = 0; next < customerCount; ++next) {
-                const std::size_t nextBit = std::size_t{1} << next;
-                if ((remaining & nextBit) == 0) {
-                    continue;
-                }
-                const std::size_t nextMask = mask | nextBit;
-                const int candidateCost = currentCost + source.GetTravelCost(customers[last], customers[next]);
-                int& bestCost = dp[state(nextMask, next)];
-                if (candidateCost < bestCost) {
-                    bestCost = candidateCost;
-                    parent[state(nextMask, next)] = static_cast<int>(last);
-                }
-            }
-        }
-    }
-
-    std::vector<int> routeCost(stateCount, infinity);
-    std::vector<int> routeLast(stateCount, -1);
-    routeCost[0] = 0;
-    for (std::size_t mask = 1; mask < stateCount; ++mask) {
-        for (std::size_t last = 0; last < customerCount; ++last) {
-            const int pathCost = dp[state(mask, last)];
-            if (pathCost == infinity) {
-                continue;
-            }
-            const int candidateCost = pathCost + source.GetTravelCost(customers[last], depot);
-            if (candidateCost < routeCost[mask]) {
-                routeCost[mask] = candidateCost;
-                routeLast[mask] = static_cast<int>(last);
-            }
-        }
+    const std::size_t allCustomers = (std::size_t{1} << customers.size()) - 1;
+    const HeldKarpLease lease;
+    HeldKarp& kernel = *lease;
+    if (!kernel.Solve(source, depot, customers, source.GetInitialCapacity(), workers)) {
+        return std::nullopt;
     }
 
     const int originalCost = source.GetTotalCost() + dest.GetTotalCost();
@@ -748,11 +717,11 @@ std::optional<PairSplit> FindBestPairSplit(const Route& source, const Route& des
             continue;
         }
         const std::size_t destMask = allCustomers ^ sourceMask;
-        if (demand[sourceMask] > capacity || demand[destMask] > capacity || routeCost[sourceMask] == infinity ||
-            routeCost[destMask] == infinity) {
+        // Over-capacity subsets are never solved, so their route cost stays infinite.
+        if (kernel.RouteCost(sourceMask) == HeldKarp::Infinity || kernel.RouteCost(destMask) == HeldKarp::Infinity) {
             continue;
         }
-        const int candidateCost = routeCost[sourceMask] + routeCost[destMask];
+        const int candidateCost = kernel.RouteCost(sourceMask) + kernel.RouteCost(destMask);
         const int improvement = originalCost - candidateCost;
         if (improvement > bestImprovement) {
             bestImprovement = improvement;
@@ -763,12 +732,16 @@ std::optional<PairSplit> FindBestPairSplit(const Route& source, const Route& des
         return std::nullopt;
     }
 
+    const std::list<Customer> sourceList = kernel.BuildRoute(bestMask);
+    const std::list<Customer> destList = kernel.BuildRoute(allCustomers ^ bestMask);
     Route candidateSource = source;
     Route candidateDest = dest;
-    if (!candidateSource.RebuildRoute(BuildExactRoute(depot, customers, parent, routeLast, bestMask)) ||
-        !candidateDest.RebuildRoute(BuildExactRoute(depot, customers, parent, routeLast, allCustomers ^ bestMask))) {
+    if (sourceList.empty() || destList.empty() || !candidateSource.RebuildRoute(sourceList) ||
+        !candidateDest.RebuildRoute(destList)) {
         return std::nullopt;
     }
+    PublishExactRoute(source, sourceList, kernel.RouteCost(bestMask));
+    PublishExactRoute(source, destList, kernel.RouteCost(allCustomers ^ bestMask));
     return PairSplit{
         .source = candidateSource,
         .dest = candidateDest,
@@ -787,7 +760,7 @@ std::optional<PairSplit> FindBestPairSplit(const Route& source, const Route& des
  * moves cannot improve one pair at a time.
  */
 std::optional<RouteClusterSplit> FindBestExactRouteClusterSplit(const std::array<RouteSnapshot, 3>& cluster,
-                                                                std::size_t maxCombinedCustomers) {
+                                                                std::size_t maxCombinedCustomers, unsigned workers) {
     std::vector<Customer> customers;
     for (const RouteSnapshot& snapshot : cluster) {
         const std::vector<Customer> routeCustomers = RouteCustomerVectorWithoutDepot(snapshot.route);
@@ -799,67 +772,11 @@ std::optional<RouteClusterSplit> FindBestExactRouteClusterSplit(const std::array
 
     const Route& reference = cluster.front().route;
     const Customer depot = reference.GetRoute()->front().first;
-    const int capacity = reference.GetInitialCapacity();
-    const std::size_t customerCount = customers.size();
-    const std::size_t stateCount = std::size_t{1} << customerCount;
-    const std::size_t allCustomers = stateCount - 1;
-    constexpr int infinity = std::numeric_limits<int>::max() / 4;
-
-    std::vector<int> demand(stateCount, 0);
-    for (std::size_t mask = 1; mask < stateCount; ++mask) {
-        const std::size_t bit = mask & (~mask + 1);
-        const std::size_t customer = std::countr_zero(bit);
-        demand[mask] = demand[mask ^ bit] + customers[customer].request;
-    }
-
-    std::vector<int> dp(stateCount * customerCount, infinity);
-    std::vector<int> parent(stateCount * customerCount, -1);
-    const auto state = [customerCount](std::size_t mask, std::size_t last) { return (mask * customerCount) + last; };
-    for (std::size_t customer = 0; customer < customerCount; ++customer) {
-        dp[state(std::size_t{1} << customer, customer)] = reference.GetTravelCost(depot, customers[customer]);
-    }
-
-    for (std::size_t mask = 1; mask < stateCount; ++mask) {
-        for (std::size_t last = 0; last < customerCount; ++last) {
-            const int currentCost = dp[state(mask, last)];
-            if (currentCost == infinity || (mask & (std::size_t{1} << last)) == 0) {
-                continue;
-            }
-            const std::size_t remaining = allCustomers ^ mask;
-            for (std::size_t next = 0; next < customerCount; ++next) {
-                const std::size_t nextBit = std::size_t{1} << next;
-                if ((remaining & nextBit) == 0) {
-                    continue;
-                }
-                const std::size_t nextMask = mask | nextBit;
-                const int candidateCost = currentCost + reference.GetTravelCost(customers[last], customers[next]);
-                int& bestCost = dp[state(nextMask, next)];
-                if (candidateCost < bestCost) {
-                    bestCost = candidateCost;
-                    parent[state(nextMask, next)] = static_cast<int>(last);
-                }
-            }
-        }
-    }
-
-    std::vector<int> routeCost(stateCount, infinity);
-    std::vector<int> routeLast(stateCount, -1);
-    routeCost[0] = 0;
-    for (std::size_t mask = 1; mask < stateCount; ++mask) {
-        if (demand[mask] > capacity) {
-            continue;
-        }
-        for (std::size_t last = 0; last < customerCount; ++last) {
-            const int pathCost = dp[state(mask, last)];
-            if (pathCost == infinity) {
-                continue;
-            }
-            const int candidateCost = pathCost + reference.GetTravelCost(customers[last], depot);
-            if (candidateCost < routeCost[mask]) {
-                routeCost[mask] = candidateCost;
-                routeLast[mask] = static_cast<int>(last);
-            }
-        }
+    const std::size_t allCustomers = (std::size_t{1} << customers.size()) - 1;
+    const HeldKarpLease lease;
+    HeldKarp& kernel = *lease;
+    if (!kernel.Solve(reference, depot, customers, reference.GetInitialCapacity(), workers)) {
+        return std::nullopt;
     }
 
     const int originalCost =
@@ -869,7 +786,7 @@ std::optional<RouteClusterSplit> FindBestExactRouteClusterSplit(const std::array
     // Put the lowest-numbered customer in the first subset to remove symmetric
     // duplicates where the same three routes are merely permuted.
     for (std::size_t firstMask = 1; firstMask < allCustomers; ++firstMask) {
-        if ((firstMask & 1U) == 0 || routeCost[firstMask] == infinity) {
+        if ((firstMask & 1U) == 0 || kernel.RouteCost(firstMask) == HeldKarp::Infinity) {
             continue;
         }
         const std::size_t remainingAfterFirst = allCustomers ^ firstMask;
@@ -882,14 +799,15 @@ std::optional<RouteClusterSplit> FindBestExactRouteClusterSplit(const std::array
         for (std::size_t secondMask = remainingAfterFirst; secondMask != 0;
              secondMask = (secondMask - 1) & remainingAfterFirst) {
             if ((secondMask & requiredSecondBit) == 0 || secondMask == remainingAfterFirst ||
-                routeCost[secondMask] == infinity) {
+                kernel.RouteCost(secondMask) == HeldKarp::Infinity) {
                 continue;
             }
             const std::size_t thirdMask = remainingAfterFirst ^ secondMask;
-            if (thirdMask == 0 || routeCost[thirdMask] == infinity) {
+            if (thirdMask == 0 || kernel.RouteCost(thirdMask) == HeldKarp::Infinity) {
                 continue;
             }
-            const int candidateCost = routeCost[firstMask] + routeCost[secondMask] + routeCost[thirdMask];
+            const int candidateCost =
+                kernel.RouteCost(firstMask) + kernel.RouteCost(secondMask) + kernel.RouteCost(thirdMask);
             const int improvement = originalCost - candidateCost;
             if (improvement > bestImprovement) {
                 bestImprovement = improvement;
@@ -903,10 +821,11 @@ std::optional<RouteClusterSplit> FindBestExactRouteClusterSplit(const std::array
 
     std::array<Route, 3> candidateRoutes = {cluster[0].route, cluster[1].route, cluster[2].route};
     for (std::size_t routeSlot = 0; routeSlot < candidateRoutes.size(); ++routeSlot) {
-        if (!candidateRoutes[routeSlot].RebuildRoute(
-                BuildExactRoute(depot, customers, parent, routeLast, bestMasks[routeSlot]))) {
+        const std::list<Customer> routeList = kernel.BuildRoute(bestMasks[routeSlot]);
+        if (routeList.empty() || !candidateRoutes[routeSlot].RebuildRoute(routeList)) {
             return std::nullopt;
         }
+        PublishExactRoute(reference, routeList, kernel.RouteCost(bestMasks[routeSlot]));
     }
     return RouteClusterSplit{
         .routes = std::move(candidateRoutes),
@@ -1141,28 +1060,20 @@ std::vector<std::vector<RuinCustomer>> BuildRuinCombinations(const std::vector<R
 
 /** @brief Insert one customer into the feasible route with the lowest cost increase. */
 bool InsertCustomerBestRoute(Routes& routes, const Customer& customer) {
-    Routes::iterator bestRoute = routes.end();
-    Route bestCandidate = routes.front();
+    std::optional<std::size_t> bestRoute;
     int bestCostIncrease = 0;
-    bool found = false;
-    for (Routes::iterator route = routes.begin(); route != routes.end(); ++route) {
-        Route candidate = *route;
-        if (!candidate.AddElem(customer)) {
+    for (std::size_t routeIndex = 0; routeIndex < routes.size(); ++routeIndex) {
+        const std::optional<int> insertedCost = routes[routeIndex].InsertionCost(customer);
+        if (!insertedCost.has_value()) {
             continue;
         }
-        const int costIncrease = ActiveRouteCost(candidate) - ActiveRouteCost(*route);
-        if (!found || costIncrease < bestCostIncrease) {
-            bestRoute = route;
-            bestCandidate = candidate;
+        const int costIncrease = *insertedCost - ActiveRouteCost(routes[routeIndex]);
+        if (!bestRoute.has_value() || costIncrease < bestCostIncrease) {
+            bestRoute = routeIndex;
             bestCostIncrease = costIncrease;
-            found = true;
         }
     }
-    if (!found) {
-        return false;
-    }
-    *bestRoute = bestCandidate;
-    return true;
+    return bestRoute.has_value() && routes[*bestRoute].AddElem(customer);
 }
 
 /** @brief Return all non-depot customers across the route set. */
@@ -1213,68 +1124,203 @@ std::vector<std::vector<Customer>> BuildRelatedRemovalSets(const Routes& routes,
     return removalSets;
 }
 
-/** @brief Reinsert removed customers using regret-2 insertion.
+// Regret ranks are computed over a fixed-size array of the cheapest routes so
+// ranking a customer never allocates; higher degrees are clamped to this bound.
+constexpr int kMaxRegretDegree = 4;
+constexpr int kInsertionInfinity = std::numeric_limits<int>::max() / 4;
+// Deleting a whole route reinserts many customers into tight capacity; looking
+// one route further ahead keeps the hardest of them from being stranded.
+constexpr int kRouteRemovalRegretDegree = 3;
+
+/** @brief Return the cost increase of inserting one customer into a route, or kInsertionInfinity. */
+int InsertionIncrease(const Route& route, const Customer& customer) {
+    const std::optional<int> cost = route.InsertionCost(customer);
+    return cost.has_value() ? *cost - ActiveRouteCost(route) : kInsertionInfinity;
+}
+
+/** @brief Price every pending customer against every route once. */
+InsertionCostTable BuildInsertionCostTable(const Routes& routes, const std::vector<Customer>& customers) {
+    InsertionCostTable table{
+        .routeCount = routes.size(),
+        .increases = std::vector<int>(customers.size() * routes.size(), kInsertionInfinity),
+    };
+    for (std::size_t customerIndex = 0; customerIndex < customers.size(); ++customerIndex) {
+        for (std::size_t routeIndex = 0; routeIndex < routes.size(); ++routeIndex) {
+            table.increases[(customerIndex * table.routeCount) + routeIndex] =
+                InsertionIncrease(routes[routeIndex], customers[customerIndex]);
+        }
+    }
+    return table;
+}
+
+/** @brief Reprice all pending customers against the one route that just changed. */
+void RefreshInsertionCosts(InsertionCostTable& table, const Routes& routes, const std::vector<Customer>& customers,
+                           std::size_t routeIndex) {
+    for (std::size_t customerIndex = 0; customerIndex < customers.size(); ++customerIndex) {
+        table.increases[(customerIndex * table.routeCount) + routeIndex] =
+            InsertionIncrease(routes[routeIndex], customers[customerIndex]);
+    }
+}
+
+/** @brief Drop the cached row of a customer that has been inserted. */
+void EraseInsertionCustomer(InsertionCostTable& table, std::size_t customerIndex) {
+    const auto first = table.increases.begin() + static_cast<std::ptrdiff_t>(customerIndex * table.routeCount);
+    table.increases.erase(first, first + static_cast<std::ptrdiff_t>(table.routeCount));
+}
+
+/** @brief Rank one pending customer by regret-k over its cached route insertions.
  *
- * The customer with the largest difference between its best and second-best
- * feasible insertions is placed first. This avoids consuming scarce capacity
- * with easy customers while hard-to-place customers still have options.
+ * The regret is the summed gap between the chosen insertion and the next
+ * cheapest routes up to the regret degree. Customers with fewer feasible routes
+ * than the degree are urgent regardless of their regret, which for degree two
+ * is the classic infinite regret of a customer that fits only one route. When
+ * an origin route is given, the cheapest other route is chosen if one exists.
+ * @return std::nullopt when no route can take the customer
  */
-bool InsertCustomersRegret(Routes& routes, std::vector<Customer> customers) {
-    constexpr int infinity = std::numeric_limits<int>::max() / 4;
+std::optional<RegretInsertion> RankRegretInsertion(const InsertionCostTable& table, std::size_t customerIndex,
+                                                   int regretDegree, std::optional<std::size_t> originRoute) {
+    std::array<int, kMaxRegretDegree> cheapest{};
+    cheapest.fill(kInsertionInfinity);
+    const std::size_t degree = static_cast<std::size_t>(regretDegree);
+    std::size_t bestRouteIndex = 0;
+    int bestChangedIncrease = kInsertionInfinity;
+    std::size_t bestChangedRouteIndex = 0;
+    const int* row = &table.increases[customerIndex * table.routeCount];
+    for (std::size_t routeIndex = 0; routeIndex < table.routeCount; ++routeIndex) {
+        const int increase = row[routeIndex];
+        if (increase >= kInsertionInfinity) {
+            continue;
+        }
+        if (increase < cheapest[0]) {
+            bestRouteIndex = routeIndex;
+        }
+        for (std::size_t slot = 0; slot < degree; ++slot) {
+            if (increase < cheapest[slot]) {
+                std::shift_right(cheapest.begin() + static_cast<std::ptrdiff_t>(slot),
+                                 cheapest.begin() + static_cast<std::ptrdiff_t>(degree), 1);
+                cheapest[slot] = increase;
+                break;
+            }
+        }
+        if (originRoute != routeIndex && increase < bestChangedIncrease) {
+            bestChangedIncrease = increase;
+            bestChangedRouteIndex = routeIndex;
+        }
+    }
+    if (cheapest[0] >= kInsertionInfinity) {
+        return std::nullopt;
+    }
+    const bool changedRouteAvailable = bestChangedIncrease < kInsertionInfinity;
+    const int chosenIncrease = changedRouteAvailable ? bestChangedIncrease : cheapest[0];
+    int missingOptions = 0;
+    int regret = 0;
+    for (std::size_t slot = 1; slot < degree; ++slot) {
+        if (cheapest[slot] >= kInsertionInfinity) {
+            ++missingOptions;
+        } else {
+            regret += cheapest[slot] - chosenIncrease;
+        }
+    }
+    return RegretInsertion{
+        .customerIndex = customerIndex,
+        .routeIndex = changedRouteAvailable ? bestChangedRouteIndex : bestRouteIndex,
+        .bestIncrease = chosenIncrease,
+        .missingOptions = missingOptions,
+        .regret = regret,
+    };
+}
+
+/** @brief Check whether one ranked insertion should be committed before another. */
+bool IsMoreUrgentInsertion(const RegretInsertion& left, const RegretInsertion& right,
+                           const std::vector<Customer>& customers) {
+    if (left.missingOptions != right.missingOptions) {
+        return left.missingOptions > right.missingOptions;
+    }
+    if (left.regret != right.regret) {
+        return left.regret > right.regret;
+    }
+    if (left.bestIncrease != right.bestIncrease) {
+        return left.bestIncrease < right.bestIncrease;
+    }
+    return customers[left.customerIndex].name < customers[right.customerIndex].name;
+}
+
+/** @brief Reinsert customers by regret-k using cached insertion costs.
+ *
+ * Every customer is priced against every route once. After each commit only
+ * the column of the modified route is repriced, so an outer iteration costs a
+ * scan of cached integers plus one route's worth of insertion probes instead of
+ * a route copy for every (customer, route) pair.
+ * @param[in,out] routes Routes receiving the customers
+ * @param[in] customers Customers to insert
+ * @param[in] origins Origin route index of each customer, aligned with customers
+ * @param[in] regretDegree Number of cheapest routes compared by the regret
+ * @return false when some customer fits no route
+ */
+bool InsertCustomersByRegret(Routes& routes, std::vector<Customer> customers,
+                             std::vector<std::optional<std::size_t>> origins, int regretDegree) {
+    regretDegree = std::clamp(regretDegree, 2, kMaxRegretDegree);
+    InsertionCostTable table = BuildInsertionCostTable(routes, customers);
     while (!customers.empty()) {
         std::optional<RegretInsertion> selected;
         for (std::size_t customerIndex = 0; customerIndex < customers.size(); ++customerIndex) {
-            int bestIncrease = infinity;
-            int secondBestIncrease = infinity;
-            std::size_t bestRouteIndex = 0;
-            Route bestRoute = routes.front();
-            for (std::size_t routeIndex = 0; routeIndex < routes.size(); ++routeIndex) {
-                Route candidate = routes[routeIndex];
-                if (!candidate.AddElem(customers[customerIndex])) {
-                    continue;
-                }
-                const int increase = ActiveRouteCost(candidate) - ActiveRouteCost(routes[routeIndex]);
-                if (increase < bestIncrease) {
-                    secondBestIncrease = bestIncrease;
-                    bestIncrease = increase;
-                    bestRouteIndex = routeIndex;
-                    bestRoute = std::move(candidate);
-                } else if (increase < secondBestIncrease) {
-                    secondBestIncrease = increase;
-                }
-            }
-            if (bestIncrease == infinity) {
-                continue;
-            }
-            const int regret = secondBestIncrease == infinity ? infinity : secondBestIncrease - bestIncrease;
-            if (!selected.has_value() || regret > selected->regret ||
-                (regret == selected->regret && bestIncrease < selected->bestIncrease) ||
-                (regret == selected->regret && bestIncrease == selected->bestIncrease &&
-                 customers[customerIndex].name < customers[selected->customerIndex].name)) {
-                selected = RegretInsertion{
-                    .customerIndex = customerIndex,
-                    .routeIndex = bestRouteIndex,
-                    .route = std::move(bestRoute),
-                    .bestIncrease = bestIncrease,
-                    .regret = regret,
-                };
+            const std::optional<RegretInsertion> ranked =
+                RankRegretInsertion(table, customerIndex, regretDegree, origins[customerIndex]);
+            if (ranked.has_value() &&
+                (!selected.has_value() || IsMoreUrgentInsertion(*ranked, *selected, customers))) {
+                selected = ranked;
             }
         }
-        if (!selected.has_value()) {
+        if (!selected.has_value() || !routes[selected->routeIndex].AddElem(customers[selected->customerIndex])) {
             return false;
         }
-        routes[selected->routeIndex] = std::move(selected->route);
-        customers.erase(customers.begin() + static_cast<std::ptrdiff_t>(selected->customerIndex));
+        const auto erased = static_cast<std::ptrdiff_t>(selected->customerIndex);
+        customers.erase(customers.begin() + erased);
+        origins.erase(origins.begin() + erased);
+        EraseInsertionCustomer(table, selected->customerIndex);
+        RefreshInsertionCosts(table, routes, customers, selected->routeIndex);
     }
     return true;
 }
 
+/** @brief Reinsert removed customers using regret-k insertion.
+ *
+ * The customer with the largest difference between its best and next-best
+ * feasible insertions is placed first. This avoids consuming scarce capacity
+ * with easy customers while hard-to-place customers still have options.
+ */
+bool InsertCustomersRegret(Routes& routes, std::vector<Customer> customers, int regretDegree = 2) {
+    std::vector<std::optional<std::size_t>> origins(customers.size());
+    return InsertCustomersByRegret(routes, std::move(customers), std::move(origins), regretDegree);
+}
+
+/** @brief Resolve the current version of every route along a beam state's parent chain. */
+std::vector<const Route*> ResolveBeamRoutes(const Routes& routes, const BeamInsertionState& state) {
+    std::vector<const Route*> resolved(routes.size(), nullptr);
+    for (const BeamInsertionState* node = &state; node != nullptr; node = node->parent.get()) {
+        if (node->route.has_value() && resolved[node->routeIndex] == nullptr) {
+            resolved[node->routeIndex] = &*node->route;
+        }
+    }
+    for (std::size_t routeIndex = 0; routeIndex < routes.size(); ++routeIndex) {
+        if (resolved[routeIndex] == nullptr) {
+            resolved[routeIndex] = &routes[routeIndex];
+        }
+    }
+    return resolved;
+}
+
 /** @brief Reinsert customers while keeping several low-cost partial assignments.
  *
  * Regret insertion is fast but commits to one route choice at each step. The
  * beam version keeps a bounded set of partial reconstructions, which lets a
  * temporarily second-best insertion survive long enough to free capacity or
  * produce a better route-membership combination.
+ *
+ * Expansions are priced with Route::InsertionCost against the resolved routes
+ * of their parent state, and only the survivors of each layer copy the single
+ * route they change. A layer therefore allocates beamWidth routes instead of
+ * one full solution per (state, customer, route) expansion.
  */
 bool InsertCustomersBeam(Routes& routes, const std::vector<Customer>& customers, int beamWidth) {
     if (customers.empty()) {
@@ -1283,56 +1329,84 @@ bool InsertCustomersBeam(Routes& routes, const std::vector<Customer>& customers,
     if (beamWidth <= 0 || routes.empty()) {
         return false;
     }
-    std::vector<BeamInsertionState> beam = {BeamInsertionState{
-        .routes = routes,
-        .remaining = customers,
-        .cost = TotalRouteCost(routes),
-        .sequence = 0,
-    }};
+    std::vector<std::shared_ptr<const BeamInsertionState>> beam = {
+        std::make_shared<const BeamInsertionState>(BeamInsertionState{
+            .parent = nullptr,
+            .routeIndex = 0,
+            .route = std::nullopt,
+            .inserted = std::vector<bool>(customers.size(), false),
+            .cost = TotalRouteCost(routes),
+        }),
+    };
     std::size_t sequence = 1;
-    while (!beam.empty() && !beam.front().remaining.empty()) {
-        std::vector<BeamInsertionState> nextBeam;
-        for (const BeamInsertionState& state : beam) {
-            for (std::size_t customerIndex = 0; customerIndex < state.remaining.size(); ++customerIndex) {
-                const Customer& customer = state.remaining[customerIndex];
-                for (std::size_t routeIndex = 0; routeIndex < state.routes.size(); ++routeIndex) {
-                    Route candidateRoute = state.routes[routeIndex];
-                    if (!candidateRoute.AddElem(customer)) {
+    std::vector<BeamInsertionCandidate> candidates;
+    for (std::size_t layer = 0; layer < customers.size(); ++layer) {
+        candidates.clear();
+        for (std::size_t stateIndex = 0; stateIndex < beam.size(); ++stateIndex) {
+            const BeamInsertionState& state = *beam[stateIndex];
+            const std::vector<const Route*> stateRoutes = ResolveBeamRoutes(routes, state);
+            for (std::size_t customerIndex = 0; customerIndex < customers.size(); ++customerIndex) {
+                if (state.inserted[customerIndex]) {
+                    continue;
+                }
+                for (std::size_t routeIndex = 0; routeIndex < stateRoutes.size(); ++routeIndex) {
+                    const Route& route = *stateRoutes[routeIndex];
+                    const std::optional<int> insertedCost = route.InsertionCost(customers[customerIndex]);
+                    if (!insertedCost.has_value()) {
                         continue;
                     }
-                    Routes candidateRoutes = state.routes;
-                    const int candidateCost =
-                        state.cost - ActiveRouteCost(candidateRoutes[routeIndex]) + ActiveRouteCost(candidateRoute);
-                    candidateRoutes[routeIndex] = std::move(candidateRoute);
-                    std::vector<Customer> remaining = state.remaining;
-                    remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(customerIndex));
-                    nextBeam.push_back(BeamInsertionState{
-                        .routes = std::move(candidateRoutes),
-                        .remaining = std::move(remaining),
-                        .cost = candidateCost,
+                    candidates.push_back(BeamInsertionCandidate{
+                        .stateIndex = stateIndex,
+                        .customerIndex = customerIndex,
+                        .routeIndex = routeIndex,
+                        .cost = state.cost - ActiveRouteCost(route) + *insertedCost,
                         .sequence = sequence++,
                     });
                 }
             }
         }
-        if (nextBeam.empty()) {
+        if (candidates.empty()) {
             return false;
         }
-        std::ranges::sort(nextBeam, [](const BeamInsertionState& left, const BeamInsertionState& right) {
-            if (left.cost != right.cost) {
-                return left.cost < right.cost;
-            }
-            if (left.remaining.size() != right.remaining.size()) {
-                return left.remaining.size() < right.remaining.size();
+        const std::size_t survivors = std::min(candidates.size(), static_cast<std::size_t>(beamWidth));
+        std::ranges::partial_sort(candidates, candidates.begin() + static_cast<std::ptrdiff_t>(survivors),
+                                  [](const BeamInsertionCandidate& left, const BeamInsertionCandidate& right) {
+                                      if (left.cost != right.cost) {
+                                          return left.cost < right.cost;
+                                      }
+                                      return left.sequence < right.sequence;
+                                  });
+        std::vector<std::shared_ptr<const BeamInsertionState>> nextBeam;
+        nextBeam.reserve(survivors);
+        for (std::size_t rank = 0; rank < survivors; ++rank) {
+            const BeamInsertionCandidate& candidate = candidates[rank];
+            const std::shared_ptr<const BeamInsertionState>& parent = beam[candidate.stateIndex];
+            Route changedRoute = *ResolveBeamRoutes(routes, *parent)[candidate.routeIndex];
+            if (!changedRoute.AddElem(customers[candidate.customerIndex])) {
+                continue;
             }
-            return left.sequence < right.sequence;
-        });
-        if (std::cmp_greater(nextBeam.size(), beamWidth)) {
-            nextBeam.resize(static_cast<std::size_t>(beamWidth));
+            std::vector<bool> inserted = parent->inserted;
+            inserted[candidate.customerIndex] = true;
+            nextBeam.push_back(std::make_shared<const BeamInsertionState>(BeamInsertionState{
+                .parent = parent,
+                .routeIndex = candidate.routeIndex,
+                .route = std::move(changedRoute),
+                .inserted = std::move(inserted),
+                .cost = candidate.cost,
+            }));
+        }
+        if (nextBeam.empty()) {
+            return false;
         }
         beam = std::move(nextBeam);
     }
-    routes = std::move(beam.front().routes);
+    const std::vector<const Route*> bestRoutes = ResolveBeamRoutes(routes, *beam.front());
+    Routes rebuilt;
+    rebuilt.reserve(bestRoutes.size());
+    for (const Route* route : bestRoutes) {
+        rebuilt.push_back(*route);
+    }
+    routes = std::move(rebuilt);
     return true;
 }
 
@@ -1349,65 +1423,13 @@ std::optional<std::size_t> FindCustomerRouteIndex(const Routes& routes, const Cu
 /** @brief Reinsert customers while preferring routes different from their origin. */
 bool InsertCustomersRegretAvoidingOrigin(Routes& routes, std::vector<Customer> customers,
                                          const std::map<Customer, std::size_t>& originRouteIndex) {
-    constexpr int infinity = std::numeric_limits<int>::max() / 4;
-    while (!customers.empty()) {
-        std::optional<RegretInsertion> selected;
-        for (std::size_t customerIndex = 0; customerIndex < customers.size(); ++customerIndex) {
-            int bestIncrease = infinity;
-            int secondBestIncrease = infinity;
-            std::size_t bestRouteIndex = 0;
-            Route bestRoute = routes.front();
-            int bestChangedIncrease = infinity;
-            std::size_t bestChangedRouteIndex = 0;
-            Route bestChangedRoute = routes.front();
-            const auto origin = originRouteIndex.find(customers[customerIndex]);
-            for (std::size_t routeIndex = 0; routeIndex < routes.size(); ++routeIndex) {
-                Route candidate = routes[routeIndex];
-                if (!candidate.AddElem(customers[customerIndex])) {
-                    continue;
-                }
-                const int increase = ActiveRouteCost(candidate) - ActiveRouteCost(routes[routeIndex]);
-                if (increase < bestIncrease) {
-                    secondBestIncrease = bestIncrease;
-                    bestIncrease = increase;
-                    bestRouteIndex = routeIndex;
-                    bestRoute = candidate;
-                } else if (increase < secondBestIncrease) {
-                    secondBestIncrease = increase;
-                }
-                if ((origin == originRouteIndex.end() || origin->second != routeIndex) &&
-                    increase < bestChangedIncrease) {
-                    bestChangedIncrease = increase;
-                    bestChangedRouteIndex = routeIndex;
-                    bestChangedRoute = std::move(candidate);
-                }
-            }
-            if (bestIncrease == infinity) {
-                continue;
-            }
-            const bool changedRouteAvailable = bestChangedIncrease != infinity;
-            const int chosenIncrease = changedRouteAvailable ? bestChangedIncrease : bestIncrease;
-            const int regret = secondBestIncrease == infinity ? infinity : secondBestIncrease - chosenIncrease;
-            if (!selected.has_value() || regret > selected->regret ||
-                (regret == selected->regret && chosenIncrease < selected->bestIncrease) ||
-                (regret == selected->regret && chosenIncrease == selected->bestIncrease &&
-                 customers[customerIndex].name < customers[selected->customerIndex].name)) {
-                selected = RegretInsertion{
-                    .customerIndex = customerIndex,
-                    .routeIndex = changedRouteAvailable ? bestChangedRouteIndex : bestRouteIndex,
-                    .route = changedRouteAvailable ? std::move(bestChangedRoute) : std::move(bestRoute),
-                    .bestIncrease = chosenIncrease,
-                    .regret = regret,
-                };
-            }
-        }
-        if (!selected.has_value()) {
-            return false;
-        }
-        routes[selected->routeIndex] = std::move(selected->route);
-        customers.erase(customers.begin() + static_cast<std::ptrdiff_t>(selected->customerIndex));
+    std::vector<std::optional<std::size_t>> origins;
+    origins.reserve(customers.size());
+    for (const Customer& customer : customers) {
+        const auto origin = originRouteIndex.find(customer);
+        origins.push_back(origin == originRouteIndex.end() ? std::nullopt : std::optional(origin->second));
     }
-    return true;
+    return InsertCustomersByRegret(routes, std::move(customers), std::move(origins), 2);
 }
 
 /** @brief Select nearby movable buffer customers for route elimination repair. */
@@ -1481,7 +1503,7 @@ std::optional<RouteReduction> EvaluateBufferedRouteRemoval(const Routes& routes,
             }
         }
     }
-    if (!InsertCustomersRegret(candidate, removedCustomers)) {
+    if (!InsertCustomersRegret(candidate, removedCustomers, kRouteRemovalRegretDegree)) {
         return std::nullopt;
     }
     std::erase_if(candidate, [](const Route& route) { return route.size() <= 2; });
@@ -1708,8 +1730,13 @@ std::optional<RouteReduction> EvaluateRouteRemoval(const Routes& routes, std::si
     return best;
 }
 
-/** @brief Optimize one small route exactly as a fixed-membership TSP. */
-int OptimizeSingleRouteTsp(Route& route, int maxCustomers) {
+/** @brief Optimize one small route exactly as a fixed-membership TSP.
+ *
+ * The exact order of a membership is looked up in the graph-wide cache first;
+ * only unseen memberships pay for the Held-Karp table, and their optimum is
+ * published for later VND rounds, tabu passes, and savings restarts.
+ */
+int OptimizeSingleRouteTsp(Route& route, int maxCustomers, unsigned workers = 1) {
     if (route.size() <= 2) {
         return 0;
     }
@@ -1717,75 +1744,263 @@ int OptimizeSingleRouteTsp(Route& route, int maxCustomers) {
     if (customerCount <= 1 || customerCount > maxCustomers) {
         return 0;
     }
-    std::vector<Customer> customers;
-    customers.reserve(static_cast<std::size_t>(customerCount));
-    RouteList::const_iterator it = route.GetRoute()->cbegin();
-    const Customer depot = it->first;
-    for (++it; it != route.GetRoute()->cend() && it->first != depot; ++it) {
-        customers.push_back(it->first);
+    const std::vector<Customer> customers = RouteCustomerVectorWithoutDepot(route);
+    const Customer depot = route.GetRoute()->front().first;
+    int exactCost = 0;
+    std::list<Customer> rebuilt;
+    if (const auto cached = route.GetGraph().FindExactRoute(customers); cached.has_value()) {
+        exactCost = cached->first;
+        if (exactCost < route.GetTotalCost()) {
+            rebuilt = BuildRouteList(depot, cached->second);
+        }
+    } else {
+        const HeldKarpLease lease;
+        HeldKarp& kernel = *lease;
+        if (!kernel.Solve(route, depot, customers, std::numeric_limits<int>::max(), workers)) {
+            return 0;
+        }
+        const std::size_t allVisited = (std::size_t{1} << customers.size()) - 1;
+        exactCost = kernel.RouteCost(allVisited);
+        rebuilt = kernel.BuildRoute(allVisited);
+        PublishExactRoute(route, rebuilt, exactCost);
     }
-    const std::size_t count = customers.size();
-    const std::size_t stateCount = std::size_t{1} << count;
-    constexpr int infinity = std::numeric_limits<int>::max() / 4;
-    std::vector<std::vector<int>> dp(stateCount, std::vector<int>(count, infinity));
-    std::vector<std::vector<int>> parent(stateCount, std::vector<int>(count, -1));
-    // dp[mask][last] is the cheapest depot -> ... -> customers[last] path
-    // that visits exactly the customer bits contained in mask.
-    for (std::size_t customer = 0; customer < count; ++customer) {
-        dp[std::size_t{1} << customer][customer] = route.GetTravelCost(depot, customers[customer]);
-    }
-    for (std::size_t mask = 1; mask < stateCount; ++mask) {
-        for (std::size_t last = 0; last < count; ++last) {
-            if (dp[mask][last] == infinity || (mask & (std::size_t{1} << last)) == 0) {
+    if (exactCost >= route.GetTotalCost()) {
+        return 0;
+    }
+    Route candidate = route;
+    if (rebuilt.empty() || !candidate.RebuildRoute(rebuilt)) {
+        return 0;
+    }
+    const int improvement = route.GetTotalCost() - candidate.GetTotalCost();
+    route = std::move(candidate);
+    return improvement;
+}
+
+constexpr std::size_t kLongRouteNeighbors = 8;
+constexpr std::size_t kOrOptMaxSegment = 3;
+
+/** @brief Index-based open tour of one route for intra-route local search.
+ *
+ * Node 0 is the depot and nodes 1..n the route customers; the tour stores the
+ * node at each position, with the depot fixed at both ends, and the inverse
+ * position of every customer. Arc costs are copied once into a local matrix.
+ */
+struct LongRouteTour {
+    std::vector<Customer> nodes;           /**< Depot followed by the route customers */
+    std::vector<int> cost;                 /**< Row-major arc cost between local nodes */
+    std::vector<int> order;                /**< Node at each tour position, depot at both ends */
+    std::vector<std::size_t> position;     /**< Tour position of every customer node */
+    std::vector<std::vector<int>> nearest; /**< Closest customer nodes of every customer */
+
+    /** @brief Return the arc cost between two local nodes. */
+    [[nodiscard]] int Arc(int from, int to) const {
+        return this->cost[(static_cast<std::size_t>(from) * this->nodes.size()) + static_cast<std::size_t>(to)];
+    }
+
+    /** @brief Return the cost of the arc leaving a tour position. */
+    [[nodiscard]] int ArcAt(std::size_t at) const { return this->Arc(this->order[at], this->order[at + 1]); }
+
+    /** @brief Refresh customer positions after the order changed. */
+    void Reindex() {
+        for (std::size_t at = 1; at + 1 < this->order.size(); ++at) {
+            this->position[static_cast<std::size_t>(this->order[at])] = at;
+        }
+    }
+};
+
+/** @brief Build the local tour, cost matrix and neighbour lists of a route. */
+LongRouteTour BuildLongRouteTour(const Route& route) {
+    LongRouteTour tour;
+    tour.nodes.push_back(route.GetRoute()->front().first);
+    const std::vector<Customer> customers = RouteCustomerVectorWithoutDepot(route);
+    tour.nodes.insert(tour.nodes.end(), customers.cbegin(), customers.cend());
+    const std::size_t nodeCount = tour.nodes.size();
+    tour.cost.resize(nodeCount * nodeCount);
+    for (std::size_t from = 0; from < nodeCount; ++from) {
+        for (std::size_t to = 0; to < nodeCount; ++to) {
+            tour.cost[(from * nodeCount) + to] = from == to ? 0 : route.GetTravelCost(tour.nodes[from], tour.nodes[to]);
+        }
+    }
+    tour.order.resize(nodeCount + 1);
+    std::iota(tour.order.begin(), tour.order.end() - 1, 0);
+    tour.order.back() = 0;
+    tour.position.resize(nodeCount);
+    tour.Reindex();
+    const std::size_t neighborCount = std::min(kLongRouteNeighbors, nodeCount - 2);
+    tour.nearest.resize(nodeCount);
+    for (int node = 1; std::cmp_less(node, nodeCount); ++node) {
+        std::vector<int> others;
+        others.reserve(nodeCount - 2);
+        for (int other = 1; std::cmp_less(other, nodeCount); ++other) {
+            if (other != node) {
+                others.push_back(other);
+            }
+        }
+        std::ranges::partial_sort(others, others.begin() + static_cast<std::ptrdiff_t>(neighborCount),
+                                  [&tour, node](int left, int right) {
+                                      const int leftCost = tour.Arc(node, left);
+                                      const int rightCost = tour.Arc(node, right);
+                                      return leftCost != rightCost ? leftCost < rightCost : left < right;
+                                  });
+        others.resize(neighborCount);
+        tour.nearest[static_cast<std::size_t>(node)] = std::move(others);
+    }
+    return tour;
+}
+
+/** @brief Try the neighbour-list 2-opt moves that create an arc between a customer and one neighbour.
+ *
+ * Reversing positions first..last replaces the arcs entering and leaving the
+ * segment; the new arc (node, neighbour) fixes the segment to two choices.
+ * @param[in,out] tour Tour to improve
+ * @param[in] node Active customer
+ * @param[in] neighbor One of its nearest customers
+ * @param[out] touched Endpoints of the replaced arcs
+ * @return True when an improving reversal was applied
+ */
+bool TryTwoOptMove(LongRouteTour& tour, int node, int neighbor, std::vector<int>& touched) {
+    const std::size_t nodeAt = tour.position[static_cast<std::size_t>(node)];
+    const std::size_t neighborAt = tour.position[static_cast<std::size_t>(neighbor)];
+    const std::size_t low = std::min(nodeAt, neighborAt);
+    const std::size_t high = std::max(nodeAt, neighborAt);
+    // Either the low endpoint precedes the reversed segment or the high one follows it.
+    for (const auto& [first, last] : {std::pair{low + 1, high}, std::pair{low, high - 1}}) {
+        if (first >= last) {
+            continue;
+        }
+        const int gain = tour.ArcAt(first - 1) + tour.ArcAt(last) - tour.Arc(tour.order[first - 1], tour.order[last]) -
+                         tour.Arc(tour.order[first], tour.order[last + 1]);
+        if (gain > 0) {
+            touched = {tour.order[first - 1], tour.order[first], tour.order[last], tour.order[last + 1]};
+            std::reverse(tour.order.begin() + static_cast<std::ptrdiff_t>(first),
+                         tour.order.begin() + static_cast<std::ptrdiff_t>(last) + 1);
+            tour.Reindex();
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Try Or-opt moves of short segments containing a customer next to one neighbour.
+ *
+ * Segments of up to kOrOptMaxSegment customers starting or ending at the node
+ * are moved, in either orientation, onto an arc touching the neighbour.
+ * @param[in,out] tour Tour to improve
+ * @param[in] node Active customer
+ * @param[in] neighbor One of its nearest customers
+ * @param[out] touched Endpoints of the replaced arcs
+ * @return True when an improving segment move was applied
+ */
+bool TryOrOptMove(LongRouteTour& tour, int node, int neighbor, std::vector<int>& touched) {
+    const std::size_t nodeAt = tour.position[static_cast<std::size_t>(node)];
+    const std::size_t neighborAt = tour.position[static_cast<std::size_t>(neighbor)];
+    const std::size_t lastCustomer = tour.order.size() - 2;
+    for (std::size_t length = 1; length <= kOrOptMaxSegment; ++length) {
+        for (const bool nodeIsHead : {true, false}) {
+            if (!nodeIsHead && length == 1) {
+                continue;
+            }
+            if ((nodeIsHead && nodeAt + length - 1 > lastCustomer) || (!nodeIsHead && nodeAt < length)) {
+                continue;
+            }
+            const std::size_t first = nodeIsHead ? nodeAt : nodeAt - length + 1;
+            const std::size_t last = first + length - 1;
+            if (neighborAt >= first && neighborAt <= last) {
                 continue;
             }
-            for (std::size_t next = 0; next < count; ++next) {
-                const std::size_t nextBit = std::size_t{1} << next;
-                if ((mask & nextBit) != 0) {
+            const int head = tour.order[first];
+            const int tail = tour.order[last];
+            const int removalGain =
+                tour.ArcAt(first - 1) + tour.ArcAt(last) - tour.Arc(tour.order[first - 1], tour.order[last + 1]);
+            for (const std::size_t arcAt : {neighborAt - 1, neighborAt}) {
+                if (arcAt + 1 >= first && arcAt <= last) {
+                    continue;
+                }
+                const int from = tour.order[arcAt];
+                const int to = tour.order[arcAt + 1];
+                const int forward = tour.Arc(from, head) + tour.Arc(tail, to);
+                const int backward = tour.Arc(from, tail) + tour.Arc(head, to);
+                const int gain = removalGain + tour.ArcAt(arcAt) - std::min(forward, backward);
+                if (gain <= 0) {
                     continue;
                 }
-                const std::size_t nextMask = mask | nextBit;
-                const int candidateCost = dp[mask][last] + route.GetTravelCost(customers[last], customers[next]);
-                if (candidateCost < dp[nextMask][next]) {
-                    dp[nextMask][next] = candidateCost;
-                    // Remember the predecessor so the optimal route order can be rebuilt.
-                    parent[nextMask][next] = static_cast<int>(last);
+                touched = {tour.order[first - 1], head, tail, tour.order[last + 1], from, to};
+                std::vector<int> segment(tour.order.begin() + static_cast<std::ptrdiff_t>(first),
+                                         tour.order.begin() + static_cast<std::ptrdiff_t>(last) + 1);
+                if (backward < forward) {
+                    std::ranges::reverse(segment);
+                }
+                std::vector<int> reordered;
+                reordered.reserve(tour.order.size());
+                for (std::size_t at = 0; at < tour.order.size(); ++at) {
+                    if (at < first || at > last) {
+                        reordered.push_back(tour.order[at]);
+                    }
+                    if (at == arcAt) {
+                        reordered.insert(reordered.end(), segment.cbegin(), segment.cend());
+                    }
                 }
+                tour.order = std::move(reordered);
+                tour.Reindex();
+                return true;
             }
         }
     }
-    const std::size_t allVisited = stateCount - 1;
-    int bestCost = infinity;
-    int bestLast = -1;
-    for (std::size_t last = 0; last < count; ++last) {
-        const int candidateCost = dp[allVisited][last] + route.GetTravelCost(customers[last], depot);
-        if (candidateCost < bestCost) {
-            bestCost = candidateCost;
-            bestLast = static_cast<int>(last);
+    return false;
+}
+
+/** @brief Polish one long route with neighbour-list 2-opt and Or-opt under don't-look bits.
+ *
+ * Customers start active; an active customer tries the moves that connect it
+ * to one of its nearest customers and goes idle when none gains. Every applied
+ * move reactivates the customers around the changed arcs, so the search ends
+ * at a local optimum of both neighbourhoods after near-linear work.
+ * @param[in,out] route Route to reorder
+ * @param[in] exactCustomers Routes up to this size are left to exact ordering
+ * @return Cost reduction of the route
+ */
+int PolishLongRoute(Route& route, int exactCustomers) {
+    const int customerCount = route.size() - 2;
+    if (customerCount <= exactCustomers || customerCount < 3) {
+        return 0;
+    }
+    LongRouteTour tour = BuildLongRouteTour(route);
+    const std::size_t nodeCount = tour.nodes.size();
+    std::deque<int> active;
+    std::vector<bool> queued(nodeCount, true);
+    for (int node = 1; std::cmp_less(node, nodeCount); ++node) {
+        active.push_back(node);
+    }
+    std::vector<int> touched;
+    bool changed = false;
+    while (!active.empty()) {
+        const int node = active.front();
+        active.pop_front();
+        queued[static_cast<std::size_t>(node)] = false;
+        PerfCounters::AddCandidates(tour.nearest[static_cast<std::size_t>(node)].size());
+        for (const int neighbor : tour.nearest[static_cast<std::size_t>(node)]) {
+            if (!TryTwoOptMove(tour, node, neighbor, touched) && !TryOrOptMove(tour, node, neighbor, touched)) {
+                continue;
+            }
+            changed = true;
+            for (const int endpoint : touched) {
+                if (endpoint != 0 && !queued[static_cast<std::size_t>(endpoint)]) {
+                    queued[static_cast<std::size_t>(endpoint)] = true;
+                    active.push_back(endpoint);
+                }
+            }
+            break;
         }
     }
-    if (bestLast < 0 || bestCost >= route.GetTotalCost()) {
+    if (!changed) {
         return 0;
     }
-    std::vector<Customer> ordered;
-    ordered.reserve(count);
-    std::size_t mask = allVisited;
-    int current = bestLast;
-    // Walk parent pointers backward from the cheapest final customer.
-    while (current >= 0) {
-        ordered.push_back(customers[static_cast<std::size_t>(current)]);
-        const int previous = parent[mask][static_cast<std::size_t>(current)];
-        // Clear the bit for the customer we just consumed.
-        mask ^= std::size_t{1} << static_cast<std::size_t>(current);
-        current = previous;
-    }
-    std::ranges::reverse(ordered);
     std::list<Customer> rebuilt;
-    rebuilt.push_back(depot);
-    std::ranges::copy(ordered, std::back_inserter(rebuilt));
-    rebuilt.push_back(depot);
+    for (const int node : tour.order) {
+        rebuilt.push_back(tour.nodes[static_cast<std::size_t>(node)]);
+    }
     Route candidate = route;
-    if (!candidate.RebuildRoute(rebuilt)) {
+    if (!candidate.RebuildRoute(rebuilt) || candidate.GetTotalCost() >= route.GetTotalCost()) {
         return 0;
     }
     const int improvement = route.GetTotalCost() - candidate.GetTotalCost();
@@ -1793,6 +2008,19 @@ int OptimizeSingleRouteTsp(Route& route, int maxCustomers) {
     return improvement;
 }
 
+/** @brief Polish the long routes an LNS repair created or modified.
+ *
+ * Routes are matched by index and modification epoch, so routes the repair
+ * left untouched are not searched again.
+ */
+void PolishRepairedRoutes(const Routes& original, Routes& repaired) {
+    for (std::size_t index = 0; index < repaired.size(); ++index) {
+        if (index >= original.size() || repaired[index].GetEpoch() != original[index].GetEpoch()) {
+            PolishLongRoute(repaired[index], HeldKarp::ExactRouteCustomers);
+        }
+    }
+}
+
 /** @brief Find the best two-route angular repartition for a potentially large route pair. */
 std::optional<PairSplit> FindBestPairSweepSplit(const Route& source, const Route& dest, int sourceIndex,
                                                 int destIndex) {
@@ -2220,16 +2448,17 @@ std::optional<RouteClusterSplit> FindBestCyclicExchange(const std::array<RouteSn
     return best;
 }
 
-/** @brief Evaluate one ruin-and-recreate candidate on a route copy.
+/** @brief Evaluate one ruin-and-recreate candidate into a scratch route buffer.
  *
  * The selected customers are removed together, empty depot-only routes are kept
  * available, and the removed customers are then reinserted globally in best
- * feasible positions.
+ * feasible positions. The scratch buffer is overwritten by copy assignment so
+ * its route storage is reused across candidates.
  * Only strict total-cost improvements are returned to the caller.
  */
-std::optional<RuinRecreateResult> EvaluateRuinRecreate(const Routes& routes, const std::vector<RuinCustomer>& customers,
-                                                       std::size_t sequence) {
-    Routes candidate = routes;
+std::optional<int> EvaluateRuinRecreate(const Routes& routes, const std::vector<RuinCustomer>& customers,
+                                        Routes& candidate) {
+    candidate = routes;
     const int originalCost = TotalRouteCost(routes);
     for (const RuinCustomer& customer : customers) {
         for (Route& route : candidate) {
@@ -2253,21 +2482,18 @@ std::optional<RuinRecreateResult> EvaluateRuinRecreate(const Routes& routes, con
             return std::nullopt;
         }
     }
+    PolishRepairedRoutes(routes, candidate);
     const int candidateCost = TotalRouteCost(candidate);
     if (candidateCost >= originalCost) {
         return std::nullopt;
     }
-    return RuinRecreateResult{
-        .routes = candidate,
-        .improvement = originalCost - candidateCost,
-        .sequence = sequence,
-    };
+    return originalCost - candidateCost;
 }
 
-/** @brief Evaluate one related-customer ruin-and-recreate candidate. */
-std::optional<RuinRecreateResult>
-EvaluateRelatedRuinRecreate(const Routes& routes, const std::vector<Customer>& customers, std::size_t sequence) {
-    Routes candidate = routes;
+/** @brief Evaluate one related-customer ruin-and-recreate candidate into a scratch buffer. */
+std::optional<int> EvaluateRelatedRuinRecreate(const Routes& routes, const std::vector<Customer>& customers,
+                                               Routes& candidate) {
+    candidate = routes;
     const int originalCost = TotalRouteCost(routes);
     for (const Customer& customer : customers) {
         for (Route& route : candidate) {
@@ -2279,22 +2505,18 @@ EvaluateRelatedRuinRecreate(const Routes& routes, const std::vector<Customer>& c
     if (candidate.empty() || !InsertCustomersRegret(candidate, customers)) {
         return std::nullopt;
     }
+    PolishRepairedRoutes(routes, candidate);
     const int candidateCost = TotalRouteCost(candidate);
     if (candidateCost >= originalCost) {
         return std::nullopt;
     }
-    return RuinRecreateResult{
-        .routes = std::move(candidate),
-        .improvement = originalCost - candidateCost,
-        .sequence = sequence,
-    };
+    return originalCost - candidateCost;
 }
 
-/** @brief Evaluate one related-customer ruin-and-recreate candidate with beam insertion. */
-std::optional<RuinRecreateResult> EvaluateRelatedBeamRuinRecreate(const Routes& routes,
-                                                                  const std::vector<Customer>& customers,
-                                                                  std::size_t sequence, int beamWidth) {
-    Routes candidate = routes;
+/** @brief Evaluate one related-customer beam ruin-and-recreate candidate into a scratch buffer. */
+std::optional<int> EvaluateRelatedBeamRuinRecreate(const Routes& routes, const std::vector<Customer>& customers,
+                                                   int beamWidth, Routes& candidate) {
+    candidate = routes;
     const int originalCost = TotalRouteCost(routes);
     for (const Customer& customer : customers) {
         for (Route& route : candidate) {
@@ -2306,21 +2528,21 @@ std::optional<RuinRecreateResult> EvaluateRelatedBeamRuinRecreate(const Routes&
     if (candidate.empty() || !InsertCustomersBeam(candidate, customers, beamWidth)) {
         return std::nullopt;
     }
+    PolishRepairedRoutes(routes, candidate);
     const int candidateCost = TotalRouteCost(candidate);
     if (candidateCost >= originalCost) {
         return std::nullopt;
     }
-    return RuinRecreateResult{
-        .routes = std::move(candidate),
-        .improvement = originalCost - candidateCost,
-        .sequence = sequence,
-    };
+    return originalCost - candidateCost;
 }
 
-/** @brief Evaluate one related-customer perturbation candidate. */
-std::optional<RuinRecreateResult>
-EvaluateRelatedPerturbation(const Routes& routes, const std::vector<Customer>& customers, std::size_t sequence) {
-    Routes candidate = routes;
+/** @brief Evaluate one related-customer perturbation candidate into a scratch buffer.
+ *
+ * @return The signed cost change, or std::nullopt when no customer changed route
+ */
+std::optional<int> EvaluateRelatedPerturbation(const Routes& routes, const std::vector<Customer>& customers,
+                                               Routes& candidate) {
+    candidate = routes;
     const int originalCost = TotalRouteCost(routes);
     std::map<Customer, std::size_t> originRouteIndex;
     for (const Customer& customer : customers) {
@@ -2344,13 +2566,102 @@ EvaluateRelatedPerturbation(const Routes& routes, const std::vector<Customer>& c
     if (!changedMembership) {
         return std::nullopt;
     }
+    PolishRepairedRoutes(routes, candidate);
     std::erase_if(candidate, [](const Route& route) { return route.size() <= 2; });
-    const int candidateCost = TotalRouteCost(candidate);
-    return RuinRecreateResult{
-        .routes = std::move(candidate),
-        .improvement = originalCost - candidateCost,
-        .sequence = sequence,
-    };
+    return originalCost - TotalRouteCost(candidate);
+}
+
+/** @brief Evaluates one LNS candidate by sequence into a scratch buffer and returns its cost change. */
+using RuinRecreateEvaluator = std::function<std::optional<int>(std::size_t, Routes&)>;
+
+/** @brief Check whether one ruin-and-recreate score beats another, preferring earlier sequences on ties. */
+bool IsBetterRuinRecreate(const RuinRecreateScore& left, const RuinRecreateScore& right) {
+    if (left.improvement != right.improvement) {
+        return left.improvement > right.improvement;
+    }
+    return left.sequence < right.sequence;
+}
+
+/** @brief Evaluate LNS candidates in parallel and return the best one.
+ *
+ * Each worker takes a strided share of the candidate sequences and owns two
+ * route buffers: the scratch it evaluates into and its best result so far.
+ * They are swapped on improvement, so no candidate is copied out. Worker bests
+ * are reduced by improvement, then lowest sequence, which matches a serial scan.
+ * @param[in] candidateCount Number of candidate sequences to evaluate
+ * @param[in] workers Maximum number of threads
+ * @param[in] evaluate Evaluator writing a candidate into a scratch buffer
+ * @return The best candidate with its routes, or std::nullopt when none qualified
+ */
+std::optional<RuinRecreateResult> FindBestRuinRecreate(std::size_t candidateCount, unsigned workers,
+                                                       const RuinRecreateEvaluator& evaluate) {
+    const std::size_t workerCount = std::min<std::size_t>(workers, candidateCount);
+    std::vector<RuinRecreateResult> workerBests;
+    std::mutex workerBestsMutex;
+    ThreadPool pool(static_cast<unsigned>(std::max<std::size_t>(1, workerCount)));
+    for (std::size_t worker = 0; worker < workerCount; ++worker) {
+        pool.AddTask([worker, workerCount, candidateCount, &evaluate, &workerBests, &workerBestsMutex]() {
+            Routes scratch;
+            std::optional<RuinRecreateResult> best;
+            for (std::size_t sequence = worker; sequence < candidateCount; sequence += workerCount) {
+                const std::optional<int> improvement = evaluate(sequence, scratch);
+                if (!improvement.has_value()) {
+                    continue;
+                }
+                const RuinRecreateScore score{.improvement = *improvement, .sequence = sequence};
+                if (best.has_value() && !IsBetterRuinRecreate(score, best->score)) {
+                    continue;
+                }
+                if (!best.has_value()) {
+                    best = RuinRecreateResult{.routes = {}, .score = score};
+                }
+                std::swap(best->routes, scratch);
+                best->score = score;
+            }
+            if (!best.has_value()) {
+                return;
+            }
+            std::scoped_lock lock(workerBestsMutex);
+            workerBests.push_back(std::move(*best));
+        });
+    }
+    pool.JoinAll();
+    const auto best = std::ranges::min_element(workerBests, IsBetterRuinRecreate, &RuinRecreateResult::score);
+    if (best == workerBests.end()) {
+        return std::nullopt;
+    }
+    return std::move(*best);
+}
+
+/** @brief Score LNS candidates in parallel without keeping their routes.
+ *
+ * Used when the caller selects by rank rather than by best score; only the
+ * selected candidate is evaluated again to materialize its routes.
+ * @return Scores of all qualifying candidates, best first
+ */
+std::vector<RuinRecreateScore> ScoreRuinRecreate(std::size_t candidateCount, unsigned workers,
+                                                 const RuinRecreateEvaluator& evaluate) {
+    const std::size_t workerCount = std::min<std::size_t>(workers, candidateCount);
+    std::vector<RuinRecreateScore> scores;
+    std::mutex scoresMutex;
+    ThreadPool pool(static_cast<unsigned>(std::max<std::size_t>(1, workerCount)));
+    for (std::size_t worker = 0; worker < workerCount; ++worker) {
+        pool.AddTask([worker, workerCount, candidateCount, &evaluate, &scores, &scoresMutex]() {
+            Routes scratch;
+            std::vector<RuinRecreateScore> workerScores;
+            for (std::size_t sequence = worker; sequence < candidateCount; sequence += workerCount) {
+                const std::optional<int> improvement = evaluate(sequence, scratch);
+                if (improvement.has_value()) {
+                    workerScores.push_back(RuinRecreateScore{.improvement = *improvement, .sequence = sequence});
+                }
+            }
+            std::scoped_lock lock(scoresMutex);
+            scores.insert(scores.end(), workerScores.cbegin(), workerScores.cend());
+        });
+    }
+    pool.JoinAll();
+    std::ranges::sort(scores, IsBetterRuinRecreate);
+    return scores;
 }
 
 /** @brief Return all customers ordered by polar angle around the depot. */
@@ -2385,13 +2696,14 @@ std::vector<Customer> CollectAngularCustomers(const Routes& routes) {
  * @return Cost improvement if positive, or a negative cost increase when diversified
  */
 int OptimalMove::PerturbAngularRuinRecreate(Routes& routes, int removalCount, int diversificationRank) {
+    PerfCounters::Scope scope(PerfCounters::PerturbAngularRuinRecreate, routes);
     if (removalCount <= 1 || routes.empty()) {
-        Utils::Instance().logger("angular perturbation no move", Utils::VERBOSE);
+        this->Trace("angular perturbation no move");
         return 0;
     }
     const std::vector<Customer> customers = CollectAngularCustomers(routes);
     if (std::cmp_less(customers.size(), removalCount)) {
-        Utils::Instance().logger("angular perturbation no move", Utils::VERBOSE);
+        this->Trace("angular perturbation no move");
         return 0;
     }
 
@@ -2410,13 +2722,13 @@ int OptimalMove::PerturbAngularRuinRecreate(Routes& routes, int removalCount, in
     for (const Customer& customer : removalSet) {
         std::optional<std::size_t> routeIndex = FindCustomerRouteIndex(candidate, customer);
         if (!routeIndex.has_value() || !candidate[*routeIndex].RemoveCustomer(customer)) {
-            Utils::Instance().logger("angular perturbation no move", Utils::VERBOSE);
+            this->Trace("angular perturbation no move");
             return 0;
         }
         originRouteIndex.emplace(customer, *routeIndex);
     }
     if (candidate.empty() || !InsertCustomersRegretAvoidingOrigin(candidate, removalSet, originRouteIndex)) {
-        Utils::Instance().logger("angular perturbation no move", Utils::VERBOSE);
+        this->Trace("angular perturbation no move");
         return 0;
     }
     bool changedMembership = false;
@@ -2428,13 +2740,14 @@ int OptimalMove::PerturbAngularRuinRecreate(Routes& routes, int removalCount, in
         }
     }
     if (!changedMembership) {
-        Utils::Instance().logger("angular perturbation no move", Utils::VERBOSE);
+        this->Trace("angular perturbation no move");
         return 0;
     }
+    PolishRepairedRoutes(routes, candidate);
     routes = std::move(candidate);
     this->CleanVoid(routes);
     const int improvement = originalCost - TotalRouteCost(routes);
-    Utils::Instance().logger("angular perturbation changed: " + std::to_string(improvement), Utils::VERBOSE);
+    this->Trace("angular perturbation changed: " + std::to_string(improvement));
     return improvement;
 }
 
@@ -2551,11 +2864,98 @@ std::optional<SegmentExchange> FindBestSegmentExchange(const Route& source, cons
     return best;
 }
 
+// Route-pair proximity filter of the customer-exchange neighborhoods. The sector
+// slack is a pseudo-angle (4 is a full turn, so 0.25 is roughly 22 degrees); the
+// bounding-box gap is measured in mean arcs of the sparser of the two routes.
+constexpr float kRouteSectorSlack = 0.25F;
+constexpr float kRouteGapMeanArcs = 1.0F;
+
+/** @brief Return the average arc cost of a route, including both depot legs. */
+float MeanArcCost(const Route& route) {
+    return static_cast<float>(route.GetTotalCost()) / static_cast<float>(std::max(1, route.size() - 1));
+}
+
+/** @brief Mark the ordered route pairs worth evaluating in exchange neighborhoods.
+ *
+ * The result is a row-major routes x routes matrix. Routes on opposite sides of
+ * the depot almost never trade customers profitably, so only pairs whose polar
+ * sectors overlap, or whose bounding boxes are about one arc apart, are kept.
+ * This keeps the route-pair graph close to linear in the number of routes.
+ */
+std::vector<bool> BuildNearRoutePairs(const Routes& routes) {
+    const std::size_t routeCount = routes.size();
+    std::vector<bool> nearPairs(routeCount * routeCount, false);
+    for (std::size_t i = 0; i < routeCount; ++i) {
+        for (std::size_t j = i + 1; j < routeCount; ++j) {
+            const float distanceSlack = kRouteGapMeanArcs * std::max(MeanArcCost(routes[i]), MeanArcCost(routes[j]));
+            if (routes[i].IsSpatiallyNear(routes[j], kRouteSectorSlack, distanceSlack)) {
+                nearPairs[(i * routeCount) + j] = true;
+                nearPairs[(j * routeCount) + i] = true;
+            }
+        }
+    }
+    return nearPairs;
+}
+
+/** @brief Send a line of the search trace to the run logger, if the engine has one.
+ *
+ * @param[in] message Trace line, shown only in verbose runs
+ */
+void OptimalMove::Trace(const std::string& message) const {
+    if (this->utils != nullptr) {
+        this->utils->logger(message, Utils::VERBOSE);
+    }
+}
+
 /** @brief Remove all void routes. */
 void OptimalMove::CleanVoid(Routes& routes) {
     std::erase_if(routes, [](const Route& r) { return r.size() <= 2; });
 }
 
+/** @brief Insert customers that no route serves yet.
+ *
+ * Customers with the fewest and most unequal options are placed first, so
+ * scarce capacity is not spent on customers that fit almost anywhere.
+ * @param[in,out] routes Routes receiving the customers; partially filled on failure
+ * @param[in] customers Customers to insert
+ * @param[in] regretDegree Number of cheapest routes compared by the regret
+ * @return false when some customer fits no route
+ */
+bool OptimalMove::InsertRegret(Routes& routes, const std::vector<Customer>& customers, int regretDegree) {
+    PerfCounters::Scope scope(PerfCounters::InsertRegret, routes);
+    return InsertCustomersRegret(routes, customers, regretDegree);
+}
+
+// Don't-look tags: pairwise neighborhoods that run the same evaluation share a
+// tag, so Opt12 and OptExchange(1, 2) reuse each other's proofs.
+constexpr int kMoveDontLookTag = 1;
+constexpr int kSwapDontLookTag = 2;
+constexpr int kSwapStarDontLookTag = 3;
+
+/** @brief Return the don't-look tag of an n-for-m group exchange. */
+constexpr int ExchangeDontLookTag(int nInsert, int nRemove) { return (100 * nInsert) + nRemove; }
+
+/** @brief Check whether a route pair was proven non-improving at the current route epochs. */
+bool DontLookPairs::Contains(int neighborhood, const Route& source, const Route& dest) const {
+    return this->entries.contains({neighborhood, source.GetEpoch(), dest.GetEpoch()});
+}
+
+/** @brief Remember route pairs that produced no improving move at their current epochs.
+ *
+ * @param[in] neighborhood Neighborhood tag
+ * @param[in] routes Routes the pair indexes refer to, before any move is applied
+ * @param[in] pairs Ordered source/destination route indexes
+ */
+void DontLookPairs::Insert(int neighborhood, const Routes& routes, const std::vector<std::pair<int, int>>& pairs) {
+    if (this->entries.size() + pairs.size() > MaxEntries) {
+        this->entries.clear();
+    }
+    for (const auto& [source, dest] : pairs) {
+        this->entries.emplace(neighborhood, routes[static_cast<std::size_t>(source)].GetEpoch(),
+                              routes[static_cast<std::size_t>(dest)].GetEpoch());
+    }
+}
+
 /** @brief Move one customer from each source route to a destination route.
  *
  * This opt function try to move, for every route, a customer
@@ -2563,18 +2963,26 @@ void OptimalMove::CleanVoid(Routes& routes) {
  * @return True if the routes are improved
  */
 int OptimalMove::Opt10(Routes& routes, bool force) {
+    PerfCounters::Scope scope(PerfCounters::Opt10, routes);
     int diffCost = -1;
     Routes::iterator it = routes.begin();
     std::set<BestResult, decltype(comp)> b(comp);
     bool flag = false;
     // pool of threads
+    const std::vector<bool> nearPairs = BuildNearRoutePairs(routes);
+    const int dontLookTag = kMoveDontLookTag;
+    std::vector<std::pair<int, int>> nonImproving;
     ThreadPool pool(this->cores);
     for (int i = 0; it != routes.end(); std::advance(it, 1), ++i) {
         Routes::const_iterator jt = routes.cbegin();
         for (int j = 0; jt != routes.cend(); std::advance(jt, 1), ++j) {
-            if (jt != it) {
+            if (jt != it && nearPairs[(static_cast<std::size_t>(i) * routes.size()) + static_cast<std::size_t>(j)] &&
+                (force || !this->dontLook.Contains(dontLookTag, *it, *jt))) {
                 // create a thread to run Move1FromTo function and save the result in l list
-                pool.AddTask([force, it, jt, i, j, &b, &flag, this]() {
+                pool.AddTask([force, it, jt, i, j, &b, &flag, &nonImproving, this]() {
+                    if (this->StopRequested()) {
+                        return;
+                    }
                     const int originalCost = it->GetTotalCost() + jt->GetTotalCost();
                     Route tFrom = *it;
                     Route tTo = *jt;
@@ -2588,6 +2996,9 @@ int OptimalMove::Opt10(Routes& routes, bool force) {
                                             .source = tFrom,
                                             .dest = tTo});
                         flag = true;
+                    } else if (!force) {
+                        std::scoped_lock lock(this->mtx);
+                        nonImproving.emplace_back(i, j);
                     }
                 });
             }
@@ -2595,13 +3006,14 @@ int OptimalMove::Opt10(Routes& routes, bool force) {
     }
     // wait to finish all threads
     pool.JoinAll();
+    this->dontLook.Insert(dontLookTag, routes, nonImproving);
     // if some improvements are made update the routes
     if (flag) {
         diffCost = ApplyBestResult(routes, b);
         this->CleanVoid(routes);
-        Utils::Instance().logger("opt10 improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->Trace("opt10 improved: " + std::to_string(diffCost));
     } else
-        Utils::Instance().logger("opt10 no improvement", Utils::VERBOSE);
+        this->Trace("opt10 no improvement");
     return diffCost;
 }
 
@@ -2619,11 +3031,12 @@ bool OptimalMove::Move1FromTo(Route& source, Route& dest, bool force) {
     bool ret = false;
     int bestCost = source.GetTotalCost() + dest.GetTotalCost();
     Route bestDestRoute = dest, bestSourceRoute = source;
-    RouteList::iterator itSource = source.GetRoute()->begin();
+    const RouteList& sourceSteps = *std::as_const(source).GetRoute();
+    RouteList::const_iterator itSource = sourceSteps.cbegin();
     // cannot move the depot
     std::advance(itSource, 1);
     // for each position in source route
-    for (unsigned i = 1; i < (source.GetRoute()->size() - 1); ++itSource, ++i) {
+    for (unsigned i = 1; i < (sourceSteps.size() - 1); ++itSource, ++i) {
         // copy the destination route to try some path configuration
         Route tempDest = dest;
         Route tempSource = source;
@@ -2654,16 +3067,24 @@ bool OptimalMove::Move1FromTo(Route& source, Route& dest, bool force) {
  * @return True if the routes are improves
  */
 int OptimalMove::Opt11(Routes& routes, bool force) {
+    PerfCounters::Scope scope(PerfCounters::Opt11, routes);
     int diffCost = -1;
     Routes::iterator it = routes.begin();
     std::set<BestResult, decltype(comp)> b(comp);
     bool flag = false;
+    const std::vector<bool> nearPairs = BuildNearRoutePairs(routes);
+    const int dontLookTag = kSwapDontLookTag;
+    std::vector<std::pair<int, int>> nonImproving;
     ThreadPool pool(this->cores);
     for (int i = 0; it != routes.end(); std::advance(it, 1), ++i) {
         Routes::const_iterator jt = routes.cbegin();
         for (int j = 0; jt != routes.cend(); std::advance(jt, 1), ++j) {
-            if (jt != it) {
-                pool.AddTask([force, it, jt, i, j, &b, &flag, this]() {
+            if (jt != it && nearPairs[(static_cast<std::size_t>(i) * routes.size()) + static_cast<std::size_t>(j)] &&
+                (force || !this->dontLook.Contains(dontLookTag, *it, *jt))) {
+                pool.AddTask([force, it, jt, i, j, &b, &flag, &nonImproving, this]() {
+                    if (this->StopRequested()) {
+                        return;
+                    }
                     const int originalCost = it->GetTotalCost() + jt->GetTotalCost();
                     Route tFrom = *it;
                     Route tTo = *jt;
@@ -2676,18 +3097,22 @@ int OptimalMove::Opt11(Routes& routes, bool force) {
                                             .source = tFrom,
                                             .dest = tTo});
                         flag = true;
+                    } else if (!force) {
+                        std::scoped_lock lock(this->mtx);
+                        nonImproving.emplace_back(i, j);
                     }
                 });
             }
         }
     }
     pool.JoinAll();
+    this->dontLook.Insert(dontLookTag, routes, nonImproving);
     if (flag) {
         diffCost = ApplyBestResult(routes, b);
         this->CleanVoid(routes);
-        Utils::Instance().logger("opt11 improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->Trace("opt11 improved: " + std::to_string(diffCost));
     } else
-        Utils::Instance().logger("opt11 no improvement", Utils::VERBOSE);
+        this->Trace("opt11 no improvement");
     return diffCost;
 }
 
@@ -2703,15 +3128,17 @@ bool OptimalMove::SwapFromTo(Route& source, Route& dest, bool force) {
     bool ret = false;
     int bestCost = source.GetTotalCost() + dest.GetTotalCost();
     Route bestRouteSource = source, bestRouteDest = dest;
-    RouteList::iterator itSource = source.GetRoute()->begin();
+    const RouteList& sourceSteps = *std::as_const(source).GetRoute();
+    const RouteList& destSteps = *std::as_const(dest).GetRoute();
+    RouteList::const_iterator itSource = sourceSteps.cbegin();
     // cannot move the depot (start)
     std::advance(itSource, 1);
     // for each customer in the source route try to move it to the next route
-    for (unsigned i = 1; i < (source.GetRoute()->size() - 1); std::advance(itSource, 1), i++) {
-        RouteList::iterator itDest = dest.GetRoute()->begin();
+    for (unsigned i = 1; i < (sourceSteps.size() - 1); std::advance(itSource, 1), i++) {
+        RouteList::const_iterator itDest = destSteps.cbegin();
         std::advance(itDest, 1);
         // cannot move the depot (end)
-        for (unsigned j = 1; j < (dest.GetRoute()->size() - 1); std::advance(itDest, 1), j++) {
+        for (unsigned j = 1; j < (destSteps.size() - 1); std::advance(itDest, 1), j++) {
             // copy the destination route to try some path configuration
             Route tempDest = dest;
             // copy the source route to check out if this configuration is valid and better
@@ -2737,6 +3164,261 @@ bool OptimalMove::SwapFromTo(Route& source, Route& dest, bool force) {
     return ret;
 }
 
+/** @brief One insertion arc of a customer into a route, priced as a detour. */
+struct SwapStarInsertion {
+    int delta = kInsertionInfinity; /**< Detour cost of serving the customer on this arc */
+    int after = -1;                 /**< Index of the step the customer is inserted after */
+};
+
+/** @brief The three cheapest insertion arcs of one customer into one route, cheapest first. */
+using SwapStarTopInsertions = std::array<SwapStarInsertion, 3>;
+
+/** @brief Improving SWAP* exchange of the customers at two route steps. */
+struct SwapStarMove {
+    int delta;             /**< Combined cost change of both routes */
+    std::size_t source;    /**< Step of the customer leaving the source route */
+    std::size_t dest;      /**< Step of the customer leaving the destination route */
+    int sourceInsertAfter; /**< Source step the incoming customer follows */
+    int destInsertAfter;   /**< Destination step the incoming customer follows */
+};
+
+/** @brief Keep the three cheapest insertion arcs of a customer into a route.
+ *
+ * Ties keep the earliest arc, matching Route::AddElem.
+ * @param[in] route Route receiving the customer
+ * @param[in] customer Customer to price
+ * @return Cheapest arcs in increasing detour order
+ */
+SwapStarTopInsertions FindTopInsertions(const Route& route, const Customer& customer) {
+    const RouteList& steps = *route.GetRoute();
+    SwapStarTopInsertions top{};
+    PerfCounters::AddCandidates(steps.size() - 1);
+    for (std::size_t after = 0; after + 1 < steps.size(); ++after) {
+        SwapStarInsertion candidate{
+            .delta = route.GetTravelCost(steps[after].first, customer) +
+                     route.GetTravelCost(customer, steps[after + 1].first) - steps[after].second,
+            .after = static_cast<int>(after),
+        };
+        for (SwapStarInsertion& slot : top) {
+            if (candidate.delta < slot.delta) {
+                std::swap(candidate, slot);
+            }
+        }
+    }
+    return top;
+}
+
+/** @brief Price the cheapest insertion of a customer once one step is removed from the route.
+ *
+ * Removing a step invalidates only the two arcs around it, so at least one of
+ * the three cached arcs is still present; the arc bridging the gap, i.e. the
+ * position of the removed customer, is the only new one and is priced directly.
+ * @param[in] route Route receiving the customer
+ * @param[in] top Cached cheapest arcs of the customer into the full route
+ * @param[in] customer Customer to insert
+ * @param[in] removed Step removed from the route
+ * @return Detour over the route without the removed step, and the step to insert after
+ */
+SwapStarInsertion BestInsertionWithout(const Route& route, const SwapStarTopInsertions& top, const Customer& customer,
+                                       std::size_t removed) {
+    const RouteList& steps = *route.GetRoute();
+    const Customer& previous = steps[removed - 1].first;
+    const Customer& next = steps[removed + 1].first;
+    SwapStarInsertion best{
+        .delta = route.GetTravelCost(previous, customer) + route.GetTravelCost(customer, next) -
+                 route.GetTravelCost(previous, next),
+        .after = static_cast<int>(removed) - 1,
+    };
+    for (const SwapStarInsertion& slot : top) {
+        if (slot.after < 0 || slot.after == best.after || slot.after == static_cast<int>(removed)) {
+            continue;
+        }
+        if (slot.delta < best.delta) {
+            best = slot;
+        }
+        break;
+    }
+    return best;
+}
+
+/** @brief Return the cost saved by removing the customer at one route step. */
+int RemovalGain(const Route& route, std::size_t step) {
+    const RouteList& steps = *route.GetRoute();
+    return steps[step - 1].second + steps[step].second -
+           route.GetTravelCost(steps[step - 1].first, steps[step + 1].first);
+}
+
+/** @brief Return the demand served by a route. */
+int RouteLoad(const Route& route) {
+    int load = 0;
+    for (const StepType& step : *route.GetRoute()) {
+        load += step.first.request;
+    }
+    return load;
+}
+
+/** @brief Build the customer sequence of a route after replacing one step.
+ * @param[in] route Route to copy
+ * @param[in] removed Step whose customer leaves the route
+ * @param[in] inserted Customer entering the route
+ * @param[in] insertAfter Step the entering customer follows
+ * @return Depot-to-depot customer list
+ */
+std::list<Customer> SwapStarSequence(const Route& route, std::size_t removed, const Customer& inserted,
+                                     int insertAfter) {
+    const RouteList& steps = *route.GetRoute();
+    std::list<Customer> sequence;
+    for (std::size_t step = 0; step < steps.size(); ++step) {
+        if (step != removed) {
+            sequence.push_back(steps[step].first);
+        }
+        if (static_cast<int>(step) == insertAfter) {
+            sequence.push_back(inserted);
+        }
+    }
+    return sequence;
+}
+
+/** @brief Find the best SWAP* exchange between two routes.
+ *
+ * The cheapest insertion arcs of every customer into the other route are
+ * computed once, so each of the |source| x |dest| exchanges is priced in
+ * constant time instead of copying both routes and rescanning them. Capacity
+ * is checked before pricing; the work-time limit is checked when the winning
+ * exchange is rebuilt, falling back to the next improving one if it fails.
+ * @param[in] source First route
+ * @param[in] dest Second route
+ * @return Replacement routes with positive improvement, or std::nullopt
+ */
+std::optional<TwoOptStarRoutes> FindBestSwapStar(const Route& source, const Route& dest) {
+    const RouteList& sourceSteps = *source.GetRoute();
+    const RouteList& destSteps = *dest.GetRoute();
+    if (sourceSteps.size() <= 2 || destSteps.size() <= 2) {
+        return std::nullopt;
+    }
+    const std::size_t sourceLast = sourceSteps.size() - 1;
+    const std::size_t destLast = destSteps.size() - 1;
+    std::vector<SwapStarTopInsertions> sourceIntoDest(sourceLast);
+    std::vector<int> sourceGain(sourceLast);
+    for (std::size_t step = 1; step < sourceLast; ++step) {
+        sourceIntoDest[step] = FindTopInsertions(dest, sourceSteps[step].first);
+        sourceGain[step] = RemovalGain(source, step);
+    }
+    std::vector<SwapStarTopInsertions> destIntoSource(destLast);
+    std::vector<int> destGain(destLast);
+    for (std::size_t step = 1; step < destLast; ++step) {
+        destIntoSource[step] = FindTopInsertions(source, destSteps[step].first);
+        destGain[step] = RemovalGain(dest, step);
+    }
+
+    const int capacity = source.GetInitialCapacity();
+    const int sourceLoad = RouteLoad(source);
+    const int destLoad = RouteLoad(dest);
+    std::vector<SwapStarMove> moves;
+    for (std::size_t sourceStep = 1; sourceStep < sourceLast; ++sourceStep) {
+        const Customer& leaving = sourceSteps[sourceStep].first;
+        for (std::size_t destStep = 1; destStep < destLast; ++destStep) {
+            const Customer& entering = destSteps[destStep].first;
+            const int transfer = entering.request - leaving.request;
+            if (sourceLoad + transfer > capacity || destLoad - transfer > capacity) {
+                continue;
+            }
+            const SwapStarInsertion intoDest =
+                BestInsertionWithout(dest, sourceIntoDest[sourceStep], leaving, destStep);
+            const SwapStarInsertion intoSource =
+                BestInsertionWithout(source, destIntoSource[destStep], entering, sourceStep);
+            const int delta = intoDest.delta + intoSource.delta - sourceGain[sourceStep] - destGain[destStep];
+            if (delta < 0) {
+                moves.push_back(SwapStarMove{.delta = delta,
+                                             .source = sourceStep,
+                                             .dest = destStep,
+                                             .sourceInsertAfter = intoSource.after,
+                                             .destInsertAfter = intoDest.after});
+            }
+        }
+    }
+    // Scan order breaks ties, so the result does not depend on the sort.
+    std::ranges::stable_sort(moves, {}, &SwapStarMove::delta);
+    for (const SwapStarMove& move : moves) {
+        Route newSource = source;
+        Route newDest = dest;
+        if (newSource.RebuildRoute(SwapStarSequence(source, move.source, destSteps[move.dest].first,
+                                                    move.sourceInsertAfter)) &&
+            newDest.RebuildRoute(SwapStarSequence(dest, move.dest, sourceSteps[move.source].first,
+                                                  move.destInsertAfter))) {
+            return TwoOptStarRoutes{
+                .source = std::move(newSource), .dest = std::move(newDest), .improvement = -move.delta};
+        }
+    }
+    return std::nullopt;
+}
+
+/** @brief Swap two customers between routes, each reinserted at its best position.
+ *
+ * SWAP* as in HGS-CVRP: every unordered pair of spatially near routes is
+ * priced with cached top-three insertion arcs, and pairs unchanged since they
+ * were last proven non-improving are skipped. The best exchange over all
+ * pairs is applied.
+ * @param[in] routes The routes to edit
+ * @return Positive cost reduction if routes are improved, otherwise -1
+ */
+int OptimalMove::OptSwapStar(Routes& routes) {
+    PerfCounters::Scope scope(PerfCounters::SwapStar, routes);
+    const std::vector<bool> nearPairs = BuildNearRoutePairs(routes);
+    const int dontLookTag = kSwapStarDontLookTag;
+    std::vector<IndexedTwoOptStarRoutes> candidates;
+    std::vector<std::pair<int, int>> nonImproving;
+    ThreadPool pool(this->cores);
+    for (std::size_t sourceIndex = 0; sourceIndex < routes.size(); ++sourceIndex) {
+        for (std::size_t destIndex = sourceIndex + 1; destIndex < routes.size(); ++destIndex) {
+            if (!nearPairs[(sourceIndex * routes.size()) + destIndex] ||
+                this->dontLook.Contains(dontLookTag, routes[sourceIndex], routes[destIndex])) {
+                continue;
+            }
+            pool.AddTask([&routes, sourceIndex, destIndex, &candidates, &nonImproving, this]() {
+                if (this->StopRequested()) {
+                    return;
+                }
+                std::optional<TwoOptStarRoutes> candidate = FindBestSwapStar(routes[sourceIndex], routes[destIndex]);
+                std::scoped_lock lock(this->mtx);
+                if (!candidate.has_value()) {
+                    nonImproving.emplace_back(static_cast<int>(sourceIndex), static_cast<int>(destIndex));
+                    return;
+                }
+                candidates.emplace_back(IndexedTwoOptStarRoutes{
+                    .source = std::move(candidate->source),
+                    .dest = std::move(candidate->dest),
+                    .sourceIndex = static_cast<int>(sourceIndex),
+                    .destIndex = static_cast<int>(destIndex),
+                    .improvement = candidate->improvement,
+                });
+            });
+        }
+    }
+    pool.JoinAll();
+    this->dontLook.Insert(dontLookTag, routes, nonImproving);
+    const auto best = std::ranges::max_element(
+        candidates, [](const IndexedTwoOptStarRoutes& left, const IndexedTwoOptStarRoutes& right) {
+            if (left.improvement != right.improvement) {
+                return left.improvement < right.improvement;
+            }
+            if (left.sourceIndex != right.sourceIndex) {
+                return left.sourceIndex > right.sourceIndex;
+            }
+            return left.destIndex > right.destIndex;
+        });
+    if (best == candidates.end()) {
+        this->Trace("swap* no improvement");
+        return -1;
+    }
+    const int improvement = best->improvement;
+    routes[static_cast<std::size_t>(best->sourceIndex)] = std::move(best->source);
+    routes[static_cast<std::size_t>(best->destIndex)] = std::move(best->dest);
+    this->CleanVoid(routes);
+    this->Trace("swap* improved: " + std::to_string(improvement));
+    return improvement;
+}
+
 /** @brief Move one customer from source while removing two from destination.
  *
  * This function swap two customers from the routes and moves one
@@ -2746,16 +3428,24 @@ bool OptimalMove::SwapFromTo(Route& source, Route& dest, bool force) {
  * @return True if the routes are improves
  */
 int OptimalMove::Opt12(Routes& routes, bool force) {
+    PerfCounters::Scope scope(PerfCounters::Opt12, routes);
     int diffCost = -1;
     Routes::iterator it = routes.begin();
     std::set<BestResult, decltype(comp)> b(comp);
     bool flag = false;
+    const std::vector<bool> nearPairs = BuildNearRoutePairs(routes);
+    const int dontLookTag = ExchangeDontLookTag(1, 2);
+    std::vector<std::pair<int, int>> nonImproving;
     ThreadPool pool(this->cores);
     for (int i = 0; it != routes.end(); std::advance(it, 1), ++i) {
         Routes::const_iterator jt = routes.cbegin();
         for (int j = 0; jt != routes.cend(); std::advance(jt, 1), ++j) {
-            if (jt != it) {
-                pool.AddTask([force, it, jt, i, j, &b, &flag, this]() {
+            if (jt != it && nearPairs[(static_cast<std::size_t>(i) * routes.size()) + static_cast<std::size_t>(j)] &&
+                (force || !this->dontLook.Contains(dontLookTag, *it, *jt))) {
+                pool.AddTask([force, it, jt, i, j, &b, &flag, &nonImproving, this]() {
+                    if (this->StopRequested()) {
+                        return;
+                    }
                     const int originalCost = it->GetTotalCost() + jt->GetTotalCost();
                     Route tFrom = *it;
                     Route tTo = *jt;
@@ -2768,18 +3458,22 @@ int OptimalMove::Opt12(Routes& routes, bool force) {
                                             .source = tFrom,
                                             .dest = tTo});
                         flag = true;
+                    } else if (!force) {
+                        std::scoped_lock lock(this->mtx);
+                        nonImproving.emplace_back(i, j);
                     }
                 });
             }
         }
     }
     pool.JoinAll();
+    this->dontLook.Insert(dontLookTag, routes, nonImproving);
     if (flag) {
         diffCost = ApplyBestResult(routes, b);
         this->CleanVoid(routes);
-        Utils::Instance().logger("opt12 improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->Trace("opt12 improved: " + std::to_string(diffCost));
     } else
-        Utils::Instance().logger("opt12 no improvement", Utils::VERBOSE);
+        this->Trace("opt12 no improvement");
     return diffCost;
 }
 
@@ -2834,16 +3528,24 @@ bool OptimalMove::AddRemoveFromTo(Route& source, Route& dest, int nInsert, int n
  * @return True if the routes are improves
  */
 int OptimalMove::Opt21(Routes& routes, bool force) {
+    PerfCounters::Scope scope(PerfCounters::Opt21, routes);
     int diffCost = -1;
     Routes::iterator it = routes.begin();
     std::set<BestResult, decltype(comp)> b(comp);
     bool flag = false;
+    const std::vector<bool> nearPairs = BuildNearRoutePairs(routes);
+    const int dontLookTag = ExchangeDontLookTag(2, 1);
+    std::vector<std::pair<int, int>> nonImproving;
     ThreadPool pool(this->cores);
     for (int i = 0; it != routes.end(); std::advance(it, 1), ++i) {
         Routes::const_iterator jt = routes.cbegin();
         for (int j = 0; jt != routes.cend(); std::advance(jt, 1), ++j) {
-            if (jt != it) {
-                pool.AddTask([force, it, jt, i, j, &b, &flag, this]() {
+            if (jt != it && nearPairs[(static_cast<std::size_t>(i) * routes.size()) + static_cast<std::size_t>(j)] &&
+                (force || !this->dontLook.Contains(dontLookTag, *it, *jt))) {
+                pool.AddTask([force, it, jt, i, j, &b, &flag, &nonImproving, this]() {
+                    if (this->StopRequested()) {
+                        return;
+                    }
                     const int originalCost = it->GetTotalCost() + jt->GetTotalCost();
                     Route tFrom = *it;
                     Route tTo = *jt;
@@ -2856,18 +3558,22 @@ int OptimalMove::Opt21(Routes& routes, bool force) {
                                             .source = tFrom,
                                             .dest = tTo});
                         flag = true;
+                    } else if (!force) {
+                        std::scoped_lock lock(this->mtx);
+                        nonImproving.emplace_back(i, j);
                     }
                 });
             }
         }
     }
     pool.JoinAll();
+    this->dontLook.Insert(dontLookTag, routes, nonImproving);
     if (flag) {
         diffCost = ApplyBestResult(routes, b);
         this->CleanVoid(routes);
-        Utils::Instance().logger("opt21 improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->Trace("opt21 improved: " + std::to_string(diffCost));
     } else
-        Utils::Instance().logger("opt21 no improvement", Utils::VERBOSE);
+        this->Trace("opt21 no improvement");
     return diffCost;
 }
 
@@ -2880,16 +3586,24 @@ int OptimalMove::Opt21(Routes& routes, bool force) {
  * @return True if the routes are improved
  */
 int OptimalMove::Opt22(Routes& routes, bool force) {
+    PerfCounters::Scope scope(PerfCounters::Opt22, routes);
     int diffCost = -1;
     Routes::iterator it = routes.begin();
     std::set<BestResult, decltype(comp)> b(comp);
     bool flag = false;
+    const std::vector<bool> nearPairs = BuildNearRoutePairs(routes);
+    const int dontLookTag = ExchangeDontLookTag(2, 2);
+    std::vector<std::pair<int, int>> nonImproving;
     ThreadPool pool(this->cores);
     for (int i = 0; it != routes.end(); std::advance(it, 1), ++i) {
         Routes::const_iterator jt = routes.cbegin();
         for (int j = 0; jt != routes.cend(); std::advance(jt, 1), ++j) {
-            if (jt != it) {
-                pool.AddTask([force, it, jt, i, j, &b, &flag, this]() {
+            if (jt != it && nearPairs[(static_cast<std::size_t>(i) * routes.size()) + static_cast<std::size_t>(j)] &&
+                (force || !this->dontLook.Contains(dontLookTag, *it, *jt))) {
+                pool.AddTask([force, it, jt, i, j, &b, &flag, &nonImproving, this]() {
+                    if (this->StopRequested()) {
+                        return;
+                    }
                     const int originalCost = it->GetTotalCost() + jt->GetTotalCost();
                     Route tFrom = *it;
                     Route tTo = *jt;
@@ -2902,18 +3616,22 @@ int OptimalMove::Opt22(Routes& routes, bool force) {
                                             .source = tFrom,
                                             .dest = tTo});
                         flag = true;
+                    } else if (!force) {
+                        std::scoped_lock lock(this->mtx);
+                        nonImproving.emplace_back(i, j);
                     }
                 });
             }
         }
     }
     pool.JoinAll();
+    this->dontLook.Insert(dontLookTag, routes, nonImproving);
     if (flag) {
         diffCost = ApplyBestResult(routes, b);
         this->CleanVoid(routes);
-        Utils::Instance().logger("opt22 improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->Trace("opt22 improved: " + std::to_string(diffCost));
     } else
-        Utils::Instance().logger("opt22 no improvement", Utils::VERBOSE);
+        this->Trace("opt22 no improvement");
     return diffCost;
 }
 
@@ -2929,16 +3647,24 @@ int OptimalMove::Opt22(Routes& routes, bool force) {
  * @return Cost reduction if a move is applied, otherwise -1
  */
 int OptimalMove::OptExchange(Routes& routes, int nInsert, int nRemove, bool force) {
+    PerfCounters::Scope scope(PerfCounters::Exchange, routes);
     int diffCost = -1;
     Routes::iterator it = routes.begin();
     std::set<BestResult, decltype(comp)> b(comp);
     bool flag = false;
+    const std::vector<bool> nearPairs = BuildNearRoutePairs(routes);
+    const int dontLookTag = ExchangeDontLookTag(nInsert, nRemove);
+    std::vector<std::pair<int, int>> nonImproving;
     ThreadPool pool(this->cores);
     for (int i = 0; it != routes.end(); std::advance(it, 1), ++i) {
         Routes::const_iterator jt = routes.cbegin();
         for (int j = 0; jt != routes.cend(); std::advance(jt, 1), ++j) {
-            if (jt != it) {
-                pool.AddTask([force, nInsert, nRemove, it, jt, i, j, &b, &flag, this]() {
+            if (jt != it && nearPairs[(static_cast<std::size_t>(i) * routes.size()) + static_cast<std::size_t>(j)] &&
+                (force || !this->dontLook.Contains(dontLookTag, *it, *jt))) {
+                pool.AddTask([force, nInsert, nRemove, it, jt, i, j, &b, &flag, &nonImproving, this]() {
+                    if (this->StopRequested()) {
+                        return;
+                    }
                     const int originalCost = it->GetTotalCost() + jt->GetTotalCost();
                     Route tFrom = *it;
                     Route tTo = *jt;
@@ -2950,21 +3676,23 @@ int OptimalMove::OptExchange(Routes& routes, int nInsert, int nRemove, bool forc
                                             .source = tFrom,
                                             .dest = tTo});
                         flag = true;
+                    } else if (!force) {
+                        std::scoped_lock lock(this->mtx);
+                        nonImproving.emplace_back(i, j);
                     }
                 });
             }
         }
     }
     pool.JoinAll();
+    this->dontLook.Insert(dontLookTag, routes, nonImproving);
     if (flag) {
         diffCost = ApplyBestResult(routes, b);
         this->CleanVoid(routes);
-        Utils::Instance().logger("opt" + std::to_string(nInsert) + std::to_string(nRemove) +
-                                     " improved: " + std::to_string(diffCost),
-                                 Utils::VERBOSE);
+        this->Trace("opt" + std::to_string(nInsert) + std::to_string(nRemove) +
+                    " improved: " + std::to_string(diffCost));
     } else {
-        Utils::Instance().logger("opt" + std::to_string(nInsert) + std::to_string(nRemove) + " no improvement",
-                                 Utils::VERBOSE);
+        this->Trace("opt" + std::to_string(nInsert) + std::to_string(nRemove) + " no improvement");
     }
     return diffCost;
 }
@@ -2982,8 +3710,9 @@ int OptimalMove::OptExchange(Routes& routes, int nInsert, int nRemove, bool forc
  * @return Cost reduction if a move is applied, otherwise -1
  */
 int OptimalMove::OptSwapSegments(Routes& routes, int maxSegmentSize, bool force) {
+    PerfCounters::Scope scope(PerfCounters::SwapSegments, routes);
     if (maxSegmentSize <= 0) {
-        Utils::Instance().logger("segment exchange no improvement", Utils::VERBOSE);
+        this->Trace("segment exchange no improvement");
         return -1;
     }
     const std::vector<RouteSnapshot> snapshots = SnapshotRoutes(routes);
@@ -3016,7 +3745,7 @@ int OptimalMove::OptSwapSegments(Routes& routes, int maxSegmentSize, bool force)
             return left.destIndex > right.destIndex;
         });
     if (best == candidates.end()) {
-        Utils::Instance().logger("segment exchange no improvement", Utils::VERBOSE);
+        this->Trace("segment exchange no improvement");
         return -1;
     }
     Routes::iterator source = routes.begin();
@@ -3026,7 +3755,7 @@ int OptimalMove::OptSwapSegments(Routes& routes, int maxSegmentSize, bool force)
     std::advance(dest, best->destIndex);
     *dest = best->dest;
     this->CleanVoid(routes);
-    Utils::Instance().logger("segment exchange changed: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("segment exchange changed: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3042,45 +3771,29 @@ int OptimalMove::OptSwapSegments(Routes& routes, int maxSegmentSize, bool force)
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptRuinRecreate(Routes& routes, int removalCount, int candidateLimit) {
+    PerfCounters::Scope scope(PerfCounters::RuinRecreate, routes);
     if (removalCount <= 0 || candidateLimit <= 0) {
-        Utils::Instance().logger("ruin-recreate no improvement", Utils::VERBOSE);
+        this->Trace("ruin-recreate no improvement");
         return -1;
     }
     const std::vector<RuinCustomer> ruinCustomers = CollectRuinCustomers(routes, candidateLimit);
     if (std::cmp_less(ruinCustomers.size(), removalCount)) {
-        Utils::Instance().logger("ruin-recreate no improvement", Utils::VERBOSE);
+        this->Trace("ruin-recreate no improvement");
         return -1;
     }
     const std::vector<std::vector<RuinCustomer>> combinations = BuildRuinCombinations(ruinCustomers, removalCount);
-    std::vector<RuinRecreateResult> candidates;
-    std::mutex candidatesMutex;
-    ThreadPool pool(this->cores);
-    for (std::size_t i = 0; i < combinations.size(); ++i) {
-        pool.AddTask([&routes, &combinations, i, &candidates, &candidatesMutex]() {
-            std::optional<RuinRecreateResult> candidate = EvaluateRuinRecreate(routes, combinations[i], i);
-            if (!candidate.has_value()) {
-                return;
-            }
-            std::scoped_lock lock(candidatesMutex);
-            candidates.push_back(std::move(*candidate));
-        });
-    }
-    pool.JoinAll();
-    const auto best =
-        std::ranges::max_element(candidates, [](const RuinRecreateResult& left, const RuinRecreateResult& right) {
-            if (left.improvement != right.improvement) {
-                return left.improvement < right.improvement;
-            }
-            return left.sequence > right.sequence;
-        });
-    if (best == candidates.end()) {
-        Utils::Instance().logger("ruin-recreate no improvement", Utils::VERBOSE);
+    const RuinRecreateEvaluator evaluate = [&routes, &combinations](std::size_t sequence, Routes& scratch) {
+        return EvaluateRuinRecreate(routes, combinations[sequence], scratch);
+    };
+    std::optional<RuinRecreateResult> best = FindBestRuinRecreate(combinations.size(), this->cores, evaluate);
+    if (!best.has_value()) {
+        this->Trace("ruin-recreate no improvement");
         return -1;
     }
-    routes = best->routes;
+    routes = std::move(best->routes);
     this->CleanVoid(routes);
-    Utils::Instance().logger("ruin-recreate improved: " + std::to_string(best->improvement), Utils::VERBOSE);
-    return best->improvement;
+    this->Trace("ruin-recreate improved: " + std::to_string(best->score.improvement));
+    return best->score.improvement;
 }
 
 /** @brief Remove related customer clusters and rebuild them with regret insertion.
@@ -3095,46 +3808,29 @@ int OptimalMove::OptRuinRecreate(Routes& routes, int removalCount, int candidate
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptRelatedRuinRecreate(Routes& routes, int removalCount, int seedLimit) {
+    PerfCounters::Scope scope(PerfCounters::RelatedRuinRecreate, routes);
     if (removalCount <= 1 || seedLimit <= 0 || routes.empty()) {
-        Utils::Instance().logger("related ruin-recreate no improvement", Utils::VERBOSE);
+        this->Trace("related ruin-recreate no improvement");
         return -1;
     }
     const std::vector<std::vector<Customer>> removalSets = BuildRelatedRemovalSets(routes, removalCount, seedLimit);
     if (removalSets.empty()) {
-        Utils::Instance().logger("related ruin-recreate no improvement", Utils::VERBOSE);
+        this->Trace("related ruin-recreate no improvement");
         return -1;
     }
 
-    std::vector<RuinRecreateResult> candidates;
-    std::mutex candidatesMutex;
-    ThreadPool pool(this->cores);
-    for (std::size_t sequence = 0; sequence < removalSets.size(); ++sequence) {
-        pool.AddTask([&routes, &removalSets, sequence, &candidates, &candidatesMutex]() {
-            std::optional<RuinRecreateResult> candidate =
-                EvaluateRelatedRuinRecreate(routes, removalSets[sequence], sequence);
-            if (!candidate.has_value()) {
-                return;
-            }
-            std::scoped_lock lock(candidatesMutex);
-            candidates.push_back(std::move(*candidate));
-        });
-    }
-    pool.JoinAll();
-    const auto best =
-        std::ranges::max_element(candidates, [](const RuinRecreateResult& left, const RuinRecreateResult& right) {
-            if (left.improvement != right.improvement) {
-                return left.improvement < right.improvement;
-            }
-            return left.sequence > right.sequence;
-        });
-    if (best == candidates.end()) {
-        Utils::Instance().logger("related ruin-recreate no improvement", Utils::VERBOSE);
+    const RuinRecreateEvaluator evaluate = [&routes, &removalSets](std::size_t sequence, Routes& scratch) {
+        return EvaluateRelatedRuinRecreate(routes, removalSets[sequence], scratch);
+    };
+    std::optional<RuinRecreateResult> best = FindBestRuinRecreate(removalSets.size(), this->cores, evaluate);
+    if (!best.has_value()) {
+        this->Trace("related ruin-recreate no improvement");
         return -1;
     }
-    routes = best->routes;
+    routes = std::move(best->routes);
     this->CleanVoid(routes);
-    Utils::Instance().logger("related ruin-recreate improved: " + std::to_string(best->improvement), Utils::VERBOSE);
-    return best->improvement;
+    this->Trace("related ruin-recreate improved: " + std::to_string(best->score.improvement));
+    return best->score.improvement;
 }
 
 /** @brief Remove related clusters and rebuild them with bounded beam insertion.
@@ -3150,46 +3846,29 @@ int OptimalMove::OptRelatedRuinRecreate(Routes& routes, int removalCount, int se
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptRelatedBeamRuinRecreate(Routes& routes, int removalCount, int seedLimit, int beamWidth) {
+    PerfCounters::Scope scope(PerfCounters::BeamRuinRecreate, routes);
     if (removalCount <= 1 || seedLimit <= 0 || beamWidth <= 0 || routes.empty()) {
-        Utils::Instance().logger("beam ruin-recreate no improvement", Utils::VERBOSE);
+        this->Trace("beam ruin-recreate no improvement");
         return -1;
     }
     const std::vector<std::vector<Customer>> removalSets = BuildRelatedRemovalSets(routes, removalCount, seedLimit);
     if (removalSets.empty()) {
-        Utils::Instance().logger("beam ruin-recreate no improvement", Utils::VERBOSE);
+        this->Trace("beam ruin-recreate no improvement");
         return -1;
     }
 
-    std::vector<RuinRecreateResult> candidates;
-    std::mutex candidatesMutex;
-    ThreadPool pool(this->cores);
-    for (std::size_t sequence = 0; sequence < removalSets.size(); ++sequence) {
-        pool.AddTask([&routes, &removalSets, sequence, beamWidth, &candidates, &candidatesMutex]() {
-            std::optional<RuinRecreateResult> candidate =
-                EvaluateRelatedBeamRuinRecreate(routes, removalSets[sequence], sequence, beamWidth);
-            if (!candidate.has_value()) {
-                return;
-            }
-            std::scoped_lock lock(candidatesMutex);
-            candidates.push_back(std::move(*candidate));
-        });
-    }
-    pool.JoinAll();
-    const auto best =
-        std::ranges::max_element(candidates, [](const RuinRecreateResult& left, const RuinRecreateResult& right) {
-            if (left.improvement != right.improvement) {
-                return left.improvement < right.improvement;
-            }
-            return left.sequence > right.sequence;
-        });
-    if (best == candidates.end()) {
-        Utils::Instance().logger("beam ruin-recreate no improvement", Utils::VERBOSE);
+    const RuinRecreateEvaluator evaluate = [&routes, &removalSets, beamWidth](std::size_t sequence, Routes& scratch) {
+        return EvaluateRelatedBeamRuinRecreate(routes, removalSets[sequence], beamWidth, scratch);
+    };
+    std::optional<RuinRecreateResult> best = FindBestRuinRecreate(removalSets.size(), this->cores, evaluate);
+    if (!best.has_value()) {
+        this->Trace("beam ruin-recreate no improvement");
         return -1;
     }
-    routes = best->routes;
+    routes = std::move(best->routes);
     this->CleanVoid(routes);
-    Utils::Instance().logger("beam ruin-recreate improved: " + std::to_string(best->improvement), Utils::VERBOSE);
-    return best->improvement;
+    this->Trace("beam ruin-recreate improved: " + std::to_string(best->score.improvement));
+    return best->score.improvement;
 }
 
 /** @brief Rebuild one related customer cluster away from its current routes.
@@ -3205,46 +3884,35 @@ int OptimalMove::OptRelatedBeamRuinRecreate(Routes& routes, int removalCount, in
  * @return Cost improvement if positive, or a negative cost increase when diversified
  */
 int OptimalMove::PerturbRelatedRuinRecreate(Routes& routes, int removalCount, int seedLimit, int diversificationRank) {
+    PerfCounters::Scope scope(PerfCounters::PerturbRelatedRuinRecreate, routes);
     if (removalCount <= 1 || seedLimit <= 0 || routes.empty()) {
-        Utils::Instance().logger("related perturbation no move", Utils::VERBOSE);
+        this->Trace("related perturbation no move");
         return 0;
     }
     const std::vector<std::vector<Customer>> removalSets = BuildRelatedRemovalSets(routes, removalCount, seedLimit);
     if (removalSets.empty()) {
-        Utils::Instance().logger("related perturbation no move", Utils::VERBOSE);
+        this->Trace("related perturbation no move");
         return 0;
     }
 
-    std::vector<RuinRecreateResult> candidates;
-    std::mutex candidatesMutex;
-    ThreadPool pool(this->cores);
-    for (std::size_t sequence = 0; sequence < removalSets.size(); ++sequence) {
-        pool.AddTask([&routes, &removalSets, sequence, &candidates, &candidatesMutex]() {
-            std::optional<RuinRecreateResult> candidate =
-                EvaluateRelatedPerturbation(routes, removalSets[sequence], sequence);
-            if (!candidate.has_value()) {
-                return;
-            }
-            std::scoped_lock lock(candidatesMutex);
-            candidates.push_back(std::move(*candidate));
-        });
+    const RuinRecreateEvaluator evaluate = [&routes, &removalSets](std::size_t sequence, Routes& scratch) {
+        return EvaluateRelatedPerturbation(routes, removalSets[sequence], scratch);
+    };
+    const std::vector<RuinRecreateScore> scores = ScoreRuinRecreate(removalSets.size(), this->cores, evaluate);
+    if (scores.empty()) {
+        this->Trace("related perturbation no move");
+        return 0;
     }
-    pool.JoinAll();
-    if (candidates.empty()) {
-        Utils::Instance().logger("related perturbation no move", Utils::VERBOSE);
+    const std::size_t selectedIndex = static_cast<std::size_t>(std::max(0, diversificationRank)) % scores.size();
+    const RuinRecreateScore& selected = scores[selectedIndex];
+    Routes candidate;
+    if (evaluate(selected.sequence, candidate) != selected.improvement) {
+        this->Trace("related perturbation no move");
         return 0;
     }
-    std::ranges::sort(candidates, [](const RuinRecreateResult& left, const RuinRecreateResult& right) {
-        if (left.improvement != right.improvement) {
-            return left.improvement > right.improvement;
-        }
-        return left.sequence < right.sequence;
-    });
-    const std::size_t selectedIndex = static_cast<std::size_t>(std::max(0, diversificationRank)) % candidates.size();
-    RuinRecreateResult& selected = candidates[selectedIndex];
-    routes = std::move(selected.routes);
+    routes = std::move(candidate);
     this->CleanVoid(routes);
-    Utils::Instance().logger("related perturbation changed: " + std::to_string(selected.improvement), Utils::VERBOSE);
+    this->Trace("related perturbation changed: " + std::to_string(selected.improvement));
     return selected.improvement;
 }
 
@@ -3256,6 +3924,7 @@ int OptimalMove::PerturbRelatedRuinRecreate(Routes& routes, int removalCount, in
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::Opt2Star(Routes& routes) {
+    PerfCounters::Scope scope(PerfCounters::TwoOptStar, routes);
     const std::vector<RouteSnapshot> snapshots = SnapshotRoutes(routes);
     std::vector<IndexedTwoOptStarRoutes> candidates;
     std::mutex candidatesMutex;
@@ -3292,7 +3961,7 @@ int OptimalMove::Opt2Star(Routes& routes) {
             return left.destIndex > right.destIndex;
         });
     if (best == candidates.end()) {
-        Utils::Instance().logger("2-Opt* no improvement", Utils::VERBOSE);
+        this->Trace("2-Opt* no improvement");
         return -1;
     }
     Routes::iterator source = routes.begin();
@@ -3302,7 +3971,7 @@ int OptimalMove::Opt2Star(Routes& routes) {
     std::advance(dest, best->destIndex);
     *dest = best->dest;
     this->CleanVoid(routes);
-    Utils::Instance().logger("2-Opt* improved: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("2-Opt* improved: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3318,8 +3987,9 @@ int OptimalMove::Opt2Star(Routes& routes) {
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptBoundaryPairSplit(Routes& routes, int maxBoundaryCustomers, int pairLimit) {
+    PerfCounters::Scope scope(PerfCounters::BoundaryPairSplit, routes);
     if (maxBoundaryCustomers <= 1 || pairLimit <= 0) {
-        Utils::Instance().logger("boundary pair split no improvement", Utils::VERBOSE);
+        this->Trace("boundary pair split no improvement");
         return -1;
     }
     const std::vector<RouteSnapshot> snapshots = SnapshotRoutes(routes);
@@ -3378,7 +4048,7 @@ int OptimalMove::OptBoundaryPairSplit(Routes& routes, int maxBoundaryCustomers,
             return left.destIndex > right.destIndex;
         });
     if (best == candidates.end()) {
-        Utils::Instance().logger("boundary pair split no improvement", Utils::VERBOSE);
+        this->Trace("boundary pair split no improvement");
         return -1;
     }
     Routes::iterator source = routes.begin();
@@ -3388,7 +4058,7 @@ int OptimalMove::OptBoundaryPairSplit(Routes& routes, int maxBoundaryCustomers,
     std::advance(dest, best->destIndex);
     *dest = best->dest;
     this->CleanVoid(routes);
-    Utils::Instance().logger("boundary pair split improved: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("boundary pair split improved: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3404,8 +4074,9 @@ int OptimalMove::OptBoundaryPairSplit(Routes& routes, int maxBoundaryCustomers,
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptPairSplit(Routes& routes, int maxCombinedCustomers) {
+    PerfCounters::Scope scope(PerfCounters::PairSplit, routes);
     if (maxCombinedCustomers <= 2) {
-        Utils::Instance().logger("pair split no improvement", Utils::VERBOSE);
+        this->Trace("pair split no improvement");
         return -1;
     }
     const std::vector<RouteSnapshot> snapshots = SnapshotRoutes(routes);
@@ -3441,12 +4112,16 @@ int OptimalMove::OptPairSplit(Routes& routes, int maxCombinedCustomers) {
     pairCandidates.resize(pairLimit);
     std::vector<PairSplit> candidates;
     std::mutex candidatesMutex;
+    // Route pairs run in parallel; cores left idle by a short pair list fill
+    // the popcount layers of each pair's subset table instead.
+    const unsigned dpWorkers =
+        std::max(1U, this->cores / static_cast<unsigned>(std::max<std::size_t>(1, pairCandidates.size())));
     ThreadPool pool(this->cores);
     for (const PairSplitCandidatePair& pair : pairCandidates) {
-        pool.AddTask([&snapshots, pair, maxCombinedCustomers, &candidates, &candidatesMutex]() {
+        pool.AddTask([&snapshots, pair, maxCombinedCustomers, dpWorkers, &candidates, &candidatesMutex]() {
             std::optional<PairSplit> candidate = FindBestPairSplit(
                 snapshots[pair.sourceIndex].route, snapshots[pair.destIndex].route, snapshots[pair.sourceIndex].index,
-                snapshots[pair.destIndex].index, maxCombinedCustomers);
+                snapshots[pair.destIndex].index, maxCombinedCustomers, dpWorkers);
             if (!candidate.has_value()) {
                 return;
             }
@@ -3465,7 +4140,7 @@ int OptimalMove::OptPairSplit(Routes& routes, int maxCombinedCustomers) {
         return left.destIndex > right.destIndex;
     });
     if (best == candidates.end()) {
-        Utils::Instance().logger("pair split no improvement", Utils::VERBOSE);
+        this->Trace("pair split no improvement");
         return -1;
     }
     Routes::iterator source = routes.begin();
@@ -3475,7 +4150,7 @@ int OptimalMove::OptPairSplit(Routes& routes, int maxCombinedCustomers) {
     std::advance(dest, best->destIndex);
     *dest = best->dest;
     this->CleanVoid(routes);
-    Utils::Instance().logger("pair split improved: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("pair split improved: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3488,6 +4163,7 @@ int OptimalMove::OptPairSplit(Routes& routes, int maxCombinedCustomers) {
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptPairSweepSplit(Routes& routes) {
+    PerfCounters::Scope scope(PerfCounters::PairSweepSplit, routes);
     const std::vector<RouteSnapshot> snapshots = SnapshotRoutes(routes);
     std::vector<PairSplit> candidates;
     std::mutex candidatesMutex;
@@ -3517,7 +4193,7 @@ int OptimalMove::OptPairSweepSplit(Routes& routes) {
         return left.destIndex > right.destIndex;
     });
     if (best == candidates.end()) {
-        Utils::Instance().logger("pair sweep split no improvement", Utils::VERBOSE);
+        this->Trace("pair sweep split no improvement");
         return -1;
     }
     Routes::iterator source = routes.begin();
@@ -3527,7 +4203,7 @@ int OptimalMove::OptPairSweepSplit(Routes& routes) {
     std::advance(dest, best->destIndex);
     *dest = best->dest;
     this->CleanVoid(routes);
-    Utils::Instance().logger("pair sweep split improved: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("pair sweep split improved: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3541,8 +4217,9 @@ int OptimalMove::OptPairSweepSplit(Routes& routes) {
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptRouteClusterSplit(Routes& routes, int maxBoundaryCustomers) {
+    PerfCounters::Scope scope(PerfCounters::RouteClusterSplit, routes);
     if (maxBoundaryCustomers <= 0 || routes.size() < 3) {
-        Utils::Instance().logger("route cluster split no improvement", Utils::VERBOSE);
+        this->Trace("route cluster split no improvement");
         return -1;
     }
     constexpr int maxClusterBoundaryCustomers = 5;
@@ -3554,20 +4231,23 @@ int OptimalMove::OptRouteClusterSplit(Routes& routes, int maxBoundaryCustomers)
     clusterCandidates.resize(clusterLimit);
     std::vector<RouteClusterSplit> candidates;
     std::mutex candidatesMutex;
+    const unsigned dpWorkers =
+        std::max(1U, this->cores / static_cast<unsigned>(std::max<std::size_t>(1, clusterCandidates.size())));
     ThreadPool pool(this->cores);
     for (const RouteClusterCandidate& candidate : clusterCandidates) {
-        pool.AddTask([&snapshots, candidate, maxBoundaryCustomers, &candidates, &candidatesMutex]() {
+        pool.AddTask([&snapshots, candidate, maxBoundaryCustomers, dpWorkers, &candidates, &candidatesMutex]() {
             const std::array<RouteSnapshot, 3> cluster = {
                 snapshots[candidate.routeIndices[0]],
                 snapshots[candidate.routeIndices[1]],
                 snapshots[candidate.routeIndices[2]],
             };
-            const std::size_t exactCustomerLimit = static_cast<std::size_t>(maxBoundaryCustomers) * cluster.size();
+            const std::size_t exactCustomerLimit =
+                std::min(static_cast<std::size_t>(maxBoundaryCustomers) * cluster.size(), HeldKarp::MaxCustomers);
             std::optional<RouteClusterSplit> result;
             if (RouteClusterCustomerCount(cluster) <= exactCustomerLimit) {
                 // Small triples are solved exactly because the subset DP can
                 // evaluate every feasible three-way repartition cheaply enough.
-                result = FindBestExactRouteClusterSplit(cluster, exactCustomerLimit);
+                result = FindBestExactRouteClusterSplit(cluster, exactCustomerLimit, dpWorkers);
             }
             if (!result.has_value() &&
                 RouteClusterCustomerCount(cluster) <=
@@ -3598,7 +4278,7 @@ int OptimalMove::OptRouteClusterSplit(Routes& routes, int maxBoundaryCustomers)
             return left.indexes > right.indexes;
         });
     if (best == candidates.end()) {
-        Utils::Instance().logger("route cluster split no improvement", Utils::VERBOSE);
+        this->Trace("route cluster split no improvement");
         return -1;
     }
     for (std::size_t routeIndex = 0; routeIndex < best->routes.size(); ++routeIndex) {
@@ -3607,7 +4287,7 @@ int OptimalMove::OptRouteClusterSplit(Routes& routes, int maxBoundaryCustomers)
         *target = best->routes[routeIndex];
     }
     this->CleanVoid(routes);
-    Utils::Instance().logger("route cluster split improved: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("route cluster split improved: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3621,8 +4301,9 @@ int OptimalMove::OptRouteClusterSplit(Routes& routes, int maxBoundaryCustomers)
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptCyclicExchange(Routes& routes, int groupSize) {
+    PerfCounters::Scope scope(PerfCounters::CyclicExchange, routes);
     if (groupSize <= 0 || routes.size() < 3) {
-        Utils::Instance().logger("cyclic exchange no improvement", Utils::VERBOSE);
+        this->Trace("cyclic exchange no improvement");
         return -1;
     }
     const std::vector<RouteSnapshot> snapshots = SnapshotRoutes(routes);
@@ -3632,7 +4313,10 @@ int OptimalMove::OptCyclicExchange(Routes& routes, int groupSize) {
     for (std::size_t first = 0; first + 2 < snapshots.size(); ++first) {
         for (std::size_t second = first + 1; second + 1 < snapshots.size(); ++second) {
             for (std::size_t third = second + 1; third < snapshots.size(); ++third) {
-                pool.AddTask([&snapshots, first, second, third, groupSize, &candidates, &candidatesMutex]() {
+                pool.AddTask([&snapshots, first, second, third, groupSize, &candidates, &candidatesMutex, this]() {
+                    if (this->StopRequested()) {
+                        return;
+                    }
                     const std::array<RouteSnapshot, 3> cluster = {
                         snapshots[first],
                         snapshots[second],
@@ -3657,7 +4341,7 @@ int OptimalMove::OptCyclicExchange(Routes& routes, int groupSize) {
             return left.indexes > right.indexes;
         });
     if (best == candidates.end()) {
-        Utils::Instance().logger("cyclic exchange no improvement", Utils::VERBOSE);
+        this->Trace("cyclic exchange no improvement");
         return -1;
     }
     for (std::size_t routeIndex = 0; routeIndex < best->routes.size(); ++routeIndex) {
@@ -3666,7 +4350,7 @@ int OptimalMove::OptCyclicExchange(Routes& routes, int groupSize) {
         *target = best->routes[routeIndex];
     }
     this->CleanVoid(routes);
-    Utils::Instance().logger("cyclic exchange improved: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("cyclic exchange improved: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3679,8 +4363,9 @@ int OptimalMove::OptCyclicExchange(Routes& routes, int groupSize) {
  * @return Positive cost reduction if routes are improved, otherwise -1
  */
 int OptimalMove::OptRelocateSegment(Routes& routes, int segmentSize) {
+    PerfCounters::Scope scope(PerfCounters::RelocateSegment, routes);
     if (segmentSize <= 0) {
-        Utils::Instance().logger("segment relocate no improvement", Utils::VERBOSE);
+        this->Trace("segment relocate no improvement");
         return -1;
     }
     const std::vector<RouteSnapshot> snapshots = SnapshotRoutes(routes);
@@ -3716,7 +4401,7 @@ int OptimalMove::OptRelocateSegment(Routes& routes, int segmentSize) {
             return left.destIndex > right.destIndex;
         });
     if (best == candidates.end()) {
-        Utils::Instance().logger("segment relocate no improvement", Utils::VERBOSE);
+        this->Trace("segment relocate no improvement");
         return -1;
     }
     Routes::iterator source = routes.begin();
@@ -3726,7 +4411,7 @@ int OptimalMove::OptRelocateSegment(Routes& routes, int segmentSize) {
     std::advance(dest, best->destIndex);
     *dest = best->dest;
     this->CleanVoid(routes);
-    Utils::Instance().logger("segment relocate improved: " + std::to_string(best->improvement), Utils::VERBOSE);
+    this->Trace("segment relocate improved: " + std::to_string(best->improvement));
     return best->improvement;
 }
 
@@ -3741,15 +4426,39 @@ int OptimalMove::OptRelocateSegment(Routes& routes, int segmentSize) {
  * @return Positive total cost reduction if any route is improved, otherwise -1
  */
 int OptimalMove::OptRouteTsp(Routes& routes, int maxCustomers) {
+    PerfCounters::Scope scope(PerfCounters::RouteTsp, routes);
+    int totalImprovement = 0;
+    for (Route& route : routes) {
+        totalImprovement += OptimizeSingleRouteTsp(route, maxCustomers, this->cores);
+    }
+    if (totalImprovement <= 0) {
+        this->Trace("route TSP no improvement");
+        return -1;
+    }
+    this->Trace("route TSP improved: " + std::to_string(totalImprovement));
+    return totalImprovement;
+}
+
+/** @brief Polish long routes with neighbour-list 2-opt and Or-opt.
+ *
+ * Complements OptRouteTsp: routes with more than maxExactCustomers customers
+ * are too long for Held-Karp and are reordered by the don't-look-bit local
+ * search instead of the full Opt2/Opt3 scans.
+ * @param[in] routes The routes to edit
+ * @param[in] maxExactCustomers Routes up to this size are left to exact ordering
+ * @return Positive total cost reduction if any route is improved, otherwise -1
+ */
+int OptimalMove::OptLongRoutes(Routes& routes, int maxExactCustomers) {
+    PerfCounters::Scope scope(PerfCounters::LongRoutes, routes);
     int totalImprovement = 0;
     for (Route& route : routes) {
-        totalImprovement += OptimizeSingleRouteTsp(route, maxCustomers);
+        totalImprovement += PolishLongRoute(route, maxExactCustomers);
     }
     if (totalImprovement <= 0) {
-        Utils::Instance().logger("route TSP no improvement", Utils::VERBOSE);
+        this->Trace("long route polish no improvement");
         return -1;
     }
-    Utils::Instance().logger("route TSP improved: " + std::to_string(totalImprovement), Utils::VERBOSE);
+    this->Trace("long route polish improved: " + std::to_string(totalImprovement));
     return totalImprovement;
 }
 
@@ -3761,8 +4470,9 @@ int OptimalMove::OptRouteTsp(Routes& routes, int maxCustomers) {
  * @return Number of routes removed
  */
 int OptimalMove::ReduceRoutes(Routes& routes, std::size_t minimumRouteCount) {
+    PerfCounters::Scope scope(PerfCounters::ReduceRoutes, routes);
     if (minimumRouteCount > 0 && routes.size() <= minimumRouteCount) {
-        Utils::Instance().logger("Route reduction no improvement", Utils::VERBOSE);
+        this->Trace("Route reduction no improvement");
         return 0;
     }
     int removedRoutes = 0;
@@ -3810,9 +4520,9 @@ int OptimalMove::ReduceRoutes(Routes& routes, std::size_t minimumRouteCount) {
         ++removedRoutes;
     }
     if (removedRoutes > 0) {
-        Utils::Instance().logger("Route reduction removed: " + std::to_string(removedRoutes), Utils::VERBOSE);
+        this->Trace("Route reduction removed: " + std::to_string(removedRoutes));
     } else {
-        Utils::Instance().logger("Route reduction no improvement", Utils::VERBOSE);
+        this->Trace("Route reduction no improvement");
     }
     return removedRoutes;
 }
@@ -3825,6 +4535,7 @@ int OptimalMove::ReduceRoutes(Routes& routes, std::size_t minimumRouteCount) {
  * @return True if routes are improved
  */
 bool OptimalMove::Opt2(Routes& routes) {
+    PerfCounters::Scope scope(PerfCounters::TwoOpt, routes);
     bool ret = false;
     Routes::iterator it = routes.begin();
     int diffCost = 0;
@@ -3834,11 +4545,13 @@ bool OptimalMove::Opt2(Routes& routes) {
         Route bestRoute = *it;
         ThreadPool pool(this->cores);
         int bestCost = it->GetTotalCost();
-        RouteList::iterator i = it->GetRoute()->begin();
+        // read-only: the queued tasks copy the route while the loop walks it
+        const RouteList& steps = *std::as_const(*it).GetRoute();
+        RouteList::const_iterator i = steps.cbegin();
         std::advance(i, 1);
-        for (; i->first != it->GetRoute()->back().first; ++i) {
-            RouteList::iterator k = i;
-            for (++k; k->first != it->GetRoute()->back().first; ++k) {
+        for (; i->first != steps.back().first; ++i) {
+            RouteList::const_iterator k = i;
+            for (++k; k->first != steps.back().first; ++k) {
                 pool.AddTask([i, k, it, &bestCost, &bestRoute, &routeImproved, this]() {
                     // swap customers
                     Route tempRoute = this->Opt2Swap(*it, i->first, k->first);
@@ -3860,10 +4573,10 @@ bool OptimalMove::Opt2(Routes& routes) {
         }
     }
     if (diffCost != 0) {
-        Utils::Instance().logger("2-Opt improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->Trace("2-Opt improved: " + std::to_string(diffCost));
     } else {
         ret = false;
-        Utils::Instance().logger("2-Opt no improvement", Utils::VERBOSE);
+        this->Trace("2-Opt no improvement");
     }
     return ret;
 }
@@ -3921,6 +4634,7 @@ Route OptimalMove::Opt2Swap(Route route, const Customer& i, const Customer& k) {
  * @return True if routes are improved
  */
 bool OptimalMove::Opt3(Routes& routes) {
+    PerfCounters::Scope scope(PerfCounters::ThreeOpt, routes);
     bool ret = false;
     Routes::iterator it = routes.begin();
     // Customers with short path (less than average)
@@ -3931,23 +4645,25 @@ bool OptimalMove::Opt3(Routes& routes) {
         Route bestRoute = *it;
         ThreadPool pool(this->cores);
         int bestCost = it->GetTotalCost();
-        RouteList::iterator i = it->GetRoute()->begin();
+        // read-only: the queued tasks copy the route while the loop walks it
+        const RouteList& steps = *std::as_const(*it).GetRoute();
+        RouteList::const_iterator i = steps.cbegin();
         Customer depot = i->first;
-        std::advance(i, it->GetRoute()->size() - 2);
+        std::advance(i, steps.size() - 2);
         Customer lastK = i->first;
         std::advance(i, -1);
         Customer lastI = i->first;
-        i = it->GetRoute()->begin();
+        i = steps.cbegin();
         for (; i->first != lastI; ++i) {
             if (i->first != depot) {
-                RouteList::iterator k = i;
+                RouteList::const_iterator k = i;
                 for (++k; k->first != lastK; ++k) {
                     if (k->first != depot) {
-                        RouteList::iterator l = k;
-                        for (++l; l != it->GetRoute()->end(); ++l) {
+                        RouteList::const_iterator l = k;
+                        for (++l; l != steps.cend(); ++l) {
                             if (l->first != depot) {
-                                RouteList::iterator m = l;
-                                for (++m; m != it->GetRoute()->end(); ++m) {
+                                RouteList::const_iterator m = l;
+                                for (++m; m != steps.cend(); ++m) {
                                     pool.AddTask([i, k, l, m, it, &bestCost, &bestRoute, &routeImproved, this]() {
                                         // swap customers
                                         Route tempRoute = this->Opt3Swap(*it, i->first, k->first, l->first, m->first);
@@ -3974,10 +4690,10 @@ bool OptimalMove::Opt3(Routes& routes) {
         }
     }
     if (ret && diffCost != 0) {
-        Utils::Instance().logger("3-Opt improved: " + std::to_string(diffCost), Utils::VERBOSE);
+        this->Trace("3-Opt improved: " + std::to_string(diffCost));
     } else {
         ret = false;
-        Utils::Instance().logger("3-Opt no improvement", Utils::VERBOSE);
+        this->Trace("3-Opt no improvement");
     }
     return ret;
 }
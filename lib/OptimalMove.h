@@ -5,8 +5,17 @@
 #include "Utils.h"
 #include "../lib/ThreadPool.h"
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <mutex>
+#include <set>
+#include <string>
 #include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+class Utils;
 
 /** @brief Candidate replacement for one ordered route pair. */
 struct BestResult {
@@ -23,16 +32,53 @@ struct BestResult {
     [[nodiscard]] int Improvement() const { return originalCost - NewCost(); }
 };
 
+/** @brief Don't-look memory of ordered route pairs proven non-improving.
+ *
+ * Entries are keyed by a neighborhood tag and the modification epochs of both
+ * routes. Any change to either route renews its epoch, so an entry is
+ * consulted only while both routes keep the content they were evaluated with.
+ * The memory is cleared once it grows past a fixed bound, since stale epochs
+ * never match again.
+ */
+class DontLookPairs {
+  public:
+    /** @brief Check whether a pair was already proven non-improving for a neighborhood. */
+    [[nodiscard]] bool Contains(int, const Route&, const Route&) const;
+
+    /** @brief Remember evaluated pairs, given by route index, that produced no improvement. */
+    void Insert(int, const Routes&, const std::vector<std::pair<int, int>>&);
+
+  private:
+    static constexpr std::size_t MaxEntries = std::size_t{1} << 16;
+
+    std::set<std::tuple<int, std::uint64_t, std::uint64_t>> entries; /**< Tag, source epoch, destination epoch */
+};
+
 /** @brief Collection of local-search neighborhoods for improving VRP routes.
  *
  * Each public method applies one move family to the route set and returns the
  * cost improvement when applicable. Inter-route neighborhoods are evaluated in
- * parallel where route pairs can be considered independently.
+ * parallel where route pairs can be considered independently. Pairwise
+ * exchange neighborhoods skip pairs whose routes are unchanged since they were
+ * last proven non-improving, so one engine should live for a whole VND pass.
  */
 class OptimalMove {
   private:
     std::mutex mtx;
     const unsigned cores;
+    const Utils* utils;               /**< Logger of the run receiving the search trace, none for a silent engine */
+    DontLookPairs dontLook;           /**< Route pairs proven non-improving, reused across VND rounds */
+    std::function<bool()> stopSearch; /**< Tells long neighborhoods to stop early, none to always finish */
+
+    /** @brief Log one line of the search trace. */
+    void Trace(const std::string&) const;
+
+    /** @brief Check whether long neighborhoods must stop evaluating candidates.
+     *
+     * Route pairs skipped after a stop are left unproven, so they never enter
+     * the don't-look memory.
+     */
+    [[nodiscard]] bool StopRequested() const { return this->stopSearch && this->stopSearch(); }
 
     /** @brief Return a route with the segment between two customers reversed. */
     Route Opt2Swap(Route, const Customer&, const Customer&);
@@ -50,8 +96,14 @@ class OptimalMove {
     bool AddRemoveFromTo(Route&, Route&, int, int, bool);
 
   public:
-    /** @brief Create a move engine sized to the available hardware concurrency. */
-    OptimalMove() : cores(std::max(1U, std::thread::hardware_concurrency())) {};
+    /** @brief Create a move engine limited to a worker budget, tracing to the logger of its run. */
+    OptimalMove(unsigned workers, const Utils* runUtils) : cores(std::max(1U, workers)), utils(runUtils) {};
+
+    /** @brief Let pairwise and cyclic exchanges skip their remaining route pairs once a predicate holds.
+     *
+     * The best move found before the stop is still applied.
+     */
+    void SetStopCondition(std::function<bool()> stop) { this->stopSearch = std::move(stop); }
 
     /** @brief Remove routes that contain no customers. */
     void CleanVoid(Routes&);
@@ -62,6 +114,9 @@ class OptimalMove {
     /** @brief Apply best one-for-one customer swap between routes. */
     int Opt11(Routes&, bool);
 
+    /** @brief Apply best SWAP* exchange, reinserting both customers at their best positions. */
+    int OptSwapStar(Routes&);
+
     /** @brief Apply best two-from-source one-from-destination exchange. */
     int Opt21(Routes&, bool);
 
@@ -116,6 +171,12 @@ class OptimalMove {
     /** @brief Optimize small individual routes as TSP subproblems. */
     int OptRouteTsp(Routes&, int);
 
+    /** @brief Reorder routes too long for exact TSP with neighbour-list 2-opt and Or-opt. */
+    int OptLongRoutes(Routes&, int);
+
+    /** @brief Insert customers into existing routes by regret-k insertion. */
+    bool InsertRegret(Routes&, const std::vector<Customer>&, int);
+
     /** @brief Remove routes by reinserting all customers into the remaining routes. */
     int ReduceRoutes(Routes&, std::size_t minimumRouteCount = 0);
 
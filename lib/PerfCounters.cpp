@@ -0,0 +1,234 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "PerfCounters.h"
+#include "Route.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+namespace {
+/** @brief Names of the neighborhoods, as used by the neighborhood scheduler where it has one. */
+constexpr std::array<const char*, PerfCounters::Count> kNeighborhoodNames = {
+    "other",
+    "opt10",
+    "opt11",
+    "swap-star",
+    "opt21",
+    "opt12",
+    "opt22",
+    "exchange",
+    "swap-segments",
+    "ruin",
+    "related-ruin",
+    "beam-ruin",
+    "perturb-related-ruin",
+    "perturb-angular-ruin",
+    "2opt-star",
+    "boundary-pair-split",
+    "pair-split",
+    "pair-sweep-split",
+    "route-cluster-split",
+    "cyclic-exchange",
+    "relocate-segment",
+    "route-tsp",
+    "long-route",
+    "insert-regret",
+    "reduce-routes",
+    "2opt",
+    "3opt",
+    "tabu",
+};
+
+/** @brief Add the counters of one report to another. */
+void Accumulate(PerfCounters::Report& into, const PerfCounters::Report& from) {
+    for (std::size_t n = 0; n < into.size(); ++n) {
+        into[n].calls += from[n].calls;
+        into[n].candidates += from[n].candidates;
+        into[n].improvements += from[n].improvements;
+        into[n].gain += from[n].gain;
+        into[n].cpuNanoseconds += from[n].cpuNanoseconds;
+        into[n].wallNanoseconds += from[n].wallNanoseconds;
+    }
+}
+
+/** @brief Check whether a neighborhood did anything worth reporting. */
+bool Used(const PerfCounters::Totals& totals) {
+    return totals.calls != 0 || totals.candidates != 0 || totals.cpuNanoseconds != 0;
+}
+
+/** @brief Return the total cost of a route set. */
+int RoutesCost(const Routes& routes) {
+    return std::accumulate(routes.cbegin(), routes.cend(), 0,
+                           [](int sum, const Route& route) { return sum + route.GetTotalCost(); });
+}
+
+/** @brief Convert nanoseconds to milliseconds for display. */
+double Milliseconds(std::uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1e6; }
+} // namespace
+
+thread_local PerfCounters::ThreadCounters PerfCounters::counters;
+
+std::uint64_t PerfCounters::ThreadCpuNanoseconds() {
+    timespec now{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) {
+        return 0;
+    }
+    return (static_cast<std::uint64_t>(now.tv_sec) * 1000000000ULL) + static_cast<std::uint64_t>(now.tv_nsec);
+}
+
+/** @brief Fold the pending counters of the calling thread into its sink, then work for another context.
+ *
+ * Counters of a thread without a sink are dropped.
+ * @param[in] context Run and neighborhood the thread works for next
+ */
+void PerfCounters::SwitchTo(Context context) {
+    if (Sink* sink = counters.context.sink; sink != nullptr) {
+        std::scoped_lock lock(sink->mutex);
+        Accumulate(sink->totals, counters.pending);
+    }
+    counters.pending = Report{};
+    counters.context = context;
+}
+
+/** @brief Make the calling thread count for a new run. */
+PerfCounters::Sink::Sink() : previous(counters.context) {
+    SwitchTo(Context{.sink = this, .neighborhood = None});
+}
+
+/** @brief Fold the last counters of the calling thread and give it back to its previous context. */
+PerfCounters::Sink::~Sink() { SwitchTo(this->previous); }
+
+/** @brief Return the counters of the run.
+ *
+ * Must be called on the thread that created the sink, once the pool tasks of
+ * the run have ended.
+ * @return Counters of every thread that worked for the run
+ */
+PerfCounters::Report PerfCounters::Sink::Collect() {
+    SwitchTo(counters.context);
+    std::scoped_lock lock(this->mutex);
+    return this->totals;
+}
+
+/** @brief Start measuring a neighborhood call.
+ *
+ * @param[in] n Neighborhood being called
+ * @param[in] r Route set the call works on
+ */
+PerfCounters::Scope::Scope(Neighborhood n, const Routes& r)
+    : neighborhood(n), previous(counters.context.neighborhood), routes(&r), costBefore(RoutesCost(r)),
+      routesBefore(r.size()), cpuStart(ThreadCpuNanoseconds()), wallStart(std::chrono::steady_clock::now()) {
+    counters.context.neighborhood = n;
+}
+
+/** @brief Charge the call to its neighborhood and give the thread back to the caller. */
+PerfCounters::Scope::~Scope() {
+    const auto wall = std::chrono::steady_clock::now() - this->wallStart;
+    Totals& totals = counters.pending[this->neighborhood];
+    const int costAfter = RoutesCost(*this->routes);
+    totals.calls++;
+    totals.gain += this->costBefore - costAfter;
+    if (costAfter < this->costBefore || this->routes->size() < this->routesBefore) {
+        totals.improvements++;
+    }
+    totals.cpuNanoseconds += ThreadCpuNanoseconds() - this->cpuStart;
+    totals.wallNanoseconds +=
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count());
+    counters.context.neighborhood = this->previous;
+}
+
+/** @brief Make a worker thread work for the run and the neighborhood of a task until it ends.
+ *
+ * @param[in] context Context of the thread that queued the task
+ */
+PerfCounters::TaskScope::TaskScope(Context context) : previous(counters.context), cpuStart(ThreadCpuNanoseconds()) {
+    SwitchTo(context);
+}
+
+/** @brief Charge the CPU time of the task and fold the counters of the task into its run. */
+PerfCounters::TaskScope::~TaskScope() {
+    counters.pending[counters.context.neighborhood].cpuNanoseconds += ThreadCpuNanoseconds() - this->cpuStart;
+    SwitchTo(this->previous);
+}
+
+/** @brief Format a report as a text table.
+ *
+ * Neighborhoods that did no work are left out; the wall share is relative to
+ * the sum of the listed wall times, which counts nested calls twice.
+ * @param[in] report Counters to format
+ * @return One header line and one line per neighborhood, most wall time first
+ */
+std::string PerfCounters::Table(const Report& report) {
+    std::vector<std::size_t> rows;
+    std::uint64_t wallTotal = 0;
+    for (std::size_t n = 0; n < report.size(); ++n) {
+        if (Used(report[n])) {
+            rows.push_back(n);
+            wallTotal += report[n].wallNanoseconds;
+        }
+    }
+    std::ranges::stable_sort(rows, [&report](std::size_t a, std::size_t b) {
+        return report[a].wallNanoseconds > report[b].wallNanoseconds;
+    });
+    std::ostringstream table;
+    table << std::left << std::setw(22) << "neighborhood" << std::right << std::setw(10) << "calls" << std::setw(14)
+          << "candidates" << std::setw(10) << "improved" << std::setw(10) << "gain" << std::setw(12) << "cpu ms"
+          << std::setw(12) << "wall ms" << std::setw(8) << "wall %";
+    table << std::fixed << std::setprecision(1);
+    for (const std::size_t n : rows) {
+        const Totals& totals = report[n];
+        const double share = wallTotal == 0 ? 0.0
+                                            : 100.0 * static_cast<double>(totals.wallNanoseconds) /
+                                                  static_cast<double>(wallTotal);
+        table << '\n'
+              << std::left << std::setw(22) << kNeighborhoodNames[n] << std::right << std::setw(10) << totals.calls
+              << std::setw(14) << totals.candidates << std::setw(10) << totals.improvements << std::setw(10)
+              << totals.gain << std::setw(12) << Milliseconds(totals.cpuNanoseconds) << std::setw(12)
+              << Milliseconds(totals.wallNanoseconds) << std::setw(8) << share;
+    }
+    return table.str();
+}
+
+/** @brief Format a report as JSON.
+ *
+ * @param[in] report Counters to format
+ * @return One object per neighborhood that did work, keyed by its name
+ */
+nlohmann::json PerfCounters::Json(const Report& report) {
+    nlohmann::json json = nlohmann::json::object();
+    for (std::size_t n = 0; n < report.size(); ++n) {
+        const Totals& totals = report[n];
+        if (!Used(totals)) {
+            continue;
+        }
+        json[kNeighborhoodNames[n]] = {
+            {"calls", totals.calls},
+            {"candidates", totals.candidates},
+            {"improvements", totals.improvements},
+            {"gain", totals.gain},
+            {"cpuNanoseconds", totals.cpuNanoseconds},
+            {"wallNanoseconds", totals.wallNanoseconds},
+        };
+    }
+    return json;
+}
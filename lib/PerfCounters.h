@@ -0,0 +1,169 @@
+#ifndef PerfCounters_H
+#define PerfCounters_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <vector>
+
+class Route;
+using Routes = std::vector<Route>;
+
+/** @brief Performance counters of the search neighborhoods.
+ *
+ * Counters are collected per run: the thread driving a run installs a Sink,
+ * and pool tasks inherit the sink and the neighborhood of the thread that
+ * queued them, so work done by workers is charged to the run and the
+ * neighborhood that asked for it. Every thread accumulates into its own block
+ * without synchronization, so counting in hot loops costs one thread-local
+ * increment; the block is folded into the sink when a task or the run ends.
+ *
+ * Candidates are route-level move evaluations: insertion positions priced
+ * and candidate routes rebuilt, the unit of work shared by every
+ * neighborhood and by tabu search. Times of a neighborhood include the
+ * neighborhoods it calls.
+ */
+class PerfCounters {
+  public:
+    /** @brief Instrumented neighborhoods; None is work outside all of them. */
+    enum Neighborhood : std::uint8_t {
+        None,
+        Opt10,
+        Opt11,
+        SwapStar,
+        Opt21,
+        Opt12,
+        Opt22,
+        Exchange,
+        SwapSegments,
+        RuinRecreate,
+        RelatedRuinRecreate,
+        BeamRuinRecreate,
+        PerturbRelatedRuinRecreate,
+        PerturbAngularRuinRecreate,
+        TwoOptStar,
+        BoundaryPairSplit,
+        PairSplit,
+        PairSweepSplit,
+        RouteClusterSplit,
+        CyclicExchange,
+        RelocateSegment,
+        RouteTsp,
+        LongRoutes,
+        InsertRegret,
+        ReduceRoutes,
+        TwoOpt,
+        ThreeOpt,
+        Tabu,
+        Count
+    };
+
+    /** @brief Counters of one neighborhood. */
+    struct Totals {
+        std::uint64_t calls = 0;           /**< Completed calls */
+        std::uint64_t candidates = 0;      /**< Route-level move evaluations */
+        std::uint64_t improvements = 0;    /**< Calls that lowered the cost or the route count */
+        std::int64_t gain = 0;             /**< Sum of cost decreases; perturbations make it negative */
+        std::uint64_t cpuNanoseconds = 0;  /**< CPU time of the caller and of the pool tasks it queued */
+        std::uint64_t wallNanoseconds = 0; /**< Wall time of the calls */
+    };
+
+    using Report = std::array<Totals, Count>;
+
+    class Sink;
+
+    /** @brief Where a thread charges its work: a run and a neighborhood. */
+    struct Context {
+        Sink* sink = nullptr;             /**< Run being counted, none to count nothing */
+        Neighborhood neighborhood = None; /**< Neighborhood being counted */
+    };
+
+    /** @brief Counters of one run, collecting from every thread that works for it.
+     *
+     * Constructing a sink makes the calling thread work for it until the sink
+     * is destroyed; threads without a sink count nothing.
+     */
+    class Sink {
+      public:
+        Sink();
+        ~Sink();
+        Sink(const Sink&) = delete;
+        Sink& operator=(const Sink&) = delete;
+
+        /** @brief Return the counters collected so far, the calling thread's included. */
+        Report Collect();
+
+      private:
+        friend class PerfCounters;
+
+        std::mutex mutex; /**< Guards totals against the threads folding into it */
+        Report totals{};  /**< Counters folded so far */
+        Context previous; /**< Context of the thread before the sink was installed */
+    };
+
+    /** @brief Measure one neighborhood call on a route set; counters are charged when it ends. */
+    class Scope {
+      public:
+        Scope(Neighborhood, const Routes&);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        Neighborhood neighborhood; /**< Neighborhood being measured */
+        Neighborhood previous;     /**< Neighborhood of the thread before the call */
+        const Routes* routes;      /**< Route set the call works on */
+        int costBefore;            /**< Route set cost at the start */
+        std::size_t routesBefore;  /**< Route count at the start */
+        std::uint64_t cpuStart;    /**< Thread CPU time at the start */
+        std::chrono::steady_clock::time_point wallStart; /**< Wall time at the start */
+    };
+
+    /** @brief Charge a pool task, run on a worker thread, to the context that queued it. */
+    class TaskScope {
+      public:
+        explicit TaskScope(Context);
+        ~TaskScope();
+        TaskScope(const TaskScope&) = delete;
+        TaskScope& operator=(const TaskScope&) = delete;
+
+      private:
+        Context previous;       /**< Context of the worker before the task */
+        std::uint64_t cpuStart; /**< Thread CPU time at the start */
+    };
+
+    /** @brief Return the context the calling thread works in, for tasks it queues. */
+    static Context Current() { return counters.context; }
+
+    /** @brief Count route-level move evaluations for the current neighborhood. */
+    static void AddCandidates(std::size_t count) {
+        counters.pending[counters.context.neighborhood].candidates += count;
+    }
+
+    /** @brief Format a report as a text table, most wall time first. */
+    static std::string Table(const Report&);
+
+    /** @brief Format a report as JSON keyed by neighborhood name. */
+    static nlohmann::json Json(const Report&);
+
+  private:
+    /** @brief Counters of one thread not yet folded into its sink. */
+    struct ThreadCounters {
+        Report pending{}; /**< Counters by neighborhood */
+        Context context;  /**< Run and neighborhood charged */
+    };
+
+    static thread_local ThreadCounters counters; /**< Block of the calling thread */
+
+    /** @brief Fold the pending counters of the calling thread into its sink, then work for another context. */
+    static void SwitchTo(Context);
+
+    /** @brief Return the CPU time consumed by the calling thread. */
+    static std::uint64_t ThreadCpuNanoseconds();
+};
+
+#endif /* PerfCounters_H */
@@ -0,0 +1,320 @@
+/*****************************************************************************
+    This file is part of VRP.
+
+    VRP is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    VRP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with VRP.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+
+#include "RouteArchive.h"
+#include "Checkpoint.h"
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <utility>
+
+namespace {
+constexpr std::size_t kInitialBuckets = 64;
+// Stale heap entries are dropped once they outnumber live routes this much.
+constexpr std::size_t kEvictionHeapSlack = 2;
+
+/** @brief Return the Zobrist key of one customer graph index (splitmix64 of the index). */
+std::uint64_t ZobristKey(std::size_t graphIndex) {
+    std::uint64_t key = (static_cast<std::uint64_t>(graphIndex) + 1) * 0x9E3779B97F4A7C15ULL;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+    return key ^ (key >> 31);
+}
+
+/** @brief Return the order-independent signature of the customers served by a route. */
+std::uint64_t MembershipSignature(const Route& route) {
+    const RouteList& steps = *route.GetRoute();
+    std::uint64_t signature = 0;
+    for (std::size_t step = 1; step + 1 < steps.size(); ++step) {
+        signature ^= ZobristKey(steps[step].first.graphIndex);
+    }
+    return signature;
+}
+
+/** @brief Return the archive priority of a route; higher values are evicted first. */
+double RouteArchiveScore(const Route& route) {
+    const int customerCount = std::max(1, route.size() - 2);
+    return static_cast<double>(route.GetTotalCost()) / static_cast<double>(customerCount);
+}
+} // namespace
+
+/** @brief Archive one route.
+ *
+ * A route whose membership is already archived replaces the stored one only
+ * when it is cheaper; otherwise it takes a free slot.
+ * @param[in] route Route with at least one customer
+ */
+void RouteArchive::Add(const Route& route) {
+    if (route.size() <= 2) {
+        return;
+    }
+    if (this->buckets.empty() || (this->liveCount + 1) * 2 > this->buckets.size()) {
+        this->GrowBuckets();
+    }
+    const std::uint64_t signature = MembershipSignature(route);
+    const std::size_t bucket = this->FindBucket(signature);
+    if (this->buckets[bucket].slot != EmptySlot) {
+        Entry& existing = this->entries[this->buckets[bucket].slot];
+        if (route.GetTotalCost() < existing.route.GetTotalCost()) {
+            existing.route = route;
+            ++existing.version;
+            this->PushEviction(this->buckets[bucket].slot);
+        }
+        return;
+    }
+    std::uint32_t slot = 0;
+    if (this->freeSlots.empty()) {
+        slot = static_cast<std::uint32_t>(this->entries.size());
+        this->entries.push_back(Entry{.route = route, .signature = signature, .version = 0, .live = true});
+    } else {
+        slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+        Entry& entry = this->entries[slot];
+        entry.route = route;
+        entry.signature = signature;
+        ++entry.version;
+        entry.live = true;
+    }
+    this->buckets[bucket] = Bucket{.signature = signature, .slot = slot};
+    ++this->liveCount;
+    this->PushEviction(slot);
+}
+
+/** @brief Evict routes with the highest cost per customer.
+ *
+ * Ties are broken by higher cost, then by higher slot, so eviction is
+ * reproducible for a given insertion sequence.
+ * @param[in] limit Maximum number of routes kept
+ */
+void RouteArchive::Trim(std::size_t limit) {
+    while (this->liveCount > limit && !this->evictions.empty()) {
+        std::ranges::pop_heap(this->evictions, &RouteArchive::EvictsBefore);
+        const Eviction worst = this->evictions.back();
+        this->evictions.pop_back();
+        Entry& entry = this->entries[worst.slot];
+        if (!entry.live || entry.version != worst.version) {
+            continue;
+        }
+        this->EraseBucket(this->FindBucket(entry.signature));
+        entry.live = false;
+        ++entry.version;
+        this->freeSlots.push_back(worst.slot);
+        --this->liveCount;
+    }
+    if (this->evictions.size() > (kEvictionHeapSlack * this->liveCount) + kInitialBuckets) {
+        std::erase_if(this->evictions, [this](const Eviction& eviction) {
+            const Entry& entry = this->entries[eviction.slot];
+            return !entry.live || entry.version != eviction.version;
+        });
+        std::ranges::make_heap(this->evictions, &RouteArchive::EvictsBefore);
+    }
+}
+
+/** @brief Forget routes serving a customer that left the instance.
+ *
+ * Their slots are freed as by eviction; heap entries become stale and are
+ * skipped lazily.
+ * @param[in] customer The removed customer
+ */
+void RouteArchive::RemoveRoutesWith(const Customer& customer) {
+    for (std::uint32_t slot = 0; slot < this->entries.size(); ++slot) {
+        Entry& entry = this->entries[slot];
+        if (!entry.live || !entry.route.FindCustomer(customer)) {
+            continue;
+        }
+        this->EraseBucket(this->FindBucket(entry.signature));
+        entry.live = false;
+        ++entry.version;
+        this->freeSlots.push_back(slot);
+        --this->liveCount;
+    }
+}
+
+/** @brief Return the number of archived routes. */
+std::size_t RouteArchive::Size() const { return this->liveCount; }
+
+/** @brief Visit every archived route in slot order. */
+void RouteArchive::ForEachRoute(const std::function<void(const Route&)>& visit) const {
+    for (const Entry& entry : this->entries) {
+        if (entry.live) {
+            visit(entry.route);
+        }
+    }
+}
+
+/** @brief Probe linearly from the home bucket of a signature.
+ *
+ * Signatures are already uniformly mixed, so their low bits pick the bucket.
+ */
+std::size_t RouteArchive::FindBucket(std::uint64_t signature) const {
+    const std::size_t mask = this->buckets.size() - 1;
+    std::size_t bucket = static_cast<std::size_t>(signature) & mask;
+    while (this->buckets[bucket].slot != EmptySlot && this->buckets[bucket].signature != signature) {
+        bucket = (bucket + 1) & mask;
+    }
+    return bucket;
+}
+
+/** @brief Double the signature table, keeping the load factor at most one half. */
+void RouteArchive::GrowBuckets() {
+    std::vector<Bucket> previous = std::exchange(
+        this->buckets, std::vector<Bucket>(std::max(kInitialBuckets, this->buckets.size() * 2)));
+    for (const Bucket& bucket : previous) {
+        if (bucket.slot != EmptySlot) {
+            this->buckets[this->FindBucket(bucket.signature)] = bucket;
+        }
+    }
+}
+
+/** @brief Free a bucket and shift later members of its probe chain back.
+ *
+ * A later bucket moves into the hole unless its home lies cyclically after
+ * the hole, which would make it unreachable from there.
+ */
+void RouteArchive::EraseBucket(std::size_t hole) {
+    const std::size_t mask = this->buckets.size() - 1;
+    this->buckets[hole] = Bucket{};
+    for (std::size_t next = (hole + 1) & mask; this->buckets[next].slot != EmptySlot; next = (next + 1) & mask) {
+        const std::size_t home = static_cast<std::size_t>(this->buckets[next].signature) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            this->buckets[hole] = this->buckets[next];
+            this->buckets[next] = Bucket{};
+            hole = next;
+        }
+    }
+}
+
+/** @brief Push the current route of a slot onto the eviction heap. */
+void RouteArchive::PushEviction(std::uint32_t slot) {
+    const Entry& entry = this->entries[slot];
+    this->evictions.push_back(Eviction{.score = RouteArchiveScore(entry.route),
+                                       .cost = entry.route.GetTotalCost(),
+                                       .slot = slot,
+                                       .version = entry.version});
+    std::ranges::push_heap(this->evictions, &RouteArchive::EvictsBefore);
+}
+
+/** @brief Compare eviction candidates; the greatest one is evicted first. */
+bool RouteArchive::EvictsBefore(const Eviction& left, const Eviction& right) {
+    if (left.score != right.score) {
+        return left.score < right.score;
+    }
+    if (left.cost != right.cost) {
+        return left.cost < right.cost;
+    }
+    return left.slot < right.slot;
+}
+
+/** @brief Save the archive layout as is, stale heap entries included.
+ *
+ * Slots, probe order and heap order decide which route is evicted next and
+ * in which order recombination visits routes, so a resumed run restores
+ * them exactly rather than re-adding the routes.
+ * @param[in,out] out Checkpoint being written
+ */
+void RouteArchive::Save(CheckpointWriter& out) const {
+    out.U32(static_cast<std::uint32_t>(this->entries.size()));
+    for (const Entry& entry : this->entries) {
+        out.RouteSteps(entry.route);
+        out.U64(entry.signature);
+        out.U32(entry.version);
+        out.U32(entry.live ? 1 : 0);
+    }
+    out.U32(static_cast<std::uint32_t>(this->freeSlots.size()));
+    for (const std::uint32_t slot : this->freeSlots) {
+        out.U32(slot);
+    }
+    out.U32(static_cast<std::uint32_t>(this->buckets.size()));
+    for (const Bucket& bucket : this->buckets) {
+        out.U64(bucket.signature);
+        out.U32(bucket.slot);
+    }
+    out.U32(static_cast<std::uint32_t>(this->evictions.size()));
+    for (const Eviction& eviction : this->evictions) {
+        out.F64(eviction.score);
+        out.I32(eviction.cost);
+        out.U32(eviction.slot);
+        out.U32(eviction.version);
+    }
+    out.U64(this->liveCount);
+}
+
+/** @brief Restore an archive saved by Save.
+ *
+ * Every slot must name a stored entry, the signature table must keep the
+ * layout Add and GrowBuckets give it, and the live count must match the live
+ * entries and occupied buckets; otherwise the checkpoint is rejected before
+ * any lookup can index out of range or probe a full table forever.
+ * @param[in,out] in Checkpoint being read
+ * @param[in] empty Route without customers, carrying the run parameters
+ * @throws std::runtime_error when the archive layout is inconsistent
+ */
+void RouteArchive::Load(CheckpointReader& in, const Route& empty) {
+    this->entries.clear();
+    for (std::uint32_t count = in.U32(); count > 0; --count) {
+        Route route = in.RouteSteps(empty);
+        const std::uint64_t signature = in.U64();
+        const std::uint32_t version = in.U32();
+        const bool live = in.U32() != 0;
+        this->entries.push_back(
+            Entry{.route = std::move(route), .signature = signature, .version = version, .live = live});
+    }
+    this->freeSlots.clear();
+    for (std::uint32_t count = in.U32(); count > 0; --count) {
+        this->freeSlots.push_back(in.U32());
+    }
+    this->buckets.clear();
+    for (std::uint32_t count = in.U32(); count > 0; --count) {
+        const std::uint64_t signature = in.U64();
+        this->buckets.push_back(Bucket{.signature = signature, .slot = in.U32()});
+    }
+    this->evictions.clear();
+    for (std::uint32_t count = in.U32(); count > 0; --count) {
+        const double score = in.F64();
+        const int cost = in.I32();
+        const std::uint32_t slot = in.U32();
+        this->evictions.push_back(Eviction{.score = score, .cost = cost, .slot = slot, .version = in.U32()});
+    }
+    this->liveCount = static_cast<std::size_t>(in.U64());
+
+    auto validSlot = [this](std::uint32_t slot) { return slot < this->entries.size(); };
+    if (!std::ranges::all_of(this->evictions, validSlot, &Eviction::slot) ||
+        !std::ranges::all_of(this->freeSlots,
+                             [this, &validSlot](std::uint32_t slot) {
+                                 return validSlot(slot) && !this->entries[slot].live;
+                             })) {
+        CorruptCheckpoint("route archive slot out of range");
+    }
+    if (!this->buckets.empty() &&
+        (this->buckets.size() < kInitialBuckets || !std::has_single_bit(this->buckets.size()))) {
+        CorruptCheckpoint("route archive table of " + std::to_string(this->buckets.size()) + " buckets");
+    }
+    std::size_t occupied = 0;
+    for (const Bucket& bucket : this->buckets) {
+        if (bucket.slot == EmptySlot) {
+            continue;
+        }
+        if (!validSlot(bucket.slot) || !this->entries[bucket.slot].live) {
+            CorruptCheckpoint("route archive bucket of a missing route");
+        }
+        ++occupied;
+    }
+    const auto live = static_cast<std::size_t>(std::ranges::count_if(this->entries, &Entry::live));
+    if (live != this->liveCount || occupied != this->liveCount || this->liveCount * 2 > this->buckets.size()) {
+        CorruptCheckpoint("route archive live count " + std::to_string(this->liveCount));
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef RouteArchive_H
+#define RouteArchive_H
+
+#include "Route.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/** @brief Bounded archive of route memberships for set-partitioning recombination.
+ *
+ * A membership is identified by its Zobrist signature: the XOR of a fixed
+ * pseudo-random 64-bit key per customer graph index, so it is independent of
+ * the visit order and costs one pass over the route. Signatures index the
+ * stored routes through an open-addressing table, and a heap ordered by
+ * cost per customer finds the route to evict in logarithmic time. Replaced
+ * or evicted routes leave stale heap entries behind, recognized by their
+ * version and skipped lazily.
+ *
+ * Two different memberships sharing a 64-bit signature are treated as one;
+ * at archive sizes this is negligibly unlikely and only drops a candidate.
+ */
+class RouteArchive {
+  public:
+    /** @brief Insert a route, or replace an archived route of the same membership when cheaper. */
+    void Add(const Route&);
+
+    /** @brief Evict the worst routes by cost per customer until at most the given number remain. */
+    void Trim(std::size_t);
+
+    /** @brief Drop every archived route that serves a customer. */
+    void RemoveRoutesWith(const Customer&);
+
+    /** @brief Return the number of archived routes. */
+    [[nodiscard]] std::size_t Size() const;
+
+    /** @brief Visit every archived route in storage order. */
+    void ForEachRoute(const std::function<void(const Route&)>&) const;
+
+    /** @brief Write slots, signature table and eviction heap to a checkpoint. */
+    void Save(CheckpointWriter&) const;
+
+    /** @brief Replace the archive with one stored in a checkpoint, rebuilding routes from an empty one. */
+    void Load(CheckpointReader&, const Route&);
+
+  private:
+    static constexpr std::uint32_t EmptySlot = std::numeric_limits<std::uint32_t>::max();
+
+    /** @brief One stored route and its membership signature. */
+    struct Entry {
+        Route route;               /**< Cheapest route seen for the membership */
+        std::uint64_t signature;   /**< Zobrist signature of the membership */
+        std::uint32_t version = 0; /**< Bumped whenever the slot changes, invalidating heap entries */
+        bool live = false;         /**< Whether the slot currently holds a route */
+    };
+
+    /** @brief Open-addressing bucket mapping a signature to an entry slot. */
+    struct Bucket {
+        std::uint64_t signature = 0;    /**< Membership signature */
+        std::uint32_t slot = EmptySlot; /**< Entry slot, EmptySlot when the bucket is free */
+    };
+
+    /** @brief Eviction candidate; the heap keeps the worst route on top. */
+    struct Eviction {
+        double score;          /**< Route cost per customer */
+        int cost;              /**< Route cost, breaking score ties */
+        std::uint32_t slot;    /**< Entry slot */
+        std::uint32_t version; /**< Entry version when pushed */
+    };
+
+    /** @brief Return the bucket holding a signature, or the free bucket where it belongs. */
+    [[nodiscard]] std::size_t FindBucket(std::uint64_t) const;
+
+    /** @brief Double the bucket table and reinsert every live signature. */
+    void GrowBuckets();
+
+    /** @brief Remove a signature with backward-shift deletion, keeping probe chains intact. */
+    void EraseBucket(std::size_t);
+
+    /** @brief Queue the current content of a slot for eviction ordering. */
+    void PushEviction(std::uint32_t);
+
+    /** @brief Heap order by score, cost, then slot, so the route to evict first compares greatest. */
+    static bool EvictsBefore(const Eviction&, const Eviction&);
+
+    std::vector<Entry> entries;           /**< Route slots, reused after eviction */
+    std::vector<std::uint32_t> freeSlots; /**< Slots released by eviction */
+    std::vector<Bucket> buckets;          /**< Signature table, power-of-two sized */
+    std::vector<Eviction> evictions;      /**< Max-heap of eviction candidates, possibly stale */
+    std::size_t liveCount = 0;            /**< Number of archived routes */
+};
+
+#endif /* RouteArchive_H */
@@ -1,6 +1,7 @@
 #ifndef ThreadPool_H
 #define ThreadPool_H
 
+#include "PerfCounters.h"
 #include <condition_variable>
 #include <exception>
 #include <functional>
@@ -102,19 +103,37 @@ class ThreadPool {
     /** @brief Queue a task for asynchronous execution.
      *
      * Tasks submitted after shutdown starts are ignored. This keeps destructor
-     * cleanup idempotent and avoids racing new work against JoinAll.
+     * cleanup idempotent and avoids racing new work against JoinAll. A task is
+     * charged to the run and the neighborhood of the thread that queued it.
      */
     void AddTask(std::function<void(void)> job) {
+        std::function<void(void)> task = [job = std::move(job), context = PerfCounters::Current()] {
+            PerfCounters::TaskScope scope(context);
+            job();
+        };
         {
             std::scoped_lock lock(queue_mutex);
             if (stop) {
                 return;
             }
-            queue.emplace_back(std::move(job));
+            queue.emplace_back(std::move(task));
         }
         wait_var.notify_one();
     }
 
+    /** @brief Wait until every queued and active task has finished, keeping the workers.
+     *
+     * Lets a caller run phases that depend on each other on one pool instead
+     * of starting and joining new threads for every phase.
+     */
+    void WaitIdle() {
+        if (CurrentPool() == this) {
+            throw std::logic_error("ThreadPool::WaitIdle cannot be called from a worker thread");
+        }
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        complete_var.wait(lock, [this]() -> bool { return queue.empty() && activeTasks == 0; });
+    }
+
     /** @brief Wait for all queued and active tasks, then join workers.
      *
      * This method is safe to call explicitly and is also called by the
@@ -20,13 +20,16 @@
 #include <fstream>
 #include <limits>
 #include <set>
+#include <stdexcept>
 #include <utility>
 
 namespace {
 using Json = nlohmann::json;
 
 constexpr const char* kInvalidFileFormat = "Invalid file format!";
-constexpr const char* kUsage = "Usage: ./VRP [-v] data.json";
+constexpr const char* kUsage = "Usage: ./VRP [-v] [--warm-start result.json] [--checkpoint FILE] [--resume FILE] "
+                               "[--deterministic MOVES] data.json | "
+                               "./VRP [-v] --batch [--cores N] path... | ./VRP [-v] --serve [--socket PATH]";
 
 int JsonSizeToInt(std::size_t size) {
     if (size > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
@@ -46,41 +49,72 @@ void RequirePositive(int value) {
         throw std::runtime_error(kInvalidFileFormat);
     }
 }
+
+/** @brief Parse the positive evaluated-move budget of a deterministic run. */
+long long ParseWorkBudget(const char* text) {
+    long long budget = 0;
+    try {
+        budget = std::stoll(text);
+    } catch (const std::logic_error&) {
+        throw std::runtime_error(kUsage);
+    }
+    if (budget <= 0) {
+        throw std::runtime_error(kUsage);
+    }
+    return budget;
+}
 } // namespace
 
 /** @brief Instantiate all parameters from command-line input and JSON.
  *
- * Parse the input file in JSON format and instantiates all variables
- * for the algorithm.
+ * Parse the command line and load the input file it names.
  * @param[in] argc Number of arguments passed through command line.
  * @param[in] argv Input file (json).
  * @param[in] costTravel Cost parameter for each travel.
  * @param[in] alphaParam Alpha parameter for route evaluation.
- * @return The pointer to VRP class
+ * @return The loaded VRP model
  */
-VRP* Utils::InitParameters(int argc, char** argv, const float costTravel, const float alphaParam) {
-    /* error string */
-    std::string s;
-    VRP* v = nullptr;
-    Graph g;
-    int fileIndex = 0;
-    if (argc == 2) {
-        fileIndex = 1;
-    } else if (argc == 3 && strcmp(argv[1], "-v") == 0) {
+std::unique_ptr<VRP> Utils::InitParameters(int argc, char** argv, const float costTravel, const float alphaParam) {
+    int index = 1;
+    if (index < argc && strcmp(argv[index], "-v") == 0) {
         this->verbose = true;
-        fileIndex = 2;
-    } else {
+        ++index;
+    }
+    // every option takes a value, and the instance file comes last
+    for (; index + 2 < argc; index += 2) {
+        if (strcmp(argv[index], "--warm-start") == 0) {
+            this->warmStartFile = argv[index + 1];
+        } else if (strcmp(argv[index], "--checkpoint") == 0) {
+            this->checkpointFile = argv[index + 1];
+        } else if (strcmp(argv[index], "--resume") == 0) {
+            this->resumeFile = argv[index + 1];
+        } else if (strcmp(argv[index], "--deterministic") == 0) {
+            this->workBudget = ParseWorkBudget(argv[index + 1]);
+        } else {
+            throw std::runtime_error(kUsage);
+        }
+    }
+    if (index != argc - 1 || (!this->warmStartFile.empty() && !this->resumeFile.empty())) {
         throw std::runtime_error(kUsage);
     }
-    std::string file(argv[fileIndex]);
+    return this->LoadInstance(argv[index], costTravel, alphaParam);
+}
+
+/** @brief Load one instance file.
+ *
+ * Parse the input file in JSON format and instantiates all variables
+ * for the algorithm.
+ * @param[in] file Path of the JSON instance.
+ * @param[in] costTravel Cost parameter for each travel.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @return The loaded VRP model
+ */
+std::unique_ptr<VRP> Utils::LoadInstance(const std::string& file, const float costTravel, const float alphaParam) {
     std::size_t found = file.find_last_of("/\\");
     this->filename = file.substr(found + 1);
-    std::ifstream input(argv[fileIndex]);
+    std::ifstream input(file);
     if (!input) {
-        if (argc == 3)
-            throw std::runtime_error("The file " + std::string(argv[fileIndex]) + " doesn't exist.");
-        else
-            throw std::runtime_error("No input file.");
+        throw std::runtime_error("The file " + file + " doesn't exist.");
     }
 
     try {
@@ -88,10 +122,43 @@ VRP* Utils::InitParameters(int argc, char** argv, const float costTravel, const
     } catch (const Json::parse_error& e) {
         throw std::runtime_error("Error(byte " + std::to_string(e.byte) + "): " + std::string(e.what()));
     }
+    return BuildModel(ParseInstance(this->d), costTravel, alphaParam);
+}
+
+/** @brief Read the routes of a saved result.
+ *
+ * Accepts any JSON file with a "routes" array of customer-name arrays, such
+ * as the files SaveResult writes to vrp-init.
+ * @param[in] file Path of the JSON result.
+ * @return Customer names of each route
+ */
+std::vector<std::vector<std::string>> Utils::LoadRoutes(const std::string& file) {
+    std::ifstream input(file);
+    if (!input) {
+        throw std::runtime_error("The file " + file + " doesn't exist.");
+    }
+    try {
+        return Json::parse(input).at("routes").get<std::vector<std::vector<std::string>>>();
+    } catch (const Json::exception& e) {
+        throw std::runtime_error("Invalid routes in " + file + ": " + std::string(e.what()));
+    }
+}
 
+/** @brief Validate one instance document and build its graph.
+ *
+ * Every vertex, edge and fleet parameter is checked; the document is only
+ * read, so one parsed instance can back several concurrent solves.
+ * @param[in] document The JSON instance
+ * @return The parsed instance data
+ */
+InstanceData Utils::ParseInstance(const Json& document) {
+    /* error string */
+    std::string s;
+    InstanceData data;
+    Graph& g = data.graph;
     try {
         s = kInvalidFileFormat;
-        const Json& vertices = this->d.at("vertices");
+        const Json& vertices = document.at("vertices");
         if (!vertices.is_array() || vertices.empty()) {
             throw std::runtime_error(s);
         }
@@ -131,7 +198,7 @@ VRP* Utils::InitParameters(int argc, char** argv, const float costTravel, const
         }
 
         /* parsing all costs, graph edge */
-        const Json& costs = this->d.at("costs");
+        const Json& costs = document.at("costs");
         if (!costs.is_array()) {
             throw std::runtime_error(s);
         }
@@ -172,10 +239,9 @@ VRP* Utils::InitParameters(int argc, char** argv, const float costTravel, const
             }
         }
 
-        /* creating the VRP */
-        const int vehicles = this->d.at("vehicles").get<int>();
-        const int capacity = this->d.at("capacity").get<int>();
-        const int workTime = this->d.at("worktime").get<int>();
+        const int vehicles = document.at("vehicles").get<int>();
+        const int capacity = document.at("capacity").get<int>();
+        const int workTime = document.at("worktime").get<int>();
         RequirePositive(vehicles);
         RequirePositive(capacity);
         RequireNonNegative(workTime);
@@ -183,13 +249,31 @@ VRP* Utils::InitParameters(int argc, char** argv, const float costTravel, const
         for (int i = 1; i < numVertices; ++i) {
             totalDemand += customers[static_cast<std::size_t>(i)].request;
         }
-        const int minimumRoutes = (totalDemand + capacity - 1) / capacity;
-        v = new VRP(std::move(g), numVertices, vehicles, capacity, minimumRoutes, static_cast<float>(workTime),
-                    flagTime, costTravel, alphaParam);
+        data.numVertices = numVertices;
+        data.vehicles = vehicles;
+        data.capacity = capacity;
+        data.minimumRoutes = (totalDemand + capacity - 1) / capacity;
+        data.workTime = workTime;
+        data.flagTime = flagTime;
     } catch (const Json::exception& e) {
         throw std::runtime_error(s + " " + std::string(e.what()));
     }
-    return v;
+    return data;
+}
+
+/** @brief Create the VRP model of parsed instance data.
+ *
+ * The data is taken by value: callers move a freshly parsed instance in, or
+ * pass a cached one to get a model over its own copy of the graph.
+ * @param[in] data The parsed instance
+ * @param[in] costTravel Cost parameter for each travel.
+ * @param[in] alphaParam Alpha parameter for route evaluation.
+ * @return The VRP model
+ */
+std::unique_ptr<VRP> Utils::BuildModel(InstanceData data, const float costTravel, const float alphaParam) {
+    return std::make_unique<VRP>(std::move(data.graph), data.numVertices, data.vehicles, data.capacity,
+                                 data.minimumRoutes, static_cast<float>(data.workTime), data.flagTime, costTravel,
+                                 alphaParam);
 }
 
 /** @brief Save the result.
@@ -227,3 +311,40 @@ void Utils::SaveResult(const Routes& routes, long long t) {
         throw std::runtime_error("Error writing file! (Bad permissions)");
     }
 }
+
+/** @brief Save the neighborhood performance report.
+ *
+ * The report goes to vrp-init/<instance>.perf.json; runs without an instance
+ * file, such as solve server requests, have nowhere to put it and skip it.
+ * @param[in] report Counters by neighborhood
+ */
+void Utils::SavePerfReport(const nlohmann::json& report) {
+    if (this->filename.empty()) {
+        return;
+    }
+    const std::string path = "vrp-init/" + this->filename.substr(0, this->filename.rfind('.')) + ".perf.json";
+    std::ofstream output(path);
+    output << report.dump(4) << '\n';
+    if (!output) {
+        throw std::runtime_error("Error writing file! (Bad permissions)");
+    }
+    this->logger("Saving the performance report inside " + path, this->VERBOSE);
+}
+
+/** @brief Send every later message of this object to a file.
+ *
+ * @param[in] path Log file to create or truncate
+ */
+void Utils::LogToFile(const std::string& path) {
+    this->logFile.open(path, std::ios::trunc);
+    if (!this->logFile) {
+        throw std::runtime_error("Error writing file! (Bad permissions)");
+    }
+    this->out = &this->logFile;
+}
+
+/** @brief Send every later message of this object to a stream.
+ *
+ * @param[in] stream Destination that must outlive this object
+ */
+void Utils::LogToStream(std::ostream& stream) { this->out = &stream; }
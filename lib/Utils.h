@@ -3,27 +3,55 @@
 
 #include "VRP.h"
 #include "Route.h"
+#include <fstream>
+#include <iostream>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
 
 class VRP;
 
-/** @brief Utility singleton for input parsing, output writing, and logging.
+/** @brief Instance data parsed from JSON, from which any number of models can be built. */
+struct InstanceData {
+    Graph graph;           /**< Customers and travel costs */
+    int numVertices = 0;   /**< Number of vertices, depot included */
+    int vehicles = 0;      /**< Number of vehicles */
+    int capacity = 0;      /**< Capacity of each vehicle */
+    int minimumRoutes = 0; /**< Capacity lower bound for the number of required routes */
+    int workTime = 0;      /**< Work time for each driver */
+    bool flagTime = false; /**< True when some customer needs service time */
+};
+
+/** @brief Input parsing, output writing, and logging for one solver run.
  *
- * Utils owns the JSON document used during initialization and provides process-wide
- * helpers for reading instances, saving route results, and emitting colored
- * console messages.
+ * Every Utils object owns the JSON document of the instance it loaded, the
+ * stream its messages go to and its verbosity, so concurrent runs each keep
+ * their own; the search of a run traces through the Utils of its controller.
+ * Instance() returns the process-wide object of the front ends (command line,
+ * batch and server); writes from all objects are serialized line by line.
  */
 class Utils {
   public:
     Utils(Utils const&) = delete;
     Utils& operator=(Utils const&) = delete;
 
-  private:
-    /** @brief Hide construction behind the singleton accessor. */
+    /** @brief Create a run-local utility object logging to standard output. */
     Utils() = default;
-    nlohmann::json d; /**< Parsed input and output JSON document */
+
+  private:
+    nlohmann::json d;               /**< Parsed input and output JSON document */
+    std::ostream* out = &std::cout; /**< Destination of logged messages */
+    std::ofstream logFile;          /**< Owned log file when messages are redirected */
+
+    /** @brief Return the lock serializing messages from every Utils object. */
+    static std::mutex& OutputMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
     const char* ANSI_RESET = "\u001B[0m";
     const char* ANSI_RED = "\u001B[1;31m";
     const char* ANSI_YELLOW = "\u001B[33m";
@@ -32,7 +60,7 @@ class Utils {
     const char* ANSI_IBLUE = "\x1b[0;94m";
 
   public:
-    /** @brief Return the shared utility instance. */
+    /** @brief Return the process-wide utility instance of the front ends. */
     static Utils& Instance() {
         static Utils instance;
         return instance;
@@ -44,38 +72,67 @@ class Utils {
     static const int VERBOSE = 4; /**< Verbose code */
     bool verbose = false;
     std::string filename = "";
+    std::string warmStartFile = "";  /**< Saved result whose routes start the search, empty for none */
+    std::string checkpointFile = ""; /**< Checkpoint written during the search, empty for none */
+    std::string resumeFile = "";     /**< Checkpoint the search continues from, empty for none */
+    long long workBudget = 0;        /**< Evaluated-move budget of a deterministic run, 0 for timed runs */
 
     /** @brief Parse CLI arguments and JSON input into a VRP instance. */
-    VRP* InitParameters(int, char**, const float, const float);
+    std::unique_ptr<VRP> InitParameters(int, char**, const float, const float);
+
+    /** @brief Parse one JSON instance file into a VRP instance. */
+    std::unique_ptr<VRP> LoadInstance(const std::string&, const float, const float);
+
+    /** @brief Read the "routes" array of customer names from a saved result file. */
+    static std::vector<std::vector<std::string>> LoadRoutes(const std::string&);
+
+    /** @brief Validate one JSON instance document and build its graph. */
+    static InstanceData ParseInstance(const nlohmann::json&);
+
+    /** @brief Create a VRP model over a copy of parsed instance data. */
+    static std::unique_ptr<VRP> BuildModel(InstanceData, const float, const float);
 
     /** @brief Save the supplied routes as the result for a run timestamp/index. */
     void SaveResult(const Routes&, long long);
 
+    /** @brief Save the neighborhood performance report next to the result. */
+    void SavePerfReport(const nlohmann::json&);
+
+    /** @brief Redirect logged messages to a file, truncating it. */
+    void LogToFile(const std::string&);
+
+    /** @brief Redirect logged messages to a stream owned by the caller. */
+    void LogToStream(std::ostream&);
+
     /** @brief Print a log string
      *
      * @param[in] s The string to print
      * @param[in] c The code for log level
      */
     template <typename T> void logger(const T& s, int c = 5) const {
+        if (c == VERBOSE && !this->verbose) {
+            return;
+        }
+        std::scoped_lock lock(OutputMutex());
+        std::ostream& stream = *this->out;
         switch (c) {
         case SUCCESS:
-            std::cout << ANSI_LIGHTGREEN << s << ANSI_RESET << std::endl;
+            stream << ANSI_LIGHTGREEN << s << ANSI_RESET << std::endl;
             break;
         case WARNING:
-            std::cout << ANSI_YELLOW << "[w]\t" << s << ANSI_RESET << std::endl;
+            stream << ANSI_YELLOW << "[w]\t" << s << ANSI_RESET << std::endl;
             break;
         case ERROR:
-            std::cout << ANSI_RED << "\r\n" << s << ANSI_RESET << std::endl;
+            stream << ANSI_RED << "\r\n" << s << ANSI_RESET << std::endl;
             break;
         case INFO:
-            std::cout << ANSI_BLUE << s << ANSI_RESET << std::endl;
+            stream << ANSI_BLUE << s << ANSI_RESET << std::endl;
             break;
         case VERBOSE:
-            if (this->verbose)
-                std::cout << ANSI_IBLUE << "[-]\t" << s << ANSI_RESET << std::endl;
+            stream << ANSI_IBLUE << "[-]\t" << s << ANSI_RESET << std::endl;
             break;
         default:
-            std::cout << s << std::endl;
+            stream << s << std::endl;
             break;
         }
     }
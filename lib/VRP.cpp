@@ -16,31 +16,64 @@
  ****************************************************************************/
 
 #include "VRP.h"
+#include "Checkpoint.h"
+#include "HeldKarp.h"
+#include "ThreadPool.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cmath>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <list>
 #include <map>
+#include <mutex>
+#include <numeric>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 using Map = std::multimap<int, Customer>;
 
 namespace {
-/** @brief Active route fragment used by the Clarke-Wright savings initializer. */
-struct SavingsRoute {
-    std::vector<Customer> customers;
-    bool active;
+/** @brief Aggregates of one Clarke-Wright route fragment, kept at its union-find root. */
+struct SavingsFragment {
+    int head = 0;    /**< Customer visited first after the depot */
+    int tail = 0;    /**< Customer visited last before the depot */
+    int demand = 0;  /**< Summed customer demand */
+    int service = 0; /**< Summed customer service time */
+    int travel = 0;  /**< Depot-to-depot travel cost */
+    int slot = 0;    /**< Output position; a merge keeps the slot of its first fragment */
+};
+
+/** @brief Union-find forest of the Clarke-Wright savings routes.
+ *
+ * Every customer starts as its own depot-return fragment. Fragments are
+ * chained through at most two links per customer, so a customer is a route
+ * end exactly while it has a free link, and the fragment of a customer is
+ * found by path-halving union-find.
+ */
+struct SavingsForest {
+    std::vector<int> parent;                /**< Union-find parent of every customer */
+    std::vector<std::array<int, 2>> links;  /**< Adjacent customers, -1 when free */
+    std::vector<SavingsFragment> fragments; /**< Fragment aggregates, valid at roots */
 };
 
-/** @brief Potential customer-pair merge ordered by distance saving. */
+/** @brief Potential customer-pair merge ordered by distance saving.
+ *
+ * Customers are referenced by their position in the construction customer
+ * list, keeping each of the n^2/2 entries at twelve bytes.
+ */
 struct Saving {
-    Customer first;
-    Customer second;
-    double value;
+    int first;
+    int second;
+    float value;
 };
 
 /** @brief Customer annotated with its polar angle around the depot. */
@@ -49,11 +82,17 @@ struct SweepCustomer {
     double angle;
 };
 
-/** @brief Feasible contiguous sweep segment and its standalone route cost. */
-struct SweepSegment {
-    std::vector<Customer> route;
-    int cost = 0;
-    bool feasible = false;
+/** @brief Angular customer order with prefix sums over two laps.
+ *
+ * Position k of the doubled order is customers[k % n], so every circular arc
+ * of any rotation is a plain index range and its demand and sweep-path cost
+ * are prefix differences, shared read-only by all rotations.
+ */
+struct SweepOrder {
+    std::vector<Customer> customers; /**< Customers by polar angle around the depot */
+    std::vector<int> depotCost;      /**< Depot-to-customer cost of every customer */
+    std::vector<int> demandPrefix;   /**< Demand of the first k positions of the doubled order */
+    std::vector<int> pathPrefix;     /**< Cost of the sweep path from position 0 to position k */
 };
 
 /** @brief Complete sweep partition candidate with total cost. */
@@ -71,38 +110,82 @@ struct RoutePoolCandidate {
     int cost = 0;
 };
 
-/** @brief Mutable state for exact search over route-pool candidates. */
+/** @brief Exact search over route-pool candidates, shared by all subtree workers.
+ *
+ * The best cover is kept as pool indexes and only turned into routes once the
+ * search ends, so complete covers that do not beat it cost nothing. Its route
+ * count and cost are also published as one packed atomic value, so workers
+ * prune against covers found by other subtrees without taking the lock.
+ */
 struct RoutePoolSearch {
-    Routes bestRoutes;
+    std::mutex bestMutex;                  /**< Guards bestSelected */
+    std::vector<std::size_t> bestSelected; /**< Pool indexes of the best cover, empty while the incumbent leads */
+    std::atomic<std::uint64_t> best;       /**< Route count in the high and cost in the low 32 bits */
+    std::vector<double> costShare;         /**< Cost per customer of every pool route, for lower bounds */
+    std::vector<double> customerDual;      /**< Lagrangian price of covering each customer */
+    std::vector<double> reducedCost;       /**< Pool route cost minus the prices of its customers */
     int minimumRoutes = 0;
     int capacity = 0;
     int customerCount = 0;
     int totalDemand = 0;
-    std::size_t nodesVisited = 0;
+    std::atomic<std::size_t> nodesVisited; /**< Nodes expanded by all workers */
     std::size_t nodeLimit = 0;
-    bool nodeLimitReached = false;
+    std::atomic<bool> nodeLimitReached;
 };
 
-constexpr std::size_t kArchiveRoutesPerCustomer = 2;
+/** @brief Lagrangian dual solution of the set-partitioning model over a route pool. */
+struct RoutePoolDuals {
+    std::vector<double> customerDual; /**< Price of covering each customer */
+    std::vector<double> reducedCost;  /**< Route cost minus the prices of its customers */
+    double bound = 0.0;               /**< Lower bound on the cost of any exact cover */
+};
+
+constexpr std::size_t kArchiveRoutesPerCustomer = 8;
 constexpr std::size_t kArchiveRoutesPerRequiredRoute = 8;
 constexpr std::size_t kMinRoutePoolCustomerChoices = 8;
 constexpr std::size_t kRoutePoolChoiceSlack = 2;
-constexpr std::size_t kRoutePoolNodeBudgetMultiplier = 4;
+constexpr std::size_t kRoutePoolNodeBudgetMultiplier = 16;
+// Cover costs are integers, so a bound within rounding noise of the next
+// better cost must not prune.
+constexpr double kRoutePoolBoundTolerance = 1e-6;
+constexpr int kRoutePoolDualIterations = 200;
+constexpr double kRoutePoolDualInitialStep = 2.0;
+constexpr int kRoutePoolDualStallIterations = 10;
 constexpr int kMaxFreshTabuRestarts = 1;
+// Warm-start repairs insert few customers into many nearly full routes; a
+// third route option flags customers about to lose their last good slot.
+constexpr int kWarmStartRegretDegree = 3;
+// Clarke-Wright savings weights of the multi-start construction.
+constexpr std::array<double, 9> kSavingsLambdas = {0.4, 0.6, 0.8, 1.0, 1.2, 1.4, 1.6, 1.8, 2.0};
+
+/** @brief Return the union-find root of the fragment holding a customer. */
+int FindSavingsFragment(SavingsForest& forest, int customer) {
+    while (forest.parent[static_cast<std::size_t>(customer)] != customer) {
+        int& parent = forest.parent[static_cast<std::size_t>(customer)];
+        parent = forest.parent[static_cast<std::size_t>(parent)];
+        customer = parent;
+    }
+    return customer;
+}
 
-/** @brief Check whether a customer is at either end of a savings route. */
-bool IsRouteEnd(const SavingsRoute& route, const Customer& customer) {
-    return !route.customers.empty() && (route.customers.front() == customer || route.customers.back() == customer);
+/** @brief Check whether a customer is at either end of its savings fragment. */
+bool IsFragmentEnd(const SavingsForest& forest, int customer) {
+    return forest.links[static_cast<std::size_t>(customer)][1] < 0;
 }
 
-/** @brief Find the active savings route that currently contains a customer. */
-int FindSavingsRouteIndex(const std::vector<SavingsRoute>& routes, const Customer& customer) {
-    for (std::size_t i = 0; i < routes.size(); ++i) {
-        if (routes[i].active && std::ranges::find(routes[i].customers, customer) != routes[i].customers.end()) {
-            return static_cast<int>(i);
-        }
-    }
-    return -1;
+/** @brief Return the customer order of a fragment, walking its links from the head. */
+std::vector<Customer> FragmentCustomers(const SavingsForest& forest, const SavingsFragment& fragment,
+                                        const std::vector<Customer>& customers) {
+    std::vector<Customer> order;
+    int previous = -1;
+    for (int current = fragment.head; current >= 0;) {
+        order.push_back(customers[static_cast<std::size_t>(current)]);
+        const std::array<int, 2>& next = forest.links[static_cast<std::size_t>(current)];
+        const int following = next[0] != previous ? next[0] : next[1];
+        previous = current;
+        current = following;
+    }
+    return order;
 }
 
 /** @brief Build a depot-to-depot customer list from an internal customer order. */
@@ -114,19 +197,25 @@ std::list<Customer> BuildRouteCustomers(const Customer& depot, const std::vector
     return route;
 }
 
-/** @brief Merge two savings route fragments so the selected customers become adjacent. */
-std::vector<Customer> MergeSavingsRoutes(const SavingsRoute& firstRoute, const Customer& firstCustomer,
-                                         const SavingsRoute& secondRoute, const Customer& secondCustomer) {
-    std::vector<Customer> first = firstRoute.customers;
-    std::vector<Customer> second = secondRoute.customers;
-    if (first.front() == firstCustomer) {
-        std::ranges::reverse(first);
-    }
-    if (second.back() == secondCustomer) {
-        std::ranges::reverse(second);
-    }
-    first.insert(first.end(), second.cbegin(), second.cend());
-    return first;
+/** @brief Join two fragments so the selected customers become adjacent.
+ *
+ * The first fragment is oriented to end at its selected customer and the
+ * second to start at its own, so the new ends are the opposite ends. Only
+ * links and root aggregates change; no customer sequence is copied.
+ * @param[in,out] forest Savings forest
+ * @param[in] first Route end customer of the first fragment
+ * @param[in] second Route end customer of the second fragment
+ * @param[in] merged Aggregates of the joined fragment
+ */
+void MergeSavingsFragments(SavingsForest& forest, int first, int second, SavingsFragment merged) {
+    const int firstRoot = FindSavingsFragment(forest, first);
+    const int secondRoot = FindSavingsFragment(forest, second);
+    std::array<int, 2>& firstLinks = forest.links[static_cast<std::size_t>(first)];
+    std::array<int, 2>& secondLinks = forest.links[static_cast<std::size_t>(second)];
+    firstLinks[firstLinks[0] < 0 ? 0 : 1] = second;
+    secondLinks[secondLinks[0] < 0 ? 0 : 1] = first;
+    forest.parent[static_cast<std::size_t>(secondRoot)] = firstRoot;
+    forest.fragments[static_cast<std::size_t>(firstRoot)] = merged;
 }
 
 /** @brief Compare route count against the target vehicle count. */
@@ -254,17 +343,17 @@ constexpr int kMaxArbitraryExchangeGroup = 3;
 
 // Boundary and pair-split candidate limits. These moves repair route membership,
 // but exact pair split is exponential in combined customer count, so it needs a
-// strict generic cap rather than an instance-specific one.
+// strict generic cap rather than an instance-specific one: the Held-Karp limit.
 constexpr int kMinBoundaryPool = 5;
 constexpr int kMaxBoundaryPool = 8;
 constexpr int kMinBoundaryPairs = 6;
 constexpr int kMaxBoundaryPairs = 18;
 constexpr int kMinPairSplit = 14;
-constexpr int kMaxPairSplit = 18;
+constexpr int kMaxPairSplit = static_cast<int>(HeldKarp::MaxCustomers);
 
-// Beam width for related repair states; wider beams improve diversity but are
-// expensive because each state carries a full route set.
-constexpr int kRelatedBeamWidth = 4;
+// Beam width for related repair states. States share unchanged routes with
+// their parents, so each surviving state costs one route copy.
+constexpr int kRelatedBeamWidth = 32;
 
 /** @brief Return how many customers a route serves, excluding depot endpoints. */
 std::size_t RouteCustomerCount(const Route& route) {
@@ -353,14 +442,11 @@ void MaskAdd(std::vector<std::uint64_t>& covered, const std::vector<std::uint64_
     }
 }
 
-/** @brief Return the first customer not covered by the current route-pool search mask. */
-int FirstUncoveredCustomer(const std::vector<std::uint64_t>& covered, int customerCount) {
-    for (int customer = 0; customer < customerCount; ++customer) {
-        if (!MaskContains(covered, customer)) {
-            return customer;
-        }
+/** @brief Remove all bits of a candidate route mask from the covered mask. */
+void MaskRemove(std::vector<std::uint64_t>& covered, const std::vector<std::uint64_t>& candidate) {
+    for (std::size_t word = 0; word < covered.size(); ++word) {
+        covered[word] &= ~candidate[word];
     }
-    return -1;
 }
 
 /** @brief Extract non-depot customers from a route as an indexable vector. */
@@ -375,20 +461,26 @@ std::vector<Customer> RouteCustomers(const Route& route) {
     return customers;
 }
 
-/** @brief Return a route identity independent of customer visit order. */
-std::vector<std::string> RouteSignature(const Route& route) {
-    std::vector<std::string> names;
-    for (const Customer& customer : RouteCustomers(route)) {
-        names.push_back(customer.name);
+/** @brief Return the route in its cached exact order when that order is cheaper.
+ *
+ * The archive shares the graph-wide exact-route cache with the local-search
+ * kernels, so a membership already solved elsewhere enters the recombination
+ * pool at its optimal cost without another dynamic program.
+ */
+Route WithCachedExactOrder(const Route& route) {
+    const auto cached = route.GetGraph().FindExactRoute(RouteCustomers(route));
+    if (!cached.has_value() || cached->first >= route.GetTotalCost()) {
+        return route;
     }
-    std::ranges::sort(names);
-    return names;
-}
-
-/** @brief Return a normalized archive priority; lower values are kept first. */
-double RouteArchiveScore(const Route& route) {
-    const int customerCount = std::max(1, route.size() - 2);
-    return static_cast<double>(route.GetTotalCost()) / static_cast<double>(customerCount);
+    const Customer depot = route.GetRoute()->front().first;
+    std::list<Customer> ordered(cached->second.cbegin(), cached->second.cend());
+    ordered.push_front(depot);
+    ordered.push_back(depot);
+    Route exact = route;
+    if (!exact.RebuildRoute(ordered)) {
+        return route;
+    }
+    return exact;
 }
 
 /** @brief Return how many route fragments may be retained for recombination. */
@@ -463,32 +555,113 @@ Routes BuildRoutesFromPool(const std::vector<RoutePoolCandidate>& pool, const st
     return routes;
 }
 
-/** @brief Depth-first exact cover search over the collected route-pool candidates. */
+/** @brief Pack a cover route count and non-negative cost into one atomic word. */
+std::uint64_t PackCover(std::size_t routeCount, int cost) {
+    return (static_cast<std::uint64_t>(routeCount) << 32) | static_cast<std::uint32_t>(cost);
+}
+
+/** @brief Return the route count of a packed cover. */
+std::size_t PackedRouteCount(std::uint64_t packed) { return static_cast<std::size_t>(packed >> 32); }
+
+/** @brief Return the cost of a packed cover. */
+int PackedCost(std::uint64_t packed) { return static_cast<int>(packed & 0xFFFFFFFFU); }
+
+/** @brief Compare a route count and cost with a packed cover, like IsBetterSolution. */
+bool IsBetterCover(const RoutePoolSearch& search, std::size_t routeCount, int cost, std::uint64_t best) {
+    const auto excess = [&search](std::size_t count) -> std::size_t {
+        const std::size_t target = static_cast<std::size_t>(std::max(0, search.minimumRoutes));
+        return search.minimumRoutes > 0 && count > target ? count - target : 0;
+    };
+    const std::size_t bestRouteCount = PackedRouteCount(best);
+    if (excess(routeCount) != excess(bestRouteCount)) {
+        return excess(routeCount) < excess(bestRouteCount);
+    }
+    return cost < PackedCost(best);
+}
+
+/** @brief Record a complete cover when it still beats the best one found by any worker. */
+void PublishCover(RoutePoolSearch& search, const std::vector<std::size_t>& selected, int cost) {
+    std::scoped_lock lock(search.bestMutex);
+    if (!IsBetterCover(search, selected.size(), cost, search.best.load())) {
+        return;
+    }
+    search.bestSelected = selected;
+    search.best.store(PackCover(selected.size(), cost));
+}
+
+/** @brief Pick the uncovered customer with the fewest compatible pool routes.
+ *
+ * The same scan computes two bounds on every completion and keeps the larger.
+ * The first sums, over uncovered customers, the cheapest per-customer cost
+ * share of their compatible routes; every cover pays exactly these shares.
+ * The second is the Lagrangian bound of the remaining subproblem under the
+ * root duals: the uncovered customer prices plus every negative reduced cost
+ * of a compatible route.
+ * @param[out] costBound Lower bound on the cost of any completion
+ * @return The branching customer, or -1 when some customer can no longer be covered
+ */
+int SelectRoutePoolBranch(const std::vector<RoutePoolCandidate>& pool,
+                          const std::vector<std::vector<std::size_t>>& byCustomer, const RoutePoolSearch& search,
+                          const std::vector<std::uint64_t>& covered, int currentCost, double& costBound) {
+    int branchCustomer = -1;
+    std::size_t fewestChoices = std::numeric_limits<std::size_t>::max();
+    double shareBound = currentCost;
+    double lagrangianBound = currentCost;
+    for (int customer = 0; customer < search.customerCount; ++customer) {
+        if (MaskContains(covered, customer)) {
+            continue;
+        }
+        std::size_t choices = 0;
+        double cheapestShare = std::numeric_limits<double>::infinity();
+        lagrangianBound += search.customerDual[static_cast<std::size_t>(customer)];
+        for (const std::size_t candidateIndex : byCustomer[static_cast<std::size_t>(customer)]) {
+            if (MasksOverlap(covered, pool[candidateIndex].mask)) {
+                continue;
+            }
+            ++choices;
+            cheapestShare = std::min(cheapestShare, search.costShare[candidateIndex]);
+            // A compatible route is counted once, at its lowest customer.
+            if (pool[candidateIndex].customers.front() == customer) {
+                lagrangianBound += std::min(0.0, search.reducedCost[candidateIndex]);
+            }
+        }
+        if (choices == 0) {
+            return -1;
+        }
+        shareBound += cheapestShare;
+        if (choices < fewestChoices) {
+            fewestChoices = choices;
+            branchCustomer = customer;
+        }
+    }
+    costBound = std::max(shareBound, lagrangianBound);
+    return branchCustomer;
+}
+
+/** @brief Depth-first exact cover search over the collected route-pool candidates.
+ *
+ * Each node branches on the uncovered customer with the fewest routes still
+ * compatible with the partial cover, so dead ends are detected before any
+ * route is chosen and forced choices are taken first. The covered mask is
+ * updated in place: selected routes are disjoint, so a branch is undone by
+ * removing its bits again.
+ */
 void SearchRoutePool(const std::vector<RoutePoolCandidate>& pool,
                      const std::vector<std::vector<std::size_t>>& byCustomer, RoutePoolSearch& search,
                      std::vector<std::uint64_t>& covered, int coveredCount, int coveredDemand, int currentCost,
                      std::vector<std::size_t>& selected) {
-    if (search.nodeLimit > 0 && search.nodesVisited++ >= search.nodeLimit) {
+    if (search.nodeLimit > 0 && search.nodesVisited.fetch_add(1, std::memory_order_relaxed) >= search.nodeLimit) {
         search.nodeLimitReached = true;
         return;
     }
+    const std::uint64_t best = search.best.load(std::memory_order_relaxed);
     if (coveredCount == search.customerCount) {
-        Routes candidate = BuildRoutesFromPool(pool, selected);
-        if (IsBetterSolution(candidate, search.bestRoutes, search.minimumRoutes)) {
-            search.bestRoutes = std::move(candidate);
+        if (IsBetterCover(search, selected.size(), currentCost, best)) {
+            PublishCover(search, selected, currentCost);
         }
         return;
     }
-    const std::size_t incumbentRouteCount = ActiveRouteCount(search.bestRoutes);
-    const int incumbentCost = RoutesCost(search.bestRoutes);
-    if (std::cmp_less_equal(incumbentRouteCount, search.minimumRoutes) && currentCost >= incumbentCost) {
-        return;
-    }
-
-    const int firstUncovered = FirstUncoveredCustomer(covered, search.customerCount);
-    if (firstUncovered < 0) {
-        return;
-    }
+    const std::size_t incumbentRouteCount = PackedRouteCount(best);
     const int remainingDemand = search.totalDemand - coveredDemand;
     const int remainingRouteLowerBound = (remainingDemand + search.capacity - 1) / search.capacity;
     if (selected.size() >= incumbentRouteCount) {
@@ -497,12 +670,21 @@ void SearchRoutePool(const std::vector<RoutePoolCandidate>& pool,
     if (selected.size() + static_cast<std::size_t>(remainingRouteLowerBound) > incumbentRouteCount) {
         return;
     }
-    if (selected.size() + static_cast<std::size_t>(remainingRouteLowerBound) == incumbentRouteCount &&
-        currentCost >= incumbentCost) {
+
+    double costBound = 0.0;
+    const int branchCustomer = SelectRoutePoolBranch(pool, byCustomer, search, covered, currentCost, costBound);
+    if (branchCustomer < 0) {
+        return;
+    }
+    // Cost can only decide against the best cover when no completion can use fewer excess routes.
+    const bool costDecides =
+        std::cmp_less_equal(incumbentRouteCount, search.minimumRoutes) ||
+        selected.size() + static_cast<std::size_t>(remainingRouteLowerBound) == incumbentRouteCount;
+    if (costDecides && costBound > PackedCost(best) - 1 + kRoutePoolBoundTolerance) {
         return;
     }
 
-    for (const std::size_t candidateIndex : byCustomer[static_cast<std::size_t>(firstUncovered)]) {
+    for (const std::size_t candidateIndex : byCustomer[static_cast<std::size_t>(branchCustomer)]) {
         if (search.nodeLimitReached) {
             return;
         }
@@ -510,20 +692,121 @@ void SearchRoutePool(const std::vector<RoutePoolCandidate>& pool,
         if (MasksOverlap(covered, candidate.mask)) {
             continue;
         }
-        std::vector<std::uint64_t> nextCovered = covered;
-        MaskAdd(nextCovered, candidate.mask);
+        MaskAdd(covered, candidate.mask);
         selected.push_back(candidateIndex);
-        SearchRoutePool(pool, byCustomer, search, nextCovered,
+        SearchRoutePool(pool, byCustomer, search, covered,
                         coveredCount + static_cast<int>(candidate.customers.size()), coveredDemand + candidate.demand,
                         currentCost + candidate.cost, selected);
         selected.pop_back();
+        MaskRemove(covered, candidate.mask);
+    }
+}
+
+/** @brief Run the exact cover search with one subtree per route covering the root branching customer.
+ *
+ * Subtrees share the node budget and the packed incumbent, so a cover found
+ * in one subtree immediately tightens pruning in all others. Which of several
+ * equally good covers is kept, and where a binding node budget cuts the
+ * search, can depend on thread timing; one worker reproduces the serial order.
+ */
+void SearchRoutePoolParallel(const std::vector<RoutePoolCandidate>& pool,
+                             const std::vector<std::vector<std::size_t>>& byCustomer, RoutePoolSearch& search,
+                             std::size_t maskWords, unsigned workers) {
+    const std::vector<std::uint64_t> empty(maskWords, 0);
+    double costBound = 0.0;
+    const int rootCustomer = SelectRoutePoolBranch(pool, byCustomer, search, empty, 0, costBound);
+    if (rootCustomer < 0 || workers <= 1) {
+        std::vector<std::uint64_t> covered = empty;
+        std::vector<std::size_t> selected;
+        SearchRoutePool(pool, byCustomer, search, covered, 0, 0, 0, selected);
+        return;
+    }
+    ThreadPool threads(workers);
+    for (const std::size_t rootIndex : byCustomer[static_cast<std::size_t>(rootCustomer)]) {
+        threads.AddTask([&pool, &byCustomer, &search, &empty, rootIndex]() {
+            const RoutePoolCandidate& root = pool[rootIndex];
+            std::vector<std::uint64_t> covered = empty;
+            MaskAdd(covered, root.mask);
+            std::vector<std::size_t> selected = {rootIndex};
+            SearchRoutePool(pool, byCustomer, search, covered, static_cast<int>(root.customers.size()), root.demand,
+                            root.cost, selected);
+        });
+    }
+    threads.JoinAll();
+}
+
+/** @brief Compute Lagrangian duals of the set-partitioning model by subgradient ascent.
+ *
+ * Relaxing the cover-once constraints with one price per customer gives the
+ * bound sum(prices) + sum(min(0, reduced cost)) for any prices. The ascent
+ * starts from the cheapest cost share of every customer, a dual-feasible
+ * point, and moves prices along the coverage violation of the relaxed
+ * solution with a Polyak step towards the incumbent cost, halving the step
+ * scale when the bound stalls. The best prices seen are returned.
+ * @param[in] pool Route pool; every customer is covered by some route
+ * @param[in] customerCount Number of customers
+ * @param[in] upperBound Cost of the incumbent cover
+ * @return Best prices, their reduced costs, and their bound
+ */
+RoutePoolDuals ComputeRoutePoolDuals(const std::vector<RoutePoolCandidate>& pool, std::size_t customerCount,
+                                     int upperBound) {
+    std::vector<double> prices(customerCount, std::numeric_limits<double>::infinity());
+    for (const RoutePoolCandidate& route : pool) {
+        const double share = static_cast<double>(route.cost) / static_cast<double>(route.customers.size());
+        for (const int customer : route.customers) {
+            prices[static_cast<std::size_t>(customer)] = std::min(prices[static_cast<std::size_t>(customer)], share);
+        }
+    }
+    RoutePoolDuals best{.customerDual = prices, .reducedCost = {}, .bound = -std::numeric_limits<double>::infinity()};
+    std::vector<double> reducedCost(pool.size());
+    std::vector<int> coverage(customerCount);
+    double stepScale = kRoutePoolDualInitialStep;
+    int stalled = 0;
+    for (int iteration = 0; iteration < kRoutePoolDualIterations; ++iteration) {
+        double bound = std::accumulate(prices.cbegin(), prices.cend(), 0.0);
+        std::ranges::fill(coverage, 0);
+        for (std::size_t routeIndex = 0; routeIndex < pool.size(); ++routeIndex) {
+            double reduced = pool[routeIndex].cost;
+            for (const int customer : pool[routeIndex].customers) {
+                reduced -= prices[static_cast<std::size_t>(customer)];
+            }
+            reducedCost[routeIndex] = reduced;
+            if (reduced < 0.0) {
+                bound += reduced;
+                for (const int customer : pool[routeIndex].customers) {
+                    ++coverage[static_cast<std::size_t>(customer)];
+                }
+            }
+        }
+        if (bound > best.bound + kRoutePoolBoundTolerance) {
+            best.customerDual = prices;
+            best.reducedCost = reducedCost;
+            best.bound = bound;
+            stalled = 0;
+        } else if (++stalled >= kRoutePoolDualStallIterations) {
+            stepScale /= 2.0;
+            stalled = 0;
+        }
+        double violation = 0.0;
+        for (const int covered : coverage) {
+            violation += static_cast<double>((1 - covered) * (1 - covered));
+        }
+        // Zero violation means the relaxed solution is itself an exact cover.
+        if (violation == 0.0 || best.bound > upperBound - 1 + kRoutePoolBoundTolerance) {
+            break;
+        }
+        const double step = stepScale * (upperBound - bound) / violation;
+        for (std::size_t customer = 0; customer < customerCount; ++customer) {
+            prices[customer] += step * static_cast<double>(1 - coverage[customer]);
+        }
     }
+    return best;
 }
 
 /** @brief Recombine routes from multiple initial solutions with exact set partitioning over the route pool. */
 std::optional<Routes> RecombineRoutePool(const std::vector<RoutePoolCandidate>& pool,
                                          const std::vector<Customer>& customers, int capacity, int minimumRoutes,
-                                         const Routes& incumbent) {
+                                         const Routes& incumbent, unsigned workers) {
     if (pool.empty() || incumbent.empty()) {
         return std::nullopt;
     }
@@ -533,7 +816,37 @@ std::optional<Routes> RecombineRoutePool(const std::vector<RoutePoolCandidate>&
             candidateIndexesByCustomer[static_cast<std::size_t>(customerIndex)].push_back(routeIndex);
         }
     }
+    for (const std::vector<std::size_t>& routeIndexes : candidateIndexesByCustomer) {
+        if (routeIndexes.empty()) {
+            return std::nullopt;
+        }
+    }
     const std::size_t incumbentRouteCount = ActiveRouteCount(incumbent);
+    const int incumbentCost = RoutesCost(incumbent);
+    RoutePoolDuals duals = ComputeRoutePoolDuals(pool, customers.size(), incumbentCost);
+    // With no excess routes in the incumbent only a cheaper cover can win, so a
+    // route whose reduced cost lifts the bound past that can be dropped.
+    if (minimumRoutes <= 0 || std::cmp_less_equal(incumbentRouteCount, minimumRoutes)) {
+        const double costLimit = incumbentCost - 1 + kRoutePoolBoundTolerance;
+        if (duals.bound > costLimit) {
+            return std::nullopt;
+        }
+        for (std::vector<std::size_t>& routeIndexes : candidateIndexesByCustomer) {
+            std::erase_if(routeIndexes, [&duals, costLimit](std::size_t routeIndex) {
+                return duals.bound + std::max(0.0, duals.reducedCost[routeIndex]) > costLimit;
+            });
+        }
+    }
+    // Routes are tried by increasing reduced cost, the LP's estimate of their usefulness.
+    const auto byReducedCost = [&pool, &duals](std::size_t left, std::size_t right) {
+        if (duals.reducedCost[left] != duals.reducedCost[right]) {
+            return duals.reducedCost[left] < duals.reducedCost[right];
+        }
+        if (pool[left].cost != pool[right].cost) {
+            return pool[left].cost < pool[right].cost;
+        }
+        return left < right;
+    };
     const std::size_t perCustomerChoiceLimit =
         std::max(kMinRoutePoolCustomerChoices, incumbentRouteCount + kRoutePoolChoiceSlack);
     std::vector<bool> allowedRoute(pool.size(), false);
@@ -541,12 +854,7 @@ std::optional<Routes> RecombineRoutePool(const std::vector<RoutePoolCandidate>&
         if (routeIndexes.empty()) {
             return std::nullopt;
         }
-        std::ranges::sort(routeIndexes, [&pool](std::size_t left, std::size_t right) {
-            if (pool[left].cost != pool[right].cost) {
-                return pool[left].cost < pool[right].cost;
-            }
-            return left < right;
-        });
+        std::ranges::sort(routeIndexes, byReducedCost);
         if (routeIndexes.size() > perCustomerChoiceLimit) {
             routeIndexes.resize(perCustomerChoiceLimit);
         }
@@ -567,30 +875,39 @@ std::optional<Routes> RecombineRoutePool(const std::vector<RoutePoolCandidate>&
         if (routeIndexes.empty()) {
             return std::nullopt;
         }
-        std::ranges::sort(routeIndexes, [&pool](std::size_t left, std::size_t right) {
-            if (pool[left].cost != pool[right].cost) {
-                return pool[left].cost < pool[right].cost;
-            }
-            return left < right;
-        });
+        std::ranges::sort(routeIndexes, byReducedCost);
     }
     int totalDemand = 0;
     for (const Customer& customer : customers) {
         totalDemand += customer.request;
     }
+    std::vector<double> costShare(pool.size());
+    for (std::size_t routeIndex = 0; routeIndex < pool.size(); ++routeIndex) {
+        costShare[routeIndex] =
+            static_cast<double>(pool[routeIndex].cost) / static_cast<double>(pool[routeIndex].customers.size());
+    }
     RoutePoolSearch search{
-        .bestRoutes = incumbent,
+        .bestMutex = {},
+        .bestSelected = {},
+        .best = PackCover(incumbentRouteCount, incumbentCost),
+        .costShare = std::move(costShare),
+        .customerDual = std::move(duals.customerDual),
+        .reducedCost = std::move(duals.reducedCost),
         .minimumRoutes = minimumRoutes,
         .capacity = capacity,
         .customerCount = static_cast<int>(customers.size()),
         .totalDemand = totalDemand,
+        .nodesVisited = 0,
         .nodeLimit = customers.size() * perCustomerChoiceLimit * incumbentRouteCount * kRoutePoolNodeBudgetMultiplier,
+        .nodeLimitReached = false,
     };
-    std::vector<std::uint64_t> covered((customers.size() + 63) / 64, 0);
-    std::vector<std::size_t> selected;
-    SearchRoutePool(pool, byCustomer, search, covered, 0, 0, 0, selected);
-    if (IsBetterSolution(search.bestRoutes, incumbent, minimumRoutes)) {
-        return search.bestRoutes;
+    SearchRoutePoolParallel(pool, byCustomer, search, (customers.size() + 63) / 64, workers);
+    if (search.bestSelected.empty()) {
+        return std::nullopt;
+    }
+    Routes recombined = BuildRoutesFromPool(pool, search.bestSelected);
+    if (IsBetterSolution(recombined, incumbent, minimumRoutes)) {
+        return recombined;
     }
     return std::nullopt;
 }
@@ -620,86 +937,252 @@ std::map<std::string, int> BuildCustomerIndexByName(const std::vector<Customer>&
     return customerIndexByName;
 }
 
+/** @brief Build the routes serving a customer order, splitting it only where the exact check fails.
+ *
+ * The aggregated merge test is exact for metric costs. Rounding or a
+ * triangle-inequality violation can still make the whole order infeasible
+ * for Route; the order is then cut greedily into the longest feasible runs.
+ * @param[in,out] routes Routes to append to
+ * @param[in] order Customer order without depot
+ * @throws std::runtime_error when a single customer cannot be served
+ */
+void AppendFeasibleRoutes(Routes& routes, const std::vector<Customer>& order, const Customer& depot,
+                          const Graph& graph, int capacity, float workTime, float costTravel, float alphaParam) {
+    Route route(capacity, workTime, graph, costTravel, alphaParam);
+    if (route.RebuildRoute(BuildRouteCustomers(depot, order))) {
+        routes.push_back(std::move(route));
+        return;
+    }
+    std::vector<Customer> run;
+    for (const Customer& customer : order) {
+        run.push_back(customer);
+        if (route.RebuildRoute(BuildRouteCustomers(depot, run))) {
+            continue;
+        }
+        run.pop_back();
+        if (run.empty() || !route.RebuildRoute(BuildRouteCustomers(depot, run))) {
+            throw std::runtime_error("Savings route is infeasible");
+        }
+        routes.push_back(route);
+        run = {customer};
+    }
+    if (!route.RebuildRoute(BuildRouteCustomers(depot, run))) {
+        throw std::runtime_error("Savings route is infeasible");
+    }
+    routes.push_back(std::move(route));
+}
+
 /** @brief Build one Clarke-Wright savings candidate for a savings weight.
  *
  * The classic savings score is c(depot,i) + c(depot,j) - lambda*c(i,j).
  * Trying several lambda values gives a cheap deterministic multi-start
  * initializer: low values favor radial merges, high values favor compact
- * customer-to-customer links.
+ * customer-to-customer links. Fragments live in a union-find forest with
+ * their demand, service time and travel cost, so each saving is tested and
+ * applied in near-constant time and Route objects are built once at the end.
  */
-Routes BuildSavingsRoutes(Graph& graph, const std::vector<Customer>& customers, const Customer& depot, int capacity,
-                          float workTime, float costTravel, float alphaParam, double lambda) {
-    std::vector<SavingsRoute> savingsRoutes;
-    savingsRoutes.reserve(customers.size());
-    for (const Customer& customer : customers) {
-        savingsRoutes.push_back(SavingsRoute{
-            .customers = {customer},
-            .active = true,
-        });
+Routes BuildSavingsRoutes(const Graph& graph, const std::vector<Customer>& customers, const Customer& depot,
+                          int capacity, float workTime, float costTravel, float alphaParam, double lambda) {
+    const std::size_t customerCount = customers.size();
+    std::vector<int> depotCost(customerCount);
+    std::vector<int> nameRank(customerCount);
+    for (std::size_t i = 0; i < customerCount; ++i) {
+        depotCost[i] = graph.GetCost(depot, customers[i]);
+    }
+    // Equal savings are broken by customer name, as before compaction, so the
+    // merge order does not depend on the depot-distance order of the list.
+    std::vector<int> byName(customerCount);
+    std::iota(byName.begin(), byName.end(), 0);
+    std::ranges::sort(byName, [&customers](int left, int right) {
+        return customers[static_cast<std::size_t>(left)].name < customers[static_cast<std::size_t>(right)].name;
+    });
+    for (std::size_t rank = 0; rank < customerCount; ++rank) {
+        nameRank[static_cast<std::size_t>(byName[rank])] = static_cast<int>(rank);
     }
-
     std::vector<Saving> savings;
-    savings.reserve(customers.size() * customers.size());
-    for (std::size_t i = 0; i < customers.size(); ++i) {
-        for (std::size_t j = i + 1; j < customers.size(); ++j) {
+    savings.reserve(customerCount * (customerCount - 1) / 2);
+    for (std::size_t i = 0; i < customerCount; ++i) {
+        for (std::size_t j = i + 1; j < customerCount; ++j) {
+            const double value = static_cast<double>(depotCost[i] + depotCost[j]) -
+                                 (lambda * static_cast<double>(graph.GetCost(customers[i], customers[j])));
             savings.push_back(Saving{
-                .first = customers[i],
-                .second = customers[j],
-                .value = static_cast<double>(graph.GetCost(depot, customers[i]) + graph.GetCost(depot, customers[j])) -
-                         (lambda * static_cast<double>(graph.GetCost(customers[i], customers[j]))),
+                .first = static_cast<int>(i),
+                .second = static_cast<int>(j),
+                .value = static_cast<float>(value),
             });
         }
     }
-    std::ranges::sort(savings, [](const Saving& lhs, const Saving& rhs) {
+    std::ranges::sort(savings, [&nameRank](const Saving& lhs, const Saving& rhs) {
         if (lhs.value != rhs.value) {
             return lhs.value > rhs.value;
         }
-        if (lhs.first.name != rhs.first.name) {
-            return lhs.first.name < rhs.first.name;
+        const int lhsFirst = nameRank[static_cast<std::size_t>(lhs.first)];
+        const int rhsFirst = nameRank[static_cast<std::size_t>(rhs.first)];
+        if (lhsFirst != rhsFirst) {
+            return lhsFirst < rhsFirst;
         }
-        return lhs.second.name < rhs.second.name;
+        return nameRank[static_cast<std::size_t>(lhs.second)] < nameRank[static_cast<std::size_t>(rhs.second)];
     });
+    SavingsForest forest{
+        .parent = std::vector<int>(customerCount),
+        .links = std::vector<std::array<int, 2>>(customerCount, {-1, -1}),
+        .fragments = std::vector<SavingsFragment>(customerCount),
+    };
+    std::iota(forest.parent.begin(), forest.parent.end(), 0);
+    for (std::size_t i = 0; i < customerCount; ++i) {
+        const int customer = static_cast<int>(i);
+        forest.fragments[i] = SavingsFragment{
+            .head = customer,
+            .tail = customer,
+            .demand = customers[i].request,
+            .service = customers[i].serviceTime,
+            .travel = 2 * depotCost[i],
+            .slot = customer,
+        };
+    }
     for (const Saving& saving : savings) {
-        const int firstIndex = FindSavingsRouteIndex(savingsRoutes, saving.first);
-        const int secondIndex = FindSavingsRouteIndex(savingsRoutes, saving.second);
-        if (firstIndex < 0 || secondIndex < 0 || firstIndex == secondIndex) {
+        if (!IsFragmentEnd(forest, saving.first) || !IsFragmentEnd(forest, saving.second)) {
             continue;
         }
-        SavingsRoute& firstRoute = savingsRoutes[static_cast<std::size_t>(firstIndex)];
-        SavingsRoute& secondRoute = savingsRoutes[static_cast<std::size_t>(secondIndex)];
-        if (!IsRouteEnd(firstRoute, saving.first) || !IsRouteEnd(secondRoute, saving.second)) {
+        const int firstRoot = FindSavingsFragment(forest, saving.first);
+        const int secondRoot = FindSavingsFragment(forest, saving.second);
+        if (firstRoot == secondRoot) {
             continue;
         }
-        std::vector<Customer> mergedCustomers =
-            MergeSavingsRoutes(firstRoute, saving.first, secondRoute, saving.second);
-        Route candidate(capacity, workTime, graph, costTravel, alphaParam);
-        if (candidate.RebuildRoute(BuildRouteCustomers(depot, mergedCustomers))) {
-            firstRoute.customers = mergedCustomers;
-            secondRoute.active = false;
+        const SavingsFragment& firstFragment = forest.fragments[static_cast<std::size_t>(firstRoot)];
+        const SavingsFragment& secondFragment = forest.fragments[static_cast<std::size_t>(secondRoot)];
+        const std::size_t first = static_cast<std::size_t>(saving.first);
+        const std::size_t second = static_cast<std::size_t>(saving.second);
+        // Costs are symmetric, so the merged tour drops the two depot arcs at
+        // the joined ends whatever the orientation of either fragment.
+        const SavingsFragment merged{
+            .head = firstFragment.head == saving.first ? firstFragment.tail : firstFragment.head,
+            .tail = secondFragment.tail == saving.second ? secondFragment.head : secondFragment.tail,
+            .demand = firstFragment.demand + secondFragment.demand,
+            .service = firstFragment.service + secondFragment.service,
+            .travel = firstFragment.travel + secondFragment.travel - depotCost[first] - depotCost[second] +
+                      graph.GetCost(customers[first], customers[second]),
+            .slot = firstFragment.slot,
+        };
+        const double routeTime =
+            static_cast<double>(merged.service) + (static_cast<double>(costTravel) * merged.travel);
+        if (merged.demand <= capacity && routeTime <= static_cast<double>(workTime)) {
+            MergeSavingsFragments(forest, saving.first, saving.second, merged);
         }
     }
 
+    std::vector<const SavingsFragment*> finalFragments;
+    for (std::size_t i = 0; i < customerCount; ++i) {
+        if (forest.parent[i] == static_cast<int>(i)) {
+            finalFragments.push_back(&forest.fragments[i]);
+        }
+    }
+    std::ranges::sort(finalFragments, {}, &SavingsFragment::slot);
     Routes routes;
-    for (const SavingsRoute& route : savingsRoutes) {
-        if (route.active) {
-            Route candidate(capacity, workTime, graph, costTravel, alphaParam);
-            if (!candidate.RebuildRoute(BuildRouteCustomers(depot, route.customers))) {
-                throw std::runtime_error("Savings route is infeasible");
+    for (const SavingsFragment* fragment : finalFragments) {
+        AppendFeasibleRoutes(routes, FragmentCustomers(forest, *fragment, customers), depot, graph, capacity,
+                             workTime, costTravel, alphaParam);
+    }
+    return routes;
+}
+
+/** @brief Return the demand of the doubled-order positions [begin, end). */
+int SweepArcDemand(const SweepOrder& order, std::size_t begin, std::size_t end) {
+    return order.demandPrefix[end] - order.demandPrefix[begin];
+}
+
+/** @brief Approximate the route cost of the doubled-order positions [begin, end).
+ *
+ * The route visits the arc in sweep order, so its cost is the two depot legs
+ * plus the sweep path between them; 2-opt only improves on it later.
+ */
+int SweepArcCost(const SweepOrder& order, std::size_t begin, std::size_t end) {
+    const std::size_t count = order.customers.size();
+    return order.depotCost[begin % count] + (order.pathPrefix[end - 1] - order.pathPrefix[begin]) +
+           order.depotCost[(end - 1) % count];
+}
+
+/** @brief Partition one sweep rotation into the target route count.
+ *
+ * Dynamic programming over the arc cost approximation picks the contiguous
+ * partition; only its routes are then improved with 2-opt and costed
+ * exactly. Feasible route starts for each end form a sliding capacity
+ * window, so the table costs O(routes * customers * window).
+ * @param[in] start First position of the rotation in the doubled order
+ * @param[in,out] dp Reusable table buffer of the calling worker
+ * @param[in,out] previous Reusable split-point buffer of the calling worker
+ * @return The improved plan, or nothing when no partition fits
+ */
+std::optional<SweepPlan> SolveSweepRotation(const Graph& graph, const SweepOrder& order, const Customer& depot,
+                                            std::size_t start, int capacity, int targetRouteCount,
+                                            std::vector<int>& dp, std::vector<int>& previous) {
+    constexpr int infinity = std::numeric_limits<int>::max() / 4;
+    const std::size_t customerCount = order.customers.size();
+    const std::size_t width = customerCount + 1;
+    const std::size_t routeCount = static_cast<std::size_t>(targetRouteCount);
+    dp.assign((routeCount + 1) * width, infinity);
+    previous.assign((routeCount + 1) * width, -1);
+    // dp[r * width + end] is the cheapest way to cover positions [0, end) of the rotation with r routes.
+    dp[0] = 0;
+    for (std::size_t routes = 1; routes <= routeCount; ++routes) {
+        std::size_t lowest = 0;
+        for (std::size_t end = 1; end <= customerCount; ++end) {
+            while (lowest < end && SweepArcDemand(order, start + lowest, start + end) > capacity) {
+                ++lowest;
+            }
+            for (std::size_t begin = lowest; begin < end; ++begin) {
+                const int before = dp[((routes - 1) * width) + begin];
+                if (before == infinity) {
+                    continue;
+                }
+                const int candidateCost = before + SweepArcCost(order, start + begin, start + end);
+                if (candidateCost < dp[(routes * width) + end]) {
+                    dp[(routes * width) + end] = candidateCost;
+                    // Store the split point so the route partition can be reconstructed later.
+                    previous[(routes * width) + end] = static_cast<int>(begin);
+                }
             }
-            routes.push_back(candidate);
         }
     }
-    return routes;
+    if (dp[(routeCount * width) + customerCount] == infinity) {
+        return std::nullopt;
+    }
+    SweepPlan plan;
+    std::size_t end = customerCount;
+    // Follow split points backwards from the full rotation to recover each chosen arc.
+    for (std::size_t routes = routeCount; routes >= 1; --routes) {
+        const int begin = previous[(routes * width) + end];
+        if (begin < 0) {
+            return std::nullopt;
+        }
+        std::vector<Customer> route;
+        route.reserve(end - static_cast<std::size_t>(begin) + 2);
+        route.push_back(depot);
+        for (std::size_t position = static_cast<std::size_t>(begin); position < end; ++position) {
+            route.push_back(order.customers[(start + position) % customerCount]);
+        }
+        route.push_back(depot);
+        route = ImproveRouteOrder2Opt(graph, std::move(route));
+        plan.cost += RouteOrderCost(graph, route);
+        plan.routes.push_back(std::move(route));
+        end = static_cast<std::size_t>(begin);
+    }
+    // Reconstruction walks backwards, so restore the original sweep order.
+    std::ranges::reverse(plan.routes);
+    return plan;
 }
 
 /** @brief Build a sweep-partition initial solution.
  *
- * Customers are sorted by polar angle around the depot. For every rotation and
- * direction, dynamic programming chooses a contiguous partition into the
- * minimum capacity-feasible route count. The selected route set is then
- * internally improved with 2-opt before competing with the current best plan.
+ * Customers are sorted by polar angle around the depot. For every rotation,
+ * dynamic programming chooses a contiguous partition into the minimum
+ * capacity-feasible route count; its routes are improved with 2-opt before
+ * competing with the current best plan. Rotations are independent and split
+ * into one contiguous chunk per worker; the cheapest plan wins, ties going to
+ * the earliest rotation, so the result does not depend on the worker count.
  */
-std::optional<Routes> BuildSweepRoutes(Graph& graph, int capacity, float workTime, float costTravel, float alphaParam) {
+std::optional<Routes> BuildSweepRoutes(Graph& graph, int capacity, float workTime, float costTravel, float alphaParam,
+                                       unsigned workers) {
     if (capacity <= 0) {
         return std::nullopt;
     }
@@ -731,101 +1214,59 @@ std::optional<Routes> BuildSweepRoutes(Graph& graph, int capacity, float workTim
         }
         return left.customer.name < right.customer.name;
     });
-    std::optional<SweepPlan> bestPlan;
     const std::size_t customerCount = customers.size();
-    // Try every circular sweep start in both directions; the first customer in
-    // an angular ordering can materially change the partition.
-    for (const int direction : {1, -1}) {
-        for (std::size_t start = 0; start < customerCount; ++start) {
-            std::vector<Customer> ordered;
-            ordered.reserve(customerCount);
-            for (std::size_t offset = 0; offset < customerCount; ++offset) {
-                // Walk the circular order without physically rotating the vector.
-                const std::size_t index =
-                    direction > 0 ? (start + offset) % customerCount : (start + customerCount - offset) % customerCount;
-                ordered.push_back(customers[index].customer);
-            }
-            std::vector<int> demandPrefix(customerCount + 1, 0);
-            for (std::size_t i = 0; i < customerCount; ++i) {
-                demandPrefix[i + 1] = demandPrefix[i] + ordered[i].request;
-            }
-            std::vector<std::vector<SweepSegment>> segments(customerCount,
-                                                            std::vector<SweepSegment>(customerCount + 1));
-            // segments[i][j] is the direct route serving ordered[i, j).
-            for (std::size_t i = 0; i < customerCount; ++i) {
-                for (std::size_t j = i + 1; j <= customerCount; ++j) {
-                    if (demandPrefix[j] - demandPrefix[i] > capacity) {
-                        break;
-                    }
-                    std::vector<Customer> route;
-                    route.reserve(j - i + 2);
-                    route.push_back(depot);
-                    route.insert(route.end(), ordered.cbegin() + static_cast<std::ptrdiff_t>(i),
-                                 ordered.cbegin() + static_cast<std::ptrdiff_t>(j));
-                    route.push_back(depot);
-                    route = ImproveRouteOrder2Opt(graph, std::move(route));
-                    const int routeCost = RouteOrderCost(graph, route);
-                    segments[i][j] = SweepSegment{
-                        .route = std::move(route),
-                        .cost = routeCost,
-                        .feasible = true,
-                    };
-                }
-            }
-            constexpr int infinity = std::numeric_limits<int>::max() / 4;
-            std::vector<std::vector<int>> dp(static_cast<std::size_t>(targetRouteCount + 1),
-                                             std::vector<int>(customerCount + 1, infinity));
-            std::vector<std::vector<int>> previous(static_cast<std::size_t>(targetRouteCount + 1),
-                                                   std::vector<int>(customerCount + 1, -1));
-            // dp[r][end] is the cheapest way to cover ordered[0, end) with r routes.
-            dp[0][0] = 0;
-            for (int routeCount = 1; routeCount <= targetRouteCount; ++routeCount) {
-                for (std::size_t end = 1; end <= customerCount; ++end) {
-                    for (std::size_t begin = 0; begin < end; ++begin) {
-                        if (!segments[begin][end].feasible ||
-                            dp[static_cast<std::size_t>(routeCount - 1)][begin] == infinity) {
-                            continue;
-                        }
-                        const int candidateCost =
-                            dp[static_cast<std::size_t>(routeCount - 1)][begin] + segments[begin][end].cost;
-                        if (candidateCost < dp[static_cast<std::size_t>(routeCount)][end]) {
-                            dp[static_cast<std::size_t>(routeCount)][end] = candidateCost;
-                            // Store the split point so the route partition can be reconstructed later.
-                            previous[static_cast<std::size_t>(routeCount)][end] = static_cast<int>(begin);
-                        }
-                    }
-                }
-            }
-            const int planCost = dp[static_cast<std::size_t>(targetRouteCount)][customerCount];
-            if (planCost == infinity) {
-                continue;
-            }
-            SweepPlan plan;
-            std::size_t end = customerCount;
-            // Follow split points backwards from the full prefix to recover each chosen segment.
-            for (int routeCount = targetRouteCount; routeCount >= 1; --routeCount) {
-                const int begin = previous[static_cast<std::size_t>(routeCount)][end];
-                if (begin < 0) {
-                    plan.routes.clear();
-                    break;
-                }
-                plan.routes.push_back(segments[static_cast<std::size_t>(begin)][end].route);
-                end = static_cast<std::size_t>(begin);
-            }
-            if (std::cmp_equal(plan.routes.size(), targetRouteCount)) {
-                // Reconstruction walks backwards, so restore the original sweep order.
-                std::ranges::reverse(plan.routes);
-                int improvedCost = 0;
-                for (std::vector<Customer>& route : plan.routes) {
-                    route = ImproveRouteOrder2Opt(graph, std::move(route));
-                    improvedCost += RouteOrderCost(graph, route);
-                }
-                plan.cost = improvedCost;
-                if (!bestPlan.has_value() || plan.cost < bestPlan->cost) {
-                    bestPlan = std::move(plan);
-                }
+    SweepOrder order;
+    order.customers.reserve(customerCount);
+    for (const SweepCustomer& customer : customers) {
+        order.customers.push_back(customer.customer);
+        order.depotCost.push_back(graph.GetCost(depot, customer.customer));
+    }
+    order.demandPrefix.assign(2 * customerCount, 0);
+    order.pathPrefix.assign(2 * customerCount, 0);
+    for (std::size_t position = 1; position < 2 * customerCount; ++position) {
+        const Customer& from = order.customers[(position - 1) % customerCount];
+        order.demandPrefix[position] = order.demandPrefix[position - 1] + from.request;
+        order.pathPrefix[position] =
+            order.pathPrefix[position - 1] + graph.GetCost(from, order.customers[position % customerCount]);
+    }
+
+    // Try every circular sweep start; the first customer in an angular
+    // ordering can materially change the partition. Sweeping backwards
+    // enumerates the same circular arcs, so one direction covers them all.
+    const auto solveRotations = [&graph, &order, &depot, capacity, targetRouteCount](std::size_t first,
+                                                                                   std::size_t last) {
+        std::optional<SweepPlan> best;
+        std::vector<int> dp;
+        std::vector<int> previous;
+        for (std::size_t start = first; start < last; ++start) {
+            std::optional<SweepPlan> plan =
+                SolveSweepRotation(graph, order, depot, start, capacity, targetRouteCount, dp, previous);
+            if (plan.has_value() && (!best.has_value() || plan->cost < best->cost)) {
+                best = std::move(plan);
             }
         }
+        return best;
+    };
+    const std::size_t chunkCount = std::clamp<std::size_t>(workers, 1, customerCount);
+    const std::size_t chunkSize = (customerCount + chunkCount - 1) / chunkCount;
+    std::vector<std::optional<SweepPlan>> chunkPlans((customerCount + chunkSize - 1) / chunkSize);
+    if (chunkPlans.size() == 1) {
+        chunkPlans.front() = solveRotations(0, customerCount);
+    } else {
+        ThreadPool threads(static_cast<unsigned>(chunkCount));
+        for (std::size_t chunk = 0; chunk < chunkPlans.size(); ++chunk) {
+            threads.AddTask([&chunkPlans, &solveRotations, chunk, chunkSize, customerCount]() {
+                chunkPlans[chunk] =
+                    solveRotations(chunk * chunkSize, std::min(customerCount, (chunk + 1) * chunkSize));
+            });
+        }
+        threads.JoinAll();
+    }
+    std::optional<SweepPlan> bestPlan;
+    for (std::optional<SweepPlan>& plan : chunkPlans) {
+        if (plan.has_value() && (!bestPlan.has_value() || plan->cost < bestPlan->cost)) {
+            bestPlan = std::move(plan);
+        }
     }
     if (!bestPlan.has_value()) {
         return std::nullopt;
@@ -870,9 +1311,53 @@ VRP::VRP(Graph&& g, const int n, const int v, const int c, const int minRoutes,
     this->costTravel = costTravel;
     this->totalCost = 0;
     this->alphaParam = alphaParam;
-    this->tabuSearch.emplace(this->graph, this->numVertices);
+    this->workers = std::max(1U, std::thread::hardware_concurrency());
+    this->ResetTabuSearch();
 }
 
+/** @brief Limit the threads of this run.
+ *
+ * Every parallel step of the run, construction, exact recombination, VND
+ * neighborhoods and tabu search, sizes its pool from this budget, so runs
+ * sharing a machine do not oversubscribe it.
+ * @param[in] budget Maximum number of threads; zero is treated as one
+ */
+void VRP::SetWorkerBudget(unsigned budget) {
+    this->workers = std::max(1U, budget);
+    this->ResetTabuSearch();
+}
+
+/** @brief Replace deadlines and time limits by a budget of evaluated moves.
+ *
+ * Every limit that used to read the clock then counts work instead: tabu
+ * calls stop after a number of evaluated moves, VND weighs neighborhoods by
+ * attempts, and the run ends once the moves of all tabu calls reach the
+ * budget. Exact recombination runs on one thread, the only search whose
+ * result depended on thread timing. The trajectory is then the same on any
+ * machine and core count.
+ * @param[in] budget Evaluated tabu moves after which the run stops
+ */
+void VRP::SetWorkBudget(long long budget) {
+    this->workBudget = budget;
+    this->vndScheduler.SetDeterministic(true);
+    this->ResetTabuSearch();
+}
+
+/** @brief Return true when the run is bounded by work instead of wall time. */
+bool VRP::Deterministic() const { return this->workBudget.has_value(); }
+
+/** @brief Return the moves evaluated by tabu search so far. */
+long long VRP::GetWorkDone() const { return this->workDone; }
+
+/** @brief Start tabu search over with empty memory, keeping the run settings. */
+void VRP::ResetTabuSearch() {
+    this->tabuSearch.emplace(this->graph, this->numVertices, this->workers);
+    this->tabuSearch->SetDeterministic(this->workBudget.has_value());
+}
+
+/** @brief Return the threads of the exact route-pool search, one when the run must be reproducible. */
+unsigned VRP::ExactSearchWorkers() const { return this->workBudget.has_value() ? 1U : this->workers; }
+
 /** @brief Create an initial solution with Clarke-Wright savings.
  *
  * Starts with one route per customer, then greedily merges compatible route
@@ -898,14 +1383,48 @@ int VRP::InitSolutionsSavings() {
     std::vector<RoutePoolCandidate> routePool;
     std::map<std::vector<int>, std::size_t> routePoolByCustomerSet;
 
-    OptimalMove opt;
-    std::optional<Routes> bestRoutes;
     // Sweep the Clarke-Wright lambda parameter to create different route
     // memberships without using instance-specific starts or hardcoded tours.
-    for (double lambda : {0.4, 0.6, 0.8, 1.0, 1.2, 1.4, 1.6, 1.8, 2.0}) {
-        Routes candidate = BuildSavingsRoutes(this->graph, customers, depot, this->capacity, this->workTime,
-                                              this->costTravel, this->alphaParam, lambda);
-        opt.OptRouteTsp(candidate, 14);
+    // Every construction is independent, so they run as pool tasks writing to
+    // their own slot; the slots are merged in lambda order below, which keeps
+    // the result independent of thread timing.
+    std::vector<Routes> savingsRoutes(kSavingsLambdas.size());
+    std::exception_ptr constructionError;
+    std::mutex constructionErrorMutex;
+    const auto runConstruction = [&constructionError, &constructionErrorMutex](const std::function<void()>& build) {
+        try {
+            build();
+        } catch (...) {
+            std::scoped_lock lock(constructionErrorMutex);
+            if (!constructionError) {
+                constructionError = std::current_exception();
+            }
+        }
+    };
+    {
+        ThreadPool constructions(this->workers);
+        for (std::size_t slot = 0; slot < kSavingsLambdas.size(); ++slot) {
+            constructions.AddTask([this, &savingsRoutes, &customers, &depot, &runConstruction, slot]() {
+                runConstruction([&]() {
+                    savingsRoutes[slot] =
+                        BuildSavingsRoutes(this->graph, customers, depot, this->capacity, this->workTime,
+                                           this->costTravel, this->alphaParam, kSavingsLambdas[slot]);
+                });
+            });
+        }
+        constructions.JoinAll();
+    }
+    if (constructionError) {
+        std::rethrow_exception(constructionError);
+    }
+    // the sweep splits its rotations over its own pool, so it runs once the savings pool is gone
+    std::optional<Routes> sweepRoutes = BuildSweepRoutes(this->graph, this->capacity, this->workTime, this->costTravel,
+                                                         this->alphaParam, this->workers);
+
+    OptimalMove opt(this->workers, this->utils);
+    std::optional<Routes> bestRoutes;
+    for (Routes& candidate : savingsRoutes) {
+        opt.OptRouteTsp(candidate, HeldKarp::ExactRouteCustomers);
         AddRoutePoolCandidates(routePool, routePoolByCustomerSet, customerIndexByName, candidate);
         this->ArchiveRoutes(candidate);
         if (!bestRoutes.has_value() || IsBetterSolution(candidate, *bestRoutes, this->minimumRoutes)) {
@@ -916,8 +1435,6 @@ int VRP::InitSolutionsSavings() {
         throw std::runtime_error("Savings initialization failed");
     }
     this->routes = std::move(*bestRoutes);
-    std::optional<Routes> sweepRoutes =
-        BuildSweepRoutes(this->graph, this->capacity, this->workTime, this->costTravel, this->alphaParam);
     if (sweepRoutes.has_value()) {
         // The sweep construction is kept even when it is not the best complete
         // solution because individual routes can still improve later pool picks.
@@ -926,22 +1443,275 @@ int VRP::InitSolutionsSavings() {
     }
     if (sweepRoutes.has_value() && IsBetterSolution(*sweepRoutes, this->routes, this->minimumRoutes)) {
         this->routes = std::move(*sweepRoutes);
-        Utils::Instance().logger("Sweep routes selected", Utils::VERBOSE);
+        this->Log("Sweep routes selected", Utils::VERBOSE);
     }
     std::optional<Routes> recombinedRoutes =
-        RecombineRoutePool(routePool, customers, this->capacity, this->minimumRoutes, this->routes);
+        RecombineRoutePool(routePool, customers, this->capacity, this->minimumRoutes, this->routes,
+                           this->ExactSearchWorkers());
     if (recombinedRoutes.has_value() && IsBetterSolution(*recombinedRoutes, this->routes, this->minimumRoutes)) {
         // Exact set partitioning can combine good routes from different starts
         // that no single construction pass produced together.
         this->routes = std::move(*recombinedRoutes);
-        Utils::Instance().logger("Route pool recombination selected", Utils::VERBOSE);
+        this->Log("Route pool recombination selected", Utils::VERBOSE);
+    }
+    opt.OptRouteTsp(this->routes, HeldKarp::ExactRouteCustomers);
+    this->ArchiveRoutes(this->routes);
+    this->Log("Initial routes created", Utils::VERBOSE);
+    return CompareRouteCount(this->routes.size(), this->vehicles);
+}
+
+/** @brief Create an initial solution from a previous route set.
+ *
+ * Every route is rebuilt in the given order and split greedily where it is
+ * no longer feasible. The depot, customers missing from the instance and
+ * repeated visits are dropped; customers the routes do not serve are added
+ * by regret insertion, and new routes are opened only when they do not fit.
+ * The repaired set is then polished like a construction.
+ * @param[in] names Customer names of each route, depot entries allowed
+ * @return Error or Warning code.
+ */
+int VRP::InitSolutionsFromRoutes(const std::vector<std::vector<std::string>>& names) {
+    this->freshTabuRestartsUsed = 0;
+    Map dist = this->graph.sortV0();
+    const Customer depot = dist.cbegin()->second;
+    dist.erase(dist.cbegin());
+    std::map<std::string, Customer> customerByName;
+    for (const auto& entry : dist) {
+        customerByName.emplace(entry.second.name, entry.second);
+    }
+    std::set<std::string> placed;
+    Routes warmRoutes;
+    for (const std::vector<std::string>& routeNames : names) {
+        std::vector<Customer> order;
+        for (const std::string& name : routeNames) {
+            const auto found = customerByName.find(name);
+            if (found != customerByName.end() && placed.insert(name).second) {
+                order.push_back(found->second);
+            }
+        }
+        if (!order.empty()) {
+            AppendFeasibleRoutes(warmRoutes, order, depot, this->graph, this->capacity, this->workTime,
+                                 this->costTravel, this->alphaParam);
+        }
+    }
+    std::vector<Customer> missing;
+    for (const auto& entry : dist) {
+        if (!placed.contains(entry.second.name)) {
+            missing.push_back(entry.second);
+        }
     }
-    opt.OptRouteTsp(this->routes, 14);
+    OptimalMove opt(this->workers, this->utils);
+    std::vector<Customer> pending = missing;
+    while (!pending.empty()) {
+        Routes repaired = warmRoutes;
+        if (opt.InsertRegret(repaired, pending, kWarmStartRegretDegree)) {
+            warmRoutes = std::move(repaired);
+            break;
+        }
+        // A customer regret could not place gets a route of its own, and the
+        // repair restarts from the rebuilt routes, since a failed one is partial.
+        const auto served = [&repaired](const Customer& customer) {
+            return std::ranges::any_of(repaired,
+                                       [&customer](const Route& route) { return route.FindCustomer(customer); });
+        };
+        const auto stranded = std::ranges::find_if_not(pending, served);
+        AppendFeasibleRoutes(warmRoutes, {*stranded}, depot, this->graph, this->capacity, this->workTime,
+                             this->costTravel, this->alphaParam);
+        pending.erase(stranded);
+    }
+    opt.OptRouteTsp(warmRoutes, HeldKarp::ExactRouteCustomers);
+    this->routes = std::move(warmRoutes);
     this->ArchiveRoutes(this->routes);
-    Utils::Instance().logger("Initial routes created", Utils::VERBOSE);
+    this->Log("Initial routes repaired from a previous solution: " + std::to_string(placed.size()) +
+                  " customers kept, " + std::to_string(missing.size()) + " inserted",
+              Utils::VERBOSE);
     return CompareRouteCount(this->routes.size(), this->vehicles);
 }
 
+/** @brief Queue a customer that joined the instance.
+ *
+ * Only checks that need no graph access are done here, so the call never
+ * races the search; the rest is checked when the change is applied.
+ * @param[in] customer The new customer
+ * @param[in] arcs Travel costs to and from every current vertex, by vertex name
+ * @throws std::runtime_error when the customer can never be served
+ */
+void VRP::AddCustomer(Customer customer, std::map<std::string, VertexArcs> arcs) {
+    if (customer.name.empty() || customer.request < 0 || customer.serviceTime < 0 ||
+        customer.request > this->capacity) {
+        throw std::runtime_error("Customer " + customer.name + " cannot be served");
+    }
+    std::scoped_lock lock(this->pendingChangesMutex);
+    this->pendingChanges.push_back(
+        CustomerChange{.customer = std::move(customer), .arcs = std::move(arcs), .remove = false});
+}
+
+/** @brief Queue the removal of a customer that left the instance.
+ *
+ * @param[in] name Name of the customer
+ */
+void VRP::RemoveCustomer(const std::string& name) {
+    std::scoped_lock lock(this->pendingChangesMutex);
+    this->pendingChanges.push_back(CustomerChange{.customer = Customer(name, 0, 0), .arcs = {}, .remove = true});
+}
+
+/** @brief Apply the queued customer changes in request order.
+ *
+ * Must run on the thread driving the search, between two search steps, when
+ * no neighborhood holds references into the graph or the routes. A change
+ * the graph rejects, such as an unknown name, is logged and skipped.
+ * @return true when at least one change was applied
+ */
+bool VRP::ApplyCustomerChanges() {
+    std::vector<CustomerChange> changes;
+    {
+        std::scoped_lock lock(this->pendingChangesMutex);
+        changes.swap(this->pendingChanges);
+    }
+    if (changes.empty()) {
+        return false;
+    }
+    const Customer depot = this->graph.sortV0().cbegin()->second;
+    OptimalMove opt(this->workers, this->utils);
+    bool applied = false;
+    for (CustomerChange& change : changes) {
+        try {
+            this->ApplyCustomerChange(change, depot, opt);
+            applied = true;
+        } catch (const std::runtime_error& e) {
+            this->Log(e.what(), Utils::WARNING);
+        }
+    }
+    int totalDemand = 0;
+    for (const auto& entry : this->graph.sortV0()) {
+        totalDemand += entry.second.request;
+    }
+    this->minimumRoutes = (totalDemand + this->capacity - 1) / this->capacity;
+    if (this->tabuSearch.has_value()) {
+        this->tabuSearch->SetCustomerCount(this->numVertices);
+    }
+    return applied;
+}
+
+/** @brief Apply one customer change everywhere the search keeps a solution.
+ *
+ * The current and the best route sets stay complete solutions of the changed
+ * instance: a removed customer is cut out of its route, an added one takes
+ * its cheapest feasible position or a route of its own. Archived routes with
+ * a removed customer are dropped; the others remain valid candidates.
+ * @param[in,out] change The change; an added customer receives its graph index
+ * @param[in] depot The depot
+ * @param[in] opt Move engine used for the insertion
+ */
+void VRP::ApplyCustomerChange(CustomerChange& change, const Customer& depot, OptimalMove& opt) {
+    if (change.remove) {
+        this->graph.RemoveVertex(change.customer);
+        --this->numVertices;
+        this->routeArchive.RemoveRoutesWith(change.customer);
+    } else {
+        this->graph.AppendVertex(change.customer, change.arcs);
+        ++this->numVertices;
+    }
+    for (Routes* solution : {&this->routes, &this->bestRoutes}) {
+        if (change.remove) {
+            for (Route& route : *solution) {
+                if (route.RemoveCustomer(change.customer)) {
+                    break;
+                }
+            }
+            opt.CleanVoid(*solution);
+        } else if (!solution->empty() && !opt.InsertRegret(*solution, {change.customer}, 2)) {
+            AppendFeasibleRoutes(*solution, {change.customer}, depot, this->graph, this->capacity, this->workTime,
+                                 this->costTravel, this->alphaParam);
+        }
+    }
+    this->Log((change.remove ? "Customer removed: " : "Customer added: ") + change.customer.name, Utils::VERBOSE);
+}
+
+/** @brief Bound the run by a wall-clock instant.
+ *
+ * Tabu calls end at it, and VND stops at the next neighborhood or exchange
+ * route pair once it has passed.
+ * @param[in] end The instant after which no new search step starts
+ */
+void VRP::SetDeadline(std::chrono::steady_clock::time_point end) { this->deadline = end; }
+
+/** @brief Send the search trace to the logger of the run.
+ *
+ * Concurrent runs each trace to their own destination; a model without a
+ * logger stays silent.
+ * @param[in] runUtils Utilities of the run, outliving the model
+ */
+void VRP::SetLogger(const Utils& runUtils) { this->utils = &runUtils; }
+
+/** @brief Log one message through the logger of the run, if any.
+ *
+ * @param[in] message Message to log
+ * @param[in] level Utils log level
+ */
+void VRP::Log(const std::string& message, int level) const {
+    if (this->utils != nullptr) {
+        this->utils->logger(message, level);
+    }
+}
+
+/** @brief Return true once the budget of the run is spent.
+ *
+ * The budget is the work budget in deterministic mode, the deadline otherwise.
+ */
+bool VRP::DeadlinePassed() const {
+    if (this->workBudget.has_value()) {
+        return this->workDone >= *this->workBudget;
+    }
+    return this->deadline.has_value() && std::chrono::steady_clock::now() >= *this->deadline;
+}
+
+/** @brief Save everything the search carries from one step to the next.
+ *
+ * Caches that are rebuilt on demand, such as neighbor lists and exact
+ * routes, are left out. The graph fingerprint and the capacity come first,
+ * so a checkpoint is never resumed against another instance.
+ * @param[in,out] out Checkpoint being written
+ */
+void VRP::SaveState(CheckpointWriter& out) const {
+    out.U64(this->graph.Fingerprint());
+    out.I32(this->capacity);
+    out.F32(this->workTime);
+    out.RouteSet(this->routes);
+    out.RouteSet(this->bestRoutes);
+    this->routeArchive.Save(out);
+    out.U32(this->tabuSearch.has_value() ? 1 : 0);
+    if (this->tabuSearch.has_value()) {
+        this->tabuSearch->Save(out);
+    }
+    out.I32(this->freshTabuRestartsUsed);
+    this->vndScheduler.Save(out);
+    out.I64(this->workDone);
+}
+
+/** @brief Restore a state saved by SaveState in place of an initial solution.
+ *
+ * @param[in,out] in Checkpoint being read
+ * @throws std::runtime_error when the checkpoint belongs to another instance or is corrupt
+ */
+void VRP::LoadState(CheckpointReader& in) {
+    if (in.U64() != this->graph.Fingerprint() || in.I32() != this->capacity || in.F32() != this->workTime) {
+        throw std::runtime_error("Checkpoint was taken on a different instance");
+    }
+    const Route empty(this->capacity, this->workTime, this->graph, this->costTravel, this->alphaParam);
+    this->routes = in.RouteSet(empty);
+    this->bestRoutes = in.RouteSet(empty);
+    this->routeArchive.Load(in, empty);
+    this->tabuSearch.reset();
+    if (in.U32() != 0) {
+        this->ResetTabuSearch();
+        this->tabuSearch->Load(in);
+    }
+    this->freshTabuRestartsUsed = in.I32();
+    this->vndScheduler.Load(in);
+    this->workDone = in.I64();
+}
+
 /** @brief Run the tabu search function.
  *
  * Run the basic function of this algorithm.
@@ -949,9 +1719,12 @@ int VRP::InitSolutionsSavings() {
  */
 void VRP::RunTabuSearch(int times) {
     if (!this->tabuSearch.has_value()) {
-        this->tabuSearch.emplace(this->graph, this->numVertices);
+        this->ResetTabuSearch();
     }
-    this->tabuSearch->Tabu(this->routes, times);
+    // a deterministic run ignores the deadline, as every other search loop does
+    const std::optional<std::chrono::steady_clock::time_point> end =
+        this->workBudget.has_value() ? std::nullopt : this->deadline;
+    this->workDone += static_cast<long long>(this->tabuSearch->Tabu(this->routes, times, end));
 }
 
 /** @brief Run the configured local-search optimization functions.
@@ -963,86 +1736,106 @@ void VRP::RunTabuSearch(int times) {
  * @return          If the routine made some improvements.
  */
 bool VRP::RunOpts(int times, bool flag, int diversificationRank) {
-    OptimalMove opt;
+    OptimalMove opt(this->workers, this->utils);
+    // a deadline must end the pass inside a VND step, not only between steps
+    const std::function<bool()> stop = [this] { return this->DeadlinePassed(); };
+    opt.SetStopCondition(stop);
     int i = 0;
     std::chrono::minutes::rep duration = 0;
     bool improved = false;
-    auto runVndStep = [this, &opt](Routes& workingRoutes, bool allowDeepSearch) {
+    auto runVndStep = [this, &opt, &stop](Routes& workingRoutes, bool allowDeepSearch) {
+        using Neighborhood = NeighborhoodScheduler::Neighborhood;
         const SearchProfile profile = BuildSearchProfile(workingRoutes);
         // VND accepts the first improving neighborhood, then restarts from the
-        // cheapest moves so expensive repairs run only after simpler moves stall.
-        if (opt.ReduceRoutes(workingRoutes, static_cast<std::size_t>(this->minimumRoutes)) > 0)
-            return true;
-        if (opt.Opt10(workingRoutes, false) > 0)
-            return true;
-        if (opt.Opt11(workingRoutes, false) > 0)
-            return true;
-        if (opt.Opt12(workingRoutes, false) > 0)
-            return true;
-        if (opt.Opt21(workingRoutes, false) > 0)
-            return true;
-        if (opt.Opt22(workingRoutes, false) > 0)
-            return true;
-        if (opt.OptCyclicExchange(workingRoutes, 1) > 0)
-            return true;
-        if (opt.OptSwapSegments(workingRoutes, profile.segmentRelocateMax) > 0)
-            return true;
+        // cheapest moves. The shallow tier keeps its fixed order, which decides
+        // the local optimum VND converges to; the deep tier defers repairs whose
+        // measured gain per millisecond has gone cold.
         const int shallowRelatedSeedLimit = std::min(18, profile.relatedSeedLimit);
-        if (opt.OptRelatedRuinRecreate(workingRoutes, profile.relatedRemoval, shallowRelatedSeedLimit) > 0)
-            return true;
-        if (opt.Opt2Star(workingRoutes) > 0)
-            return true;
-        if (opt.OptRouteTsp(workingRoutes, 14) > 0)
-            return true;
-        if (opt.Opt2(workingRoutes))
-            return true;
-        if (opt.Opt3(workingRoutes))
+        const std::vector<Neighborhood> shallow = {
+            {"reduce-routes",
+             [this, &opt](Routes& r) {
+                 return opt.ReduceRoutes(r, static_cast<std::size_t>(this->minimumRoutes)) > 0;
+             }},
+            {"opt10", [&opt](Routes& r) { return opt.Opt10(r, false) > 0; }},
+            {"swap-star", [&opt](Routes& r) { return opt.OptSwapStar(r) > 0; }},
+            {"opt12", [&opt](Routes& r) { return opt.Opt12(r, false) > 0; }},
+            {"opt21", [&opt](Routes& r) { return opt.Opt21(r, false) > 0; }},
+            {"opt22", [&opt](Routes& r) { return opt.Opt22(r, false) > 0; }},
+            {"cyclic-exchange", [&opt](Routes& r) { return opt.OptCyclicExchange(r, 1) > 0; }},
+            {"swap-segments",
+             [&opt, &profile](Routes& r) { return opt.OptSwapSegments(r, profile.segmentRelocateMax) > 0; }},
+            {"related-ruin",
+             [&opt, &profile, shallowRelatedSeedLimit](Routes& r) {
+                 return opt.OptRelatedRuinRecreate(r, profile.relatedRemoval, shallowRelatedSeedLimit) > 0;
+             }},
+            {"2opt-star", [&opt](Routes& r) { return opt.Opt2Star(r) > 0; }},
+            {"route-tsp", [&opt](Routes& r) { return opt.OptRouteTsp(r, HeldKarp::ExactRouteCustomers) > 0; }},
+            {"long-route", [&opt](Routes& r) { return opt.OptLongRoutes(r, HeldKarp::ExactRouteCustomers) > 0; }},
+            {"2opt", [&opt](Routes& r) { return opt.Opt2(r); }},
+            {"3opt", [&opt](Routes& r) { return opt.Opt3(r); }},
+        };
+        if (this->vndScheduler.RunFirstImprovement(workingRoutes, shallow, stop, false))
             return true;
         if (!allowDeepSearch)
             return false;
         // Deep neighborhoods move several customers or route memberships at once;
         // they are bounded by SearchProfile to keep large instances tractable.
-        if (profile.deepRelatedRemoval > profile.relatedRemoval &&
-            opt.OptRelatedRuinRecreate(workingRoutes, profile.deepRelatedRemoval, profile.relatedSeedLimit) > 0)
-            return true;
-        if (profile.relatedSeedLimit > shallowRelatedSeedLimit &&
-            opt.OptRelatedRuinRecreate(workingRoutes, profile.relatedRemoval, profile.relatedSeedLimit) > 0)
-            return true;
-        if (opt.OptRelatedBeamRuinRecreate(workingRoutes, profile.deepRelatedRemoval, profile.relatedSeedLimit,
-                                           kRelatedBeamWidth) > 0)
-            return true;
-        if (profile.ruinRemovalMax >= 4 && opt.OptExchange(workingRoutes, 3, 1, false) > 0)
-            return true;
-        if (profile.ruinRemovalMax >= 4 && opt.OptExchange(workingRoutes, 1, 3, false) > 0)
-            return true;
+        std::vector<Neighborhood> deep;
+        if (profile.deepRelatedRemoval > profile.relatedRemoval) {
+            deep.push_back({"deep-related-ruin", [&opt, &profile](Routes& r) {
+                                return opt.OptRelatedRuinRecreate(r, profile.deepRelatedRemoval,
+                                                                  profile.relatedSeedLimit) > 0;
+                            }});
+        }
+        if (profile.relatedSeedLimit > shallowRelatedSeedLimit) {
+            deep.push_back({"wide-related-ruin", [&opt, &profile](Routes& r) {
+                                return opt.OptRelatedRuinRecreate(r, profile.relatedRemoval,
+                                                                  profile.relatedSeedLimit) > 0;
+                            }});
+        }
+        deep.push_back({"beam-ruin", [&opt, &profile](Routes& r) {
+                            return opt.OptRelatedBeamRuinRecreate(r, profile.deepRelatedRemoval,
+                                                                  profile.relatedSeedLimit, kRelatedBeamWidth) > 0;
+                        }});
+        if (profile.ruinRemovalMax >= 4) {
+            deep.push_back({"exchange-3-1", [&opt](Routes& r) { return opt.OptExchange(r, 3, 1, false) > 0; }});
+            deep.push_back({"exchange-1-3", [&opt](Routes& r) { return opt.OptExchange(r, 1, 3, false) > 0; }});
+        }
         for (int sourceGroupSize = 1; sourceGroupSize <= profile.exchangeGroupMax; ++sourceGroupSize) {
             for (int destGroupSize = 1; destGroupSize <= profile.exchangeGroupMax; ++destGroupSize) {
                 if (sourceGroupSize + destGroupSize <= 4)
                     continue;
-                if (opt.OptExchange(workingRoutes, sourceGroupSize, destGroupSize, false) > 0)
-                    return true;
+                deep.push_back({"exchange-" + std::to_string(sourceGroupSize) + "-" + std::to_string(destGroupSize),
+                                [&opt, sourceGroupSize, destGroupSize](Routes& r) {
+                                    return opt.OptExchange(r, sourceGroupSize, destGroupSize, false) > 0;
+                                }});
             }
         }
         for (int removalCount = 3; removalCount <= profile.ruinRemovalMax; ++removalCount) {
-            if (opt.OptRuinRecreate(workingRoutes, removalCount, profile.ruinSeedLimit) > 0)
-                return true;
+            deep.push_back({"ruin-" + std::to_string(removalCount), [&opt, &profile, removalCount](Routes& r) {
+                                return opt.OptRuinRecreate(r, removalCount, profile.ruinSeedLimit) > 0;
+                            }});
         }
         for (int segmentSize = 2; segmentSize <= profile.segmentRelocateMax; ++segmentSize) {
-            if (opt.OptRelocateSegment(workingRoutes, segmentSize) > 0)
-                return true;
+            deep.push_back({"relocate-segment-" + std::to_string(segmentSize), [&opt, segmentSize](Routes& r) {
+                                return opt.OptRelocateSegment(r, segmentSize) > 0;
+                            }});
         }
-        if (opt.OptBoundaryPairSplit(workingRoutes, profile.boundaryPoolLimit, profile.boundaryPairLimit) > 0)
-            return true;
-        if (opt.OptPairSweepSplit(workingRoutes) > 0)
-            return true;
-        if (opt.OptRouteClusterSplit(workingRoutes, profile.boundaryPoolLimit) > 0)
-            return true;
-        if (opt.OptPairSplit(workingRoutes, profile.pairSplitLimit) > 0)
-            return true;
-        return false;
+        deep.push_back({"boundary-pair-split", [&opt, &profile](Routes& r) {
+                            return opt.OptBoundaryPairSplit(r, profile.boundaryPoolLimit,
+                                                            profile.boundaryPairLimit) > 0;
+                        }});
+        deep.push_back({"pair-sweep-split", [&opt](Routes& r) { return opt.OptPairSweepSplit(r) > 0; }});
+        deep.push_back({"route-cluster-split", [&opt, &profile](Routes& r) {
+                            return opt.OptRouteClusterSplit(r, profile.boundaryPoolLimit) > 0;
+                        }});
+        deep.push_back({"pair-split", [&opt, &profile](Routes& r) {
+                            return opt.OptPairSplit(r, profile.pairSplitLimit) > 0;
+                        }});
+        return this->vndScheduler.RunFirstImprovement(workingRoutes, deep, stop);
     };
     if (flag) {
-        Utils::Instance().logger("Forced opt diversification", Utils::VERBOSE);
+        this->Log("Forced opt diversification", Utils::VERBOSE);
         const SearchProfile profile = BuildSearchProfile(this->routes);
         const int perturbationRemoval =
             std::min(profile.relatedSeedLimit, profile.deepRelatedRemoval + std::max(0, diversificationRank));
@@ -1066,16 +1859,22 @@ bool VRP::RunOpts(int times, bool flag, int diversificationRank) {
     }
     // start time
     std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
-    while (i < times && duration <= 25) {
-        Utils::Instance().logger("Round " + std::to_string(i + 1) + " of " + std::to_string(times), Utils::VERBOSE);
+    while (i < times && duration <= 25 && !this->DeadlinePassed()) {
+        this->Log("Round " + std::to_string(i + 1) + " of " + std::to_string(times), Utils::VERBOSE);
         if (!runVndStep(this->routes, true))
             break;
+        // Every accepted step is a complete solution; archiving it is cheap and
+        // gives recombination the intermediate memberships, not only pass results.
+        this->ArchiveRoutes(this->routes);
         improved = true;
         i++;
-        // partial time
-        std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
-        duration = std::chrono::duration_cast<std::chrono::minutes>(t2 - t1).count();
+        // partial time; a deterministic run is bounded by its work budget alone
+        if (!this->workBudget.has_value()) {
+            std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+            duration = std::chrono::duration_cast<std::chrono::minutes>(t2 - t1).count();
+        }
     }
+    this->Log("Neighborhood weights: " + this->vndScheduler.DescribeWeights(), Utils::VERBOSE);
     return improved;
 }
 
@@ -1105,53 +1904,20 @@ void VRP::RestoreBest() {
 
 /** @brief Store non-empty routes from a complete solution for route-pool recombination. */
 void VRP::ArchiveRoutes(const Routes& solution) {
-    // A sorted customer-name signature identifies the membership of a route
-    // independently of its traversal order.
-    std::map<std::vector<std::string>, std::size_t> archivedRouteIndex;
-    for (std::size_t index = 0; index < this->routeArchive.size(); ++index) {
-        archivedRouteIndex.emplace(RouteSignature(this->routeArchive[index]), index);
-    }
-
     for (const Route& route : solution) {
-        if (route.size() <= 2) {
-            continue;
+        if (route.size() > 2) {
+            this->routeArchive.Add(WithCachedExactOrder(route));
         }
-        const std::vector<std::string> signature = RouteSignature(route);
-        const auto existing = archivedRouteIndex.find(signature);
-        if (existing != archivedRouteIndex.end()) {
-            Route& archivedRoute = this->routeArchive[existing->second];
-            if (route.GetTotalCost() < archivedRoute.GetTotalCost()) {
-                archivedRoute = route;
-            }
-            continue;
-        }
-        archivedRouteIndex.emplace(signature, this->routeArchive.size());
-        this->routeArchive.push_back(route);
-    }
-
-    const std::size_t archiveLimit = RouteArchiveLimit(this->numVertices - 1, this->minimumRoutes);
-    while (this->routeArchive.size() > archiveLimit) {
-        // Drop the worst archived route by score so the set-partitioning pool
-        // stays bounded while preserving the strongest membership candidates.
-        const auto worst = std::ranges::max_element(this->routeArchive, [](const Route& left, const Route& right) {
-            const double leftScore = RouteArchiveScore(left);
-            const double rightScore = RouteArchiveScore(right);
-            if (leftScore != rightScore) {
-                return leftScore < rightScore;
-            }
-            return left.GetTotalCost() < right.GetTotalCost();
-        });
-        if (worst == this->routeArchive.end()) {
-            return;
-        }
-        this->routeArchive.erase(worst);
     }
+    // Drop the worst archived routes by cost per customer so the set-partitioning
+    // pool stays bounded while preserving the strongest membership candidates.
+    this->routeArchive.Trim(RouteArchiveLimit(this->numVertices - 1, this->minimumRoutes));
 }
 
 /** @brief Try exact set partitioning over all archived route candidates. */
 bool VRP::RecombineArchivedRoutes() {
     const Routes& incumbent = this->bestRoutes.empty() ? this->routes : this->bestRoutes;
-    if (incumbent.empty() || this->routeArchive.empty()) {
+    if (incumbent.empty() || this->routeArchive.Size() == 0) {
         return false;
     }
     const std::vector<Customer> customers = UniqueCustomersFromRoutes(incumbent);
@@ -1164,16 +1930,19 @@ bool VRP::RecombineArchivedRoutes() {
     // Seed the pool with the incumbent so recombination is never worse than the
     // current best unless a strictly better exact cover is found.
     AddRoutePoolCandidates(routePool, routePoolByCustomerSet, customerIndexByName, incumbent);
-    AddRoutePoolCandidates(routePool, routePoolByCustomerSet, customerIndexByName, this->routeArchive);
+    this->routeArchive.ForEachRoute([&routePool, &routePoolByCustomerSet, &customerIndexByName](const Route& route) {
+        AddRoutePoolCandidate(routePool, routePoolByCustomerSet, customerIndexByName, route);
+    });
     std::optional<Routes> recombinedRoutes =
-        RecombineRoutePool(routePool, customers, this->capacity, this->minimumRoutes, incumbent);
+        RecombineRoutePool(routePool, customers, this->capacity, this->minimumRoutes, incumbent,
+                           this->ExactSearchWorkers());
     if (!recombinedRoutes.has_value() || !IsBetterSolution(*recombinedRoutes, incumbent, this->minimumRoutes)) {
         return false;
     }
     this->bestRoutes = std::move(*recombinedRoutes);
     this->routes = this->bestRoutes;
     this->ArchiveRoutes(this->bestRoutes);
-    Utils::Instance().logger("Route archive recombination improved", Utils::VERBOSE);
+    this->Log("Route archive recombination improved", Utils::VERBOSE);
     return true;
 }
 
@@ -1190,9 +1959,9 @@ bool VRP::IntensifyBestWithDiversifiedBranches(int branchCount, int optIteration
         return false;
     }
     bool improved = false;
-    for (int branch = 0; branch < branchCount; ++branch) {
+    for (int branch = 0; branch < branchCount && !this->DeadlinePassed(); ++branch) {
         this->routes = this->bestRoutes;
-        OptimalMove opt;
+        OptimalMove opt(this->workers, this->utils);
         const SearchProfile profile = BuildSearchProfile(this->routes);
         const int perturbationRemoval =
             std::min(profile.relatedSeedLimit, profile.deepRelatedRemoval + std::max(0, branch));
@@ -1218,7 +1987,7 @@ bool VRP::IntensifyBestWithDiversifiedBranches(int branchCount, int optIteration
             this->ArchiveRoutes(this->bestRoutes);
             this->RecombineArchivedRoutes();
             improved = true;
-            Utils::Instance().logger("Diversified incumbent branch improved", Utils::VERBOSE);
+            this->Log("Diversified incumbent branch improved", Utils::VERBOSE);
         }
     }
     this->routes = this->bestRoutes;
@@ -1233,9 +2002,9 @@ bool VRP::RestartFromBestWithFreshTabu() {
     this->routes = this->bestRoutes;
     // Rebuild tabu memory while keeping the incumbent route set. This gives the
     // same solution one fresh neighborhood trajectory without repeated restarts.
-    this->tabuSearch.emplace(this->graph, this->numVertices);
+    this->ResetTabuSearch();
     ++this->freshTabuRestartsUsed;
-    Utils::Instance().logger("Fresh incumbent tabu restart selected", Utils::VERBOSE);
+    this->Log("Fresh incumbent tabu restart selected", Utils::VERBOSE);
     return true;
 }
 
@@ -1253,6 +2022,9 @@ int VRP::GetTotalCost() {
     return this->totalCost;
 }
 
+/** @brief Return the graph of the instance. */
+const Graph& VRP::GetGraph() const { return this->graph; }
+
 /** @brief Return the number of customers. */
 int VRP::GetNumberOfCustomers() const { return numVertices; }
 
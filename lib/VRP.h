@@ -2,9 +2,21 @@
 #define VRP_H
 
 #include "Graph.h"
+#include "NeighborhoodScheduler.h"
 #include "OptimalMove.h"
+#include "RouteArchive.h"
 #include "TabuSearch.h"
+#include <chrono>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <vector>
+
+class CheckpointReader;
+class CheckpointWriter;
+class OptimalMove;
+class Utils;
 
 /** @brief Vehicle Routing Problem model and solver orchestration.
  *
@@ -24,10 +36,39 @@ class VRP {
     float costTravel = 0.0F;              /**< Cost parameter for each travel */
     float alphaParam = 0.0F;              /**< Alpha parameter for route evaluation */
     Routes bestRoutes;                    /**< Best route configuration found so far */
-    Routes routeArchive;                  /**< Routes seen during search for recombination */
+    RouteArchive routeArchive;            /**< Routes seen during search for recombination */
     std::optional<TabuSearch> tabuSearch; /**< Persistent tabu memory across outer search iterations */
     int freshTabuRestartsUsed = 0;        /**< Number of bounded incumbent restarts already consumed */
+    NeighborhoodScheduler vndScheduler;   /**< Learned VND neighborhood order shared by all passes */
     int totalCost = 0;                    /**< Total cost of routes */
+    unsigned workers = 1;                 /**< Threads this run may use at once */
+
+    /** @brief Wall-clock end of the run, if bounded. */
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    const Utils* utils = nullptr;        /**< Logger of the run receiving the search trace, if any */
+    std::optional<long long> workBudget; /**< Evaluated-move budget of a deterministic run */
+    long long workDone = 0;              /**< Moves evaluated by tabu search so far */
+
+    /** @brief Start tabu search over with empty memory, keeping the run settings. */
+    void ResetTabuSearch();
+
+    /** @brief Log one message of the search trace. */
+    void Log(const std::string&, int) const;
+
+    /** @brief Return the threads of the exact route-pool search. */
+    [[nodiscard]] unsigned ExactSearchWorkers() const;
+
+    /** @brief Customer insertion or removal requested while the search runs. */
+    struct CustomerChange {
+        Customer customer;                      /**< Customer to add, or to remove by name */
+        std::map<std::string, VertexArcs> arcs; /**< Arcs of an added customer by vertex name, empty for a removal */
+        bool remove = false;                    /**< True for a removal */
+    };
+    std::vector<CustomerChange> pendingChanges; /**< Changes waiting for the next safe point of the search */
+    std::mutex pendingChangesMutex;             /**< Guards pendingChanges against the requesting threads */
+
+    /** @brief Apply one customer change to the graph and every stored route set. */
+    void ApplyCustomerChange(CustomerChange&, const Customer&, OptimalMove&);
 
     /** @brief Store route candidates from a complete solution for later recombination. */
     void ArchiveRoutes(const Routes&);
@@ -42,9 +83,48 @@ class VRP {
     /** @brief Create a VRP model from graph data and solver parameters. */
     VRP(Graph&&, const int, const int, const int, const int, const float, const bool, const float, const float);
 
+    /** @brief Limit the number of threads any search step of this run may use. */
+    void SetWorkerBudget(unsigned);
+
+    /** @brief Stop search loops once a wall-clock instant has passed. */
+    void SetDeadline(std::chrono::steady_clock::time_point);
+
+    /** @brief Make the run reproducible, bounded by evaluated moves instead of wall time. */
+    void SetWorkBudget(long long);
+
+    /** @brief Check whether the run is bounded by work instead of wall time. */
+    [[nodiscard]] bool Deterministic() const;
+
+    /** @brief Return the moves evaluated by tabu search so far. */
+    [[nodiscard]] long long GetWorkDone() const;
+
+    /** @brief Send the search trace of this run to the logger of its owner. */
+    void SetLogger(const Utils&);
+
+    /** @brief Check whether the deadline or work budget of the run is spent. */
+    [[nodiscard]] bool DeadlinePassed() const;
+
+    /** @brief Write the search state to a checkpoint. */
+    void SaveState(CheckpointWriter&) const;
+
+    /** @brief Replace the search state with one stored in a checkpoint of the same instance. */
+    void LoadState(CheckpointReader&);
+
     /** @brief Build an initial solution with savings and sweep heuristics. */
     int InitSolutionsSavings();
 
+    /** @brief Build an initial solution from route lists of customer names, repairing it where needed. */
+    int InitSolutionsFromRoutes(const std::vector<std::vector<std::string>>&);
+
+    /** @brief Queue a new customer with its arcs; safe to call while another thread searches. */
+    void AddCustomer(Customer, std::map<std::string, VertexArcs>);
+
+    /** @brief Queue the removal of a customer by name; safe to call while another thread searches. */
+    void RemoveCustomer(const std::string&);
+
+    /** @brief Apply queued customer changes; called by the searching thread between search steps. */
+    bool ApplyCustomerChanges();
+
     /** @brief Run tabu search over the current routes. */
     void RunTabuSearch(int);
 
@@ -60,6 +140,9 @@ class VRP {
     /** @brief Return the number of non-depot customers in the instance. */
     [[nodiscard]] int GetNumberOfCustomers() const;
 
+    /** @brief Return the graph of the instance. */
+    [[nodiscard]] const Graph& GetGraph() const;
+
     /** @brief Return a mutable pointer to the current route set. */
     [[nodiscard]] Routes* GetRoutes();
 
@@ -15,7 +15,10 @@
     along with VRP.  If not, see <http://www.gnu.org/licenses/>.
  ****************************************************************************/
 
+#include "BatchRunner.h"
 #include "Controller.h"
+#include "SolveServer.h"
+#include <optional>
 
 using namespace std;
 using namespace chrono;
@@ -29,15 +32,26 @@ constexpr int kMaxTimeMin = 300;
 int main(int argc, char** argv) {
     high_resolution_clock::time_point t1 = high_resolution_clock::now();
     int exitCode = 0;
-    // create the controller
-    Controller& c = Controller::Instance();
     Utils& u = Utils::Instance();
     try {
-        c.Init(argc, argv, kTravelCost, kAlpha, kMaxTimeMin);
-        c.PrintRoutes();
-        c.SaveResult();
-        c.RunVRP();
-        c.PrintBestRoutes();
+        std::optional<BatchRunner> batch = BatchRunner::FromArguments(argc, argv, kTravelCost, kAlpha, kMaxTimeMin);
+        std::optional<SolveServer> server;
+        if (!batch.has_value()) {
+            server = SolveServer::FromArguments(argc, argv, kTravelCost, kAlpha, kMaxTimeMin);
+        }
+        if (batch.has_value()) {
+            batch->Run();
+        } else if (server.has_value()) {
+            server->Run();
+        } else {
+            // create the controller
+            Controller c;
+            c.Init(argc, argv, kTravelCost, kAlpha, kMaxTimeMin);
+            c.PrintRoutes();
+            c.SaveResult();
+            c.RunVRP();
+            c.PrintBestRoutes();
+        }
     } catch (const std::exception& e) {
         u.logger(e.what(), u.ERROR);
         exitCode = 1;